@@ -2,6 +2,11 @@
 * @brief: Contains the prototype of the BaseStation class.
 * @file: basestation.hpp
 *
+* The radio is a template parameter rather than a virtual interface, so the
+* firmware build binds straight to RF24 with no vtables or indirect calls.
+* Host builds can plug in a simulated or recorded radio that provides the
+* same member functions. The definitions live in basestation_impl.hpp.
+*
 * @author: jkieltyka15
 */
 
@@ -10,14 +15,14 @@
 
 // standard libraries
 #include <Arduino.h>
-#include <Wire.h>
 #include <nRF24L01.h>
 #include <RF24.h>
 
 // local libraries
 #include <Message.h>
 
-#define SENSOR_NODE_NUM 10  // number of sensor nodes
+// local dependencies
+#include "basestationstate.hpp"
 
 #define RF24_CE_PIN 6   // NRF24L01 CE pin assignment
 #define RF24_CSN_PIN 8  // NRF24L01 CSN pin assignment
@@ -26,24 +31,30 @@
 #define RF24_ADDRESS_WIDTH 4
 
 
-class BaseStation {
+/**
+ * @brief Base station of the parking lot
+ *
+ * @tparam Radio: NRF24L01 driver with the RF24 member functions used by the base station
+ */
+template <class Radio>
+class BaseStation : public BaseStationState {
 
     private:
 
-        // unique id of the base station
-        uint8_t node_id = 0;
-
-        // array to track sensor node statuses
-        bool node_status[SENSOR_NODE_NUM] = {0};
-
         // NRF24L01 transciever radio
-        RF24 radio = RF24(RF24_CE_PIN, RF24_CSN_PIN);
+        Radio radio = Radio(RF24_CE_PIN, RF24_CSN_PIN);
         uint32_t radio_address = 0;
         uint8_t radio_channel = 0;
 
+        // retransmissions of the most recent radio write
+        uint8_t last_arc = 0;
+
+        // if the write in progress is made without retransmissions
+        bool is_tx_once = false;
+
         /**
          * @brief Calculates a given node's radio address based on the node ID
-         * 
+         *
          * @param node_id: ID of node to calculate address for
          * @return The calculated radio address for the node
          */
@@ -51,12 +62,45 @@ class BaseStation {
 
         /**
          * @brief Calculates a given node's radio channel based on the node ID
-         * 
+         *
          * @param node_id: ID of node to calculate channel for
          * @return The calculated radio channel for the node (0-125)
          */
         uint8_t calculate_radio_channel(uint8_t node_id);
 
+        /**
+         * @brief Transmit a message of any type to a sensor node.
+         *
+         * @param msg: Message to be transmitted
+         * @param size: Size of the message in bytes
+         * @return True if successfully sent. Otherwise false
+         */
+        bool transmit_message(Message* msg, uint8_t size);
+
+        /**
+         * @brief Transmit a message without automatic retransmissions.
+         *
+         * @param msg: Message to be transmitted
+         * @param size: Size of the message in bytes
+         * @return True if successfully sent. Otherwise false
+         */
+        bool transmit_once(Message* msg, uint8_t size);
+
+        /**
+         * @brief Loads the base station's congestion level as the payload of its next ACK
+         *
+         * Any older payload is discarded so the level is always current.
+         */
+        void arm_ack_payload();
+
+        /**
+         * @brief Discards the ACK payloads at the front of the receive FIFO
+         *
+         * Sensor nodes answer the base station's own writes with their
+         * congestion level, which only their children use.
+         */
+        void discard_ack_payloads();
+
 
     public:
 
@@ -67,68 +111,100 @@ class BaseStation {
 
         /**
          * @brief Initializes all variables and objects
-         * 
+         *
          * Initializes all variables and objects for a BaseStation
-         * object including the ToF sensor and transciever.
-         * 
+         * object including the transciever.
+         *
          * @return true on success. Otherwise false
          */
         bool init();
 
         /**
          * @brief Determine if there is a message available to read
-         * 
+         *
          * @return True if a message is available. Otherwise false
          */
         bool is_message();
 
         /**
          * @brief Gets a message from the message queue
-         * 
+         *
          * @param buffer: buffer to hold message
          * @param size: size of buffer
-         * @return Number of bytes read
+         * @return Number of bytes read. Zero if there was no message
          */
-        bool read_message(uint8_t** buffer, uint8_t size);
+        uint8_t read_message(uint8_t** buffer, uint8_t size);
 
         /**
-         * @brief Get the ID of the node
-         * 
-         * @return ID of the node
+         * @brief Transmit a link probe to a sensor node.
+         *
+         * @param msg: PING message to be transmitted
+         * @return True if successfully sent. Otherwise false
          */
-        uint8_t get_id();
+        bool transmit_ping(PingMessage* msg);
 
         /**
-         * @brief Determines if the provided node ID is valid
+         * @brief Asks sensor nodes to report their status.
          * 
-         * @param node_id: node ID to be evaluated
-         * @return True if node ID is valid. Otherwise false
+         * The targets are split between the next egress nodes so each copy
+         * only names the targets reached through its receiver. A learned
+         * next node that does not answer is forgotten, so the parking map
+         * is used for its targets next time. Requests of derived types, such
+         * as config messages, are sent whole.
+         * 
+         * @param msg: request naming every target
+         * @param size: size of the request in bytes
+         * @return True if every copy was sent. Otherwise false
          */
-        bool is_valid_sensor_node(uint8_t node_id);
+        bool transmit_request(StatusRequestMessage* msg, uint8_t size);
 
         /**
-         * @brief Update the vacancy status of a node
-         * 
-         * @param node_id: ID of node to update vacancy status
-         * @param is_vacant: New vacancy status of node
-         * @return True if successfully updated. Otherwise false
+         * @brief Transmit network time to a sensor node.
+         *
+         * The message is stamped just before it is written and sent without
+         * automatic retransmissions, so a late copy never carries a stale time.
+         *
+         * @param msg: Sync message to be transmitted
+         * @return True if successfully sent. Otherwise false
          */
-        bool update_node_status(uint8_t node_id, bool is_vacant);
+        bool transmit_sync(SyncMessage* msg);
 
         /**
-         * @brief Get the vacancy status of a node
-         * 
-         * @param node_id: ID of node to get vacancy status
-         * @return The node's vacancy status
+         * @brief Transmit the routing gradient to a sensor node.
+         *
+         * Sent without automatic retransmissions since beacons go to every
+         * node ID and most are not in range.
+         *
+         * @param msg: Beacon message to be transmitted
+         * @return True if successfully sent. Otherwise false
          */
-        bool get_node_status(uint8_t node_id);
+        bool transmit_beacon(BeaconMessage* msg);
 
         /**
-         * @brief Counts the number of nodes with vacant status
-         * 
-         * @return Number of nodes with vacant status
+         * @brief Switches the rate the base station listens at once the reports heard call for it
+         *
+         * @return True if the rate changed. Otherwise false
+         */
+        bool adapt_data_rate();
+
+        /**
+         * @brief Gets the retransmissions of the most recent message sent
+         *
+         * @return Number of retransmissions
          */
-        uint8_t num_vacant();
+        uint8_t get_last_arc();
+
+        /**
+         * @brief Gets the radio of the base station
+         *
+         * Lets host builds wire a simulated radio to the rest of a simulation.
+         *
+         * @return Radio of the base station
+         */
+        Radio& get_radio();
 };
 
+// template definitions
+#include "basestation_impl.hpp"
+
 #endif /* _BASE_STATION_HPP_ */
@@ -0,0 +1,365 @@
+/**
+* @brief: Contains the implementation of the BaseStation class template.
+* @file: basestation_impl.hpp
+*
+* Only included by basestation.hpp.
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _BASE_STATION_IMPL_HPP_
+#define _BASE_STATION_IMPL_HPP_
+
+// standard libraries
+#include <Arduino.h>
+#include <stdlib.h>
+
+// local libraries
+#include <Log.h>
+#include <Message.h>
+
+// local dependencies
+#include "profiling.hpp"
+
+
+// base station's node ID
+#define BASE_STATION_ID 0
+
+// special base station address since 0x00000000 is not a valid address
+#define BASE_STATION_ADDRESS 0xBAD1DEA5
+
+#define RF24_CHANNEL_SPACING 5  // number of channels between a valid node channel
+#define RF24_READING_PIPE 1     // reading pipe for the NRF24L01
+#define RF24_PAYLOAD_MAX 32     // largest payload the NRF24L01 can send
+
+#define MAX_SEND_ATTEMPTS 15    // maximum number of attempts to send a message
+#define FAILED_SEND_DELAY 15    // minimum delay between sending message attempts
+
+
+template <class Radio>
+BaseStation<Radio>::BaseStation(uint8_t node_id) : BaseStationState(node_id) {
+
+    this->radio_address = this->calculate_radio_address(node_id);
+    this->radio_channel = this->calculate_radio_channel(node_id);
+}
+
+
+template <class Radio>
+uint32_t BaseStation<Radio>::calculate_radio_address(uint8_t node_id) {
+
+    // base station has special non-calculated address
+    if (BASE_STATION_ID == node_id) {
+        return BASE_STATION_ADDRESS;
+    }
+
+    // generate address as byte array
+    const byte address_bytes[RF24_ADDRESS_WIDTH] = { node_id, node_id, node_id, node_id };
+
+    // convert byte array to 32 bit integer
+    uint32_t address = 0;
+    memcpy(&address, address_bytes, sizeof(address));
+    
+    return address; 
+}
+
+
+template <class Radio>
+uint8_t BaseStation<Radio>::calculate_radio_channel(uint8_t node_id) {
+
+    return node_id * RF24_CHANNEL_SPACING;
+}
+
+
+template <class Radio>
+bool BaseStation<Radio>::init() {
+
+    // start radio
+    if (false == radio.begin()) {
+
+        ERROR("Failed to start radio");
+        return false;
+    }
+
+    // configure radio
+    radio.enableDynamicPayloads();
+    radio.enableAckPayload();
+    radio.setAutoAck(true);
+    radio.setRetries(FAILED_SEND_DELAY, MAX_SEND_ATTEMPTS);
+    radio.setAddressWidth(RF24_ADDRESS_WIDTH);
+    radio.setPALevel(RF24_PA_MAX);
+    radio.setDataRate(LinkRate::get_rate(this->get_link_rate()->get_rx_index()));
+    radio.setChannel(this->radio_channel);
+    radio.openReadingPipe(RF24_READING_PIPE, this->radio_address);
+
+    // start listening on radio
+    radio.startListening();
+    this->set_rx_idle_ms(millis());
+    this->arm_ack_payload();
+
+    return BaseStationState::init();
+}
+
+
+template <class Radio>
+bool BaseStation<Radio>::is_message() {
+
+    this->discard_ack_payloads();
+
+    if (false == this->radio.available()) {
+        this->set_rx_idle_ms(millis());
+        return false;
+    }
+
+    return true;
+}
+
+
+template <class Radio>
+uint8_t BaseStation<Radio>::read_message(uint8_t** buffer, uint8_t len) {
+
+    this->discard_ack_payloads();
+
+    if (false == this->radio.available()) {
+        return 0;
+    }
+
+    // a full FIFO means the sender's next message will not be acknowledged
+    bool is_fifo_full = this->radio.rxFifoFull();
+    if (true == is_fifo_full) {
+        PROFILE_COUNT(COUNTER_RX_FIFO_FULL, 1);
+    }
+
+    // only read the bytes that were sent
+    uint8_t size = this->radio.getDynamicPayloadSize();
+    size = (size < len) ? size : len;
+    this->radio.read(buffer, size);
+
+    // status reports show whether their senders could be heard at a faster rate
+    Message msg = Message();
+    memcpy(&msg, (const uint8_t*)buffer, sizeof(msg));
+    if ((MESSAGE_UPDATE == msg.get_type()) || (MESSAGE_STATS == msg.get_type())) {
+        this->get_link_rate()->record_rx(msg.get_tx_id(), this->radio.testRPD());
+    }
+
+    // advertise how far behind the base station is in the next ACK
+    this->get_congestion()->record_rx(is_fifo_full, this->radio.available());
+    this->arm_ack_payload();
+
+    return size;
+}
+
+
+template <class Radio>
+bool BaseStation<Radio>::transmit_message(Message* msg, uint8_t size) {
+
+    // message cannot fit in a single payload
+    if (RF24_PAYLOAD_MAX < size) {
+        return false;
+    }
+
+    // calculate receiver node's radio configuration
+    uint8_t rx_id = msg->get_rx_id();
+    uint32_t rx_address = this->calculate_radio_address(rx_id);
+    uint8_t rx_channel = this->calculate_radio_channel(rx_id);
+
+    // switch to receiver node's channel. The base station sends rarely
+    // enough that it does not wait for the channel to clear
+    this->radio.setChannel(rx_channel);
+    this->radio.stopListening();
+    this->radio.closeReadingPipe(RF24_READING_PIPE);
+
+    // create pipe to receiver node at the rate it was last reached at
+    this->radio.openWritingPipe(rx_address);
+
+    LinkRate* link_rate = this->get_link_rate();
+    uint8_t rate_index = link_rate->get_tx_index(rx_id);
+    this->radio.setDataRate(LinkRate::get_rate(rate_index));
+
+    // the base station clock is network time
+    if (MESSAGE_SYNC == msg->get_type()) {
+        ((SyncMessage*)msg)->stamp(millis(), 0);
+    }
+
+    // create a copy of the message to send
+    uint8_t buffer[RF24_PAYLOAD_MAX];
+    memcpy(buffer, msg, size);
+
+    // attempt to transmit message
+    bool is_sent = this->radio.write(&buffer, size);
+    this->last_arc = this->radio.getARC();
+
+    // receiver may have changed rate, so every other rate is tried once
+    if ((false == is_sent) && ((false == this->is_tx_once) || (true == link_rate->is_reached(rx_id)))) {
+
+        this->radio.setRetries(FAILED_SEND_DELAY, 0);
+
+        int8_t fallback = link_rate->get_fallback_index(rate_index, 0);
+        for (uint8_t attempt = 1; (false == is_sent) && (0 <= fallback); attempt++) {
+
+            this->radio.setDataRate(LinkRate::get_rate(fallback));
+            is_sent = this->radio.write(&buffer, size);
+
+            if (true == is_sent) {
+                rate_index = fallback;
+                this->last_arc = this->radio.getARC();
+            }
+
+            fallback = link_rate->get_fallback_index(rate_index, attempt);
+        }
+
+        this->radio.setRetries(FAILED_SEND_DELAY, MAX_SEND_ATTEMPTS);
+    }
+
+    if (true == is_sent) {
+        link_rate->record_tx(rx_id, rate_index);
+    }
+
+    // switch back to the base station's radio configuration
+    this->radio.setDataRate(LinkRate::get_rate(link_rate->get_rx_index()));
+    this->radio.setChannel(this->radio_channel);
+    this->radio.openReadingPipe(RF24_READING_PIPE, this->radio_address);
+
+    // start listening again. Switching to transmit discarded the ACK payload
+    this->radio.startListening();
+    this->arm_ack_payload();
+
+    return is_sent;
+}
+
+
+template <class Radio>
+bool BaseStation<Radio>::transmit_ping(PingMessage* msg) {
+
+    return this->transmit_message(msg, sizeof(*msg));
+}
+
+
+template <class Radio>
+bool BaseStation<Radio>::transmit_request(StatusRequestMessage* msg, uint8_t size) {
+
+    EgressTable* egress = this->get_egress();
+    uint16_t targets = msg->get_targets();
+    bool is_all_sent = true;
+
+    int16_t next_id = -1;
+    uint16_t group = egress->take_group(this->get_id(), &targets, &next_id);
+
+    while (0 != group) {
+
+        // no route to the targets of the group
+        if (0 > next_id) {
+            is_all_sent = false;
+        }
+
+        else {
+
+            // the same copy is readdressed for each next node
+            msg->readdress((uint8_t)next_id, this->get_id(), 0, group);
+
+            if (false == this->transmit_message(msg, size)) {
+
+                is_all_sent = false;
+
+                for (uint8_t target_id = 1; target_id <= MAP_NODE_MAX; target_id++) {
+                    if (0 != (group & (1U << target_id))) {
+                        egress->forget(target_id);
+                    }
+                }
+            }
+        }
+
+        group = egress->take_group(this->get_id(), &targets, &next_id);
+    }
+
+    return is_all_sent;
+}
+
+
+template <class Radio>
+void BaseStation<Radio>::arm_ack_payload() {
+
+    congestion_ack_t ack = {this->get_id(), this->get_congestion()->get_level()};
+
+    this->radio.flush_tx();
+    this->radio.writeAckPayload(RF24_READING_PIPE, &ack, sizeof(ack));
+}
+
+
+template <class Radio>
+void BaseStation<Radio>::discard_ack_payloads() {
+
+    // ACK payloads arrive on the writing pipe
+    uint8_t pipe = 0;
+    while ((true == this->radio.available(&pipe)) && (0 == pipe)) {
+
+        uint8_t buffer[RF24_PAYLOAD_MAX];
+        this->radio.read(buffer, this->radio.getDynamicPayloadSize());
+    }
+}
+
+
+template <class Radio>
+bool BaseStation<Radio>::transmit_once(Message* msg, uint8_t size) {
+
+    this->radio.setRetries(FAILED_SEND_DELAY, 0);
+    this->is_tx_once = true;
+
+    bool is_sent = this->transmit_message(msg, size);
+
+    this->is_tx_once = false;
+    this->radio.setRetries(FAILED_SEND_DELAY, MAX_SEND_ATTEMPTS);
+
+    return is_sent;
+}
+
+
+template <class Radio>
+bool BaseStation<Radio>::transmit_sync(SyncMessage* msg) {
+
+    // a retransmission would arrive later than the stamped time
+    return this->transmit_once(msg, sizeof(*msg));
+}
+
+
+template <class Radio>
+bool BaseStation<Radio>::transmit_beacon(BeaconMessage* msg) {
+
+    // most receivers are out of range so failed writes are kept short
+    return this->transmit_once(msg, sizeof(*msg));
+}
+
+
+template <class Radio>
+bool BaseStation<Radio>::adapt_data_rate() {
+
+    if (false == this->get_link_rate()->update(millis())) {
+        return false;
+    }
+
+    uint8_t rate_index = this->get_link_rate()->get_rx_index();
+    INFO("Listening at data rate %u", rate_index);
+
+    // switching to transmit discards the ACK payload
+    this->radio.stopListening();
+    this->radio.setDataRate(LinkRate::get_rate(rate_index));
+    this->radio.startListening();
+    this->arm_ack_payload();
+
+    return true;
+}
+
+
+template <class Radio>
+uint8_t BaseStation<Radio>::get_last_arc() {
+
+    return this->last_arc;
+}
+
+
+template <class Radio>
+Radio& BaseStation<Radio>::get_radio() {
+
+    return this->radio;
+}
+
+#endif /* _BASE_STATION_IMPL_HPP_ */
@@ -0,0 +1,544 @@
+/**
+* @brief: Contains the prototype of the BaseStationState class.
+* @file: basestationstate.hpp
+*
+* Holds what the base station knows about the lot without touching the
+* radio, so message handling, telemetry and host tools share one
+* non-template type.
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _BASE_STATION_STATE_HPP_
+#define _BASE_STATION_STATE_HPP_
+
+// standard libraries
+#include <Arduino.h>
+
+// local libraries
+#include <egresstable.hpp>
+#include <Link.h>
+#include <Message.h>
+
+// local dependencies
+#include "livenesswheel.hpp"
+#include "lotstore.hpp"
+#include "probesweep.hpp"
+
+#ifndef SENSOR_NODE_NUM
+#define SENSOR_NODE_NUM 10  // number of sensor nodes
+#endif
+
+#define LATENCY_HIST_BINS 8     // bins of the sensor to paint latency histogram of each node
+
+// latencies below 2^LATENCY_HIST_SHIFT milliseconds fall into the first bin.
+// Each following bin doubles the upper bound and the last bin is unbounded
+#define LATENCY_HIST_SHIFT 6
+
+#define ROUTE_HOP_BINS 6        // bins of the relay count histogram of each node, the last unbounded
+
+// relays that can be told apart in the path trace of a report
+#if SENSOR_NODE_NUM < PATH_NODE_MAX
+#define ROUTE_RELAY_NUM SENSOR_NODE_NUM
+#else
+#define ROUTE_RELAY_NUM PATH_NODE_MAX
+#endif
+
+#define SYNC_PERIOD_MS 10000    // time between network time floods in milliseconds
+#define BEACON_PERIOD_MS 30000  // time between routing beacon floods in milliseconds
+
+#define LOT_SAVE_CHANGES 8          // status changes saved without waiting for the save period
+#define LOT_SAVE_PERIOD_MS 60000    // longest a status change waits to be saved in milliseconds
+#define LOT_SAVE_SPACING_MS 5000    // shortest time between saves in milliseconds
+
+// sequence numbers are saved before any drifts this far from its saved value,
+// and are restored this far ahead of it, so they stay newer than any sent
+#define LOT_SEQ_DRIFT_MAX 32
+
+
+class BaseStationState {
+
+    private:
+
+        // unique id of the base station
+        uint8_t node_id = 0;
+
+        // array to track sensor node statuses
+        bool node_status[SENSOR_NODE_NUM] = {0};
+
+        // most recent network statistics reported by each sensor node
+        node_stats_t node_stats[SENSOR_NODE_NUM] = {};
+
+        // number of statistics reports received from each sensor node
+        uint16_t node_stats_reports[SENSOR_NODE_NUM] = {0};
+
+        // link probes sent along the routes of the parking map
+        ProbeSweep probe_sweep;
+
+        // how well the base station keeps up with the messages it receives
+        CongestionMeter congestion;
+
+        // data rate the base station listens at and the rate of each node it writes to
+        LinkRate link_rate;
+
+        // sensor to paint latencies of status changes from each sensor node.
+        // A full count halves every count of the node so they keep their proportions
+        uint8_t latency_hist[SENSOR_NODE_NUM][LATENCY_HIST_BINS] = {};
+        uint16_t latency_max_ms[SENSOR_NODE_NUM] = {0};
+
+#ifdef ROUTE_HIST_ENABLED
+        // relays counted on the reports of each sensor node. A full count
+        // halves every count of the node so they keep their proportions
+        uint8_t route_hops[SENSOR_NODE_NUM][ROUTE_HOP_BINS] = {};
+        uint8_t route_relays[SENSOR_NODE_NUM][ROUTE_RELAY_NUM] = {};
+#endif // ROUTE_HIST_ENABLED
+
+        // path of the last report of each sensor node, two relays per byte as in its trace
+        uint8_t route_last[SENSOR_NODE_NUM][PATH_TRACE_MAX / 2] = {};
+        uint8_t route_last_len[SENSOR_NODE_NUM] = {0};
+
+        // reports carried by each relay for every sensor node, saturating
+        uint16_t relay_load[ROUTE_RELAY_NUM] = {0};
+
+        // time each sensor node was last marked alive in milliseconds
+        uint32_t heard_ms[SENSOR_NODE_NUM] = {0};
+
+        // deadlines of every sensor node and the nodes that missed theirs
+        LivenessWheel liveness;
+        bool node_stale[SENSOR_NODE_NUM] = {0};
+        uint8_t stale_num = 0;
+
+        // next nodes towards each sensor node learned from their reports
+        EgressTable egress;
+
+        // nodes to ask for their status and the most recent request
+        uint16_t request_targets = 0;
+        uint8_t request_seq = 0;
+
+        // timing settings waiting to be pushed to sensor nodes
+        ConfigMessage config;
+
+        // boot of the base station and the nodes that have reported since
+        uint8_t epoch = 0;
+        bool node_resynced[SENSOR_NODE_NUM] = {0};
+        uint32_t resync_start_ms = 0;
+        bool is_resync_checked = false;
+
+        // lot state kept in EEPROM and what has changed since it was last saved
+        LotStore lot_store;
+        lot_record_t saved = {};
+        uint32_t saved_ms = 0;
+        bool is_restored = false;
+        uint8_t unsaved_changes = 0;
+        uint32_t unsaved_since_ms = 0;
+
+        /**
+         * @brief Restores the lot saved by an earlier boot
+         * 
+         * @return True if a saved lot of the same size was found. Otherwise false
+         */
+        bool restore_state();
+
+        /**
+         * @brief Saves the current lot state to EEPROM
+         * 
+         * @param now_ms: current time in milliseconds
+         */
+        void write_state(uint32_t now_ms);
+
+        // time the receive FIFO was last found empty in milliseconds
+        uint32_t rx_idle_ms = 0;
+
+        // network time floods sent to the sensor nodes
+        uint32_t sync_sent_ms = 0;
+        uint8_t sync_seq = 0;
+        bool is_sync_sent = false;
+
+        // routing beacon floods sent to the sensor nodes
+        uint32_t beacon_sent_ms = 0;
+        uint8_t beacon_seq = 0;
+        bool is_beacon_sent = false;
+
+
+    public:
+
+        /**
+         * @brief Constructs a BaseStationState object
+         */
+        BaseStationState(uint8_t node_id);
+
+        /**
+         * @brief Initializes the status of every sensor node
+         * 
+         * Statuses and sequence numbers saved by the last boot are restored,
+         * and the epoch of this boot is saved straight away.
+         * 
+         * @return true on success. Otherwise false
+         */
+        bool init();
+
+        /**
+         * @brief Get the ID of the node
+         * 
+         * @return ID of the node
+         */
+        uint8_t get_id();
+
+        /**
+         * @brief Determines if the provided node ID is valid
+         * 
+         * @param node_id: node ID to be evaluated
+         * @return True if node ID is valid. Otherwise false
+         */
+        bool is_valid_sensor_node(uint8_t node_id);
+
+        /**
+         * @brief Update the vacancy status of a node
+         * 
+         * @param node_id: ID of node to update vacancy status
+         * @param is_vacant: New vacancy status of node
+         * @return True if successfully updated. Otherwise false
+         */
+        bool update_node_status(uint8_t node_id, bool is_vacant);
+
+        /**
+         * @brief Get the vacancy status of a node
+         * 
+         * @param node_id: ID of node to get vacancy status
+         * @return The node's vacancy status
+         */
+        bool get_node_status(uint8_t node_id);
+
+        /**
+         * @brief Counts the number of nodes with vacant status
+         * 
+         * @return Number of nodes with vacant status
+         */
+        uint8_t num_vacant();
+
+        /**
+         * @brief Update the network statistics of a node
+         * 
+         * @param node_id: ID of node to update statistics
+         * @param stats: Statistics reported by the node
+         * @return True if successfully updated. Otherwise false
+         */
+        bool update_node_stats(uint8_t node_id, const node_stats_t* stats);
+
+        /**
+         * @brief Get the most recent network statistics of a node
+         * 
+         * @param node_id: ID of node to get statistics
+         * @return The node's statistics, or NULL if the node ID is not valid
+         */
+        const node_stats_t* get_node_stats(uint8_t node_id);
+
+        /**
+         * @brief Get the number of statistics reports received from a node
+         * 
+         * @param node_id: ID of node
+         * @return Number of reports received from the node
+         */
+        uint16_t get_node_stats_reports(uint8_t node_id);
+
+        /**
+         * @brief Records the time from a node seeing its status change to the display showing it
+         * 
+         * @param node_id: ID of node whose status changed
+         * @param latency_ms: latency in milliseconds
+         * @return True if successfully recorded. Otherwise false
+         */
+        bool record_latency(uint8_t node_id, uint32_t latency_ms);
+
+        /**
+         * @brief Get the sensor to paint latency histogram of a node
+         * 
+         * @param node_id: ID of node
+         * @return Array of LATENCY_HIST_BINS relative counts, or NULL if the node ID is not valid
+         */
+        const uint8_t* get_latency_hist(uint8_t node_id);
+
+        /**
+         * @brief Get the longest sensor to paint latency of a node
+         * 
+         * @param node_id: ID of node
+         * @return Latency in milliseconds, saturating
+         */
+        uint16_t get_latency_max_ms(uint8_t node_id);
+
+        /**
+         * @brief Records the route a report took from its node using its path trace
+         * 
+         * @param msg: report received from a sensor node
+         * @return True if successfully recorded. Otherwise false
+         */
+        bool record_route(UpdateMessage* msg);
+
+#ifdef ROUTE_HIST_ENABLED
+        /**
+         * @brief Get the histogram of the relays on the reports of a node
+         * 
+         * @param node_id: ID of node
+         * @return Array of ROUTE_HOP_BINS counts, or NULL if the node ID is not valid
+         */
+        const uint8_t* get_route_hops(uint8_t node_id);
+
+        /**
+         * @brief Get how often each relay carried the reports of a node
+         * 
+         * @param node_id: ID of node
+         * @return Array of ROUTE_RELAY_NUM counts where index N is relay N + 1,
+         *      or NULL if the node ID is not valid
+         */
+        const uint8_t* get_route_relays(uint8_t node_id);
+#endif // ROUTE_HIST_ENABLED
+
+        /**
+         * @brief Get the path of the last report of a node
+         * 
+         * @param node_id: ID of node
+         * @param path: where to store at least PATH_TRACE_MAX relay IDs,
+         *      PATH_RELAY_UNKNOWN for relays not recorded
+         * @return Number of relays in the path
+         */
+        uint8_t get_route_last(uint8_t node_id, uint8_t* path);
+
+        /**
+         * @brief Get the number of reports a relay carried for every node
+         * 
+         * @param relay_id: ID of the relay
+         * @return Number of reports, saturating, or 0 if the relay ID does not fit the path trace
+         */
+        uint16_t get_relay_load(uint8_t relay_id);
+
+        /**
+         * @brief Records that a node was heard from directly or through the alive bitmap of a report
+         * 
+         * Restarts the node's liveness window.
+         * 
+         * @param node_id: ID of the node
+         * @param now_ms: current time in milliseconds
+         * @return True if the node was stale until now. Otherwise false
+         */
+        bool mark_heard(uint8_t node_id, uint32_t now_ms);
+
+        /**
+         * @brief Get the time a node was last heard from
+         * 
+         * @param node_id: ID of node
+         * @return Time in milliseconds, or 0 if the node ID is not valid
+         */
+        uint32_t get_heard_ms(uint8_t node_id);
+
+        /**
+         * @brief Marks the next node whose liveness window ran out as stale
+         * 
+         * Call until it returns -1 to collect every node that went stale.
+         * 
+         * @param now_ms: current time in milliseconds
+         * @return ID of the node that went stale, or -1 if there is none
+         */
+        int16_t expire_stale(uint32_t now_ms);
+
+        /**
+         * @brief Determines if a node has not been heard from for a liveness window
+         * 
+         * @param node_id: ID of node
+         * @return True if the node is stale. Otherwise false
+         */
+        bool is_node_stale(uint8_t node_id);
+
+        /**
+         * @brief Counts the number of stale nodes
+         * 
+         * @return Number of stale nodes
+         */
+        uint8_t num_stale();
+
+        /**
+         * @brief Get the next nodes towards every sensor node
+         * 
+         * @return Egress routes of the base station
+         */
+        EgressTable* get_egress();
+
+        /**
+         * @brief Asks nodes to report their status without waiting for a heartbeat
+         * 
+         * The request is sent by the next loop. Targets are added to one
+         * that has not been sent yet.
+         * 
+         * @param targets: bitmap where bit N is set if node N should report
+         */
+        void request_status(uint16_t targets);
+
+        /**
+         * @brief Takes the nodes waiting to be asked for their status
+         * 
+         * Starts a new request when there are any.
+         * 
+         * @return Bitmap where bit N is set if node N should report
+         */
+        uint16_t take_request();
+
+        /**
+         * @brief Adds a timing setting to push to sensor nodes
+         * 
+         * The settings are sent by the next loop. Settings for other targets
+         * wait until the ones already added have been sent.
+         * 
+         * @param targets: bitmap where bit N is set if node N should apply the setting
+         * @param setting: ID of the setting, one of the CONFIG_ defines
+         * @param value: new value of the setting
+         * @return True if the setting was added. Otherwise false
+         */
+        bool push_config(uint16_t targets, uint8_t setting, uint16_t value);
+
+        /**
+         * @brief Takes the timing settings waiting to be pushed
+         * 
+         * Starts a new request when there are any.
+         * 
+         * @param msg: where to store the config message naming every target
+         * @return True if there were settings to push. Otherwise false
+         */
+        bool take_config(ConfigMessage* msg);
+
+        /**
+         * @brief Gets the sequence number of the most recent status request
+         * 
+         * @return Sequence number
+         */
+        uint8_t get_request_seq();
+
+        /**
+         * @brief Gets the epoch identifying this boot of the base station
+         * 
+         * @return Epoch, never 0
+         */
+        uint8_t get_epoch();
+
+        /**
+         * @brief Records that a node's status is known since boot
+         * 
+         * @param node_id: ID of the node
+         */
+        void mark_resynced(uint8_t node_id);
+
+        /**
+         * @brief Applies a status reported in a resync round
+         * 
+         * Only the first report of each node since boot is applied, since a
+         * later update is newer than any status held for the round.
+         * 
+         * @param node_id: ID of the node
+         * @param is_vacant: reported vacancy status of the node
+         * @return True if the node's status changed. Otherwise false
+         */
+        bool apply_resync(uint8_t node_id, bool is_vacant);
+
+        /**
+         * @brief Takes the nodes that did not report in the resync round
+         * 
+         * Returns them once, a slot after the round ends, so they can be
+         * asked for their status directly.
+         * 
+         * @param now_ms: current time in milliseconds
+         * @return Bitmap where bit N is set if node N has not reported
+         */
+        uint16_t take_resync_missing(uint32_t now_ms);
+
+        /**
+         * @brief Determines if the lot state was restored from EEPROM
+         * 
+         * @return True if the last boot's lot was restored. Otherwise false
+         */
+        bool is_state_restored();
+
+        /**
+         * @brief Saves the lot state to EEPROM if enough has changed
+         * 
+         * Status changes are batched until LOT_SAVE_CHANGES build up or the
+         * oldest has waited LOT_SAVE_PERIOD_MS, and saves are at least
+         * LOT_SAVE_SPACING_MS apart. Sequence numbers are saved before they
+         * drift LOT_SEQ_DRIFT_MAX from their saved values.
+         * 
+         * @param now_ms: current time in milliseconds
+         * @return True if the state was saved. Otherwise false
+         */
+        bool save_state(uint32_t now_ms);
+
+        /**
+         * @brief Records that the receive FIFO was found empty
+         * 
+         * A message read later arrived after this time, so counting from it
+         * gives an upper bound on how long the message waited.
+         * 
+         * @param now_ms: current time in milliseconds
+         */
+        void set_rx_idle_ms(uint32_t now_ms);
+
+        /**
+         * @brief Gets the time the receive FIFO was last found empty
+         * 
+         * @return Time in milliseconds
+         */
+        uint32_t get_rx_idle_ms();
+
+        /**
+         * @brief Get the link probes of the parking map
+         * 
+         * @return The probe sweep of the base station
+         */
+        ProbeSweep* get_probe_sweep();
+
+        /**
+         * @brief Get how well the base station keeps up with received messages
+         * 
+         * @return The congestion meter of the base station
+         */
+        CongestionMeter* get_congestion();
+
+        /**
+         * @brief Get the data rates of the base station and the nodes it writes to
+         * 
+         * @return The link rate table of the base station
+         */
+        LinkRate* get_link_rate();
+
+        /**
+         * @brief Determines if the network time should be flooded again
+         * 
+         * A due flood is recorded as sent at the given time.
+         * 
+         * @param now_ms: current time in milliseconds
+         * @return True if a flood is due. Otherwise false
+         */
+        bool is_sync_due(uint32_t now_ms);
+
+        /**
+         * @brief Gets the sequence number of the most recent network time flood
+         * 
+         * @return Sequence number
+         */
+        uint8_t get_sync_seq();
+
+        /**
+         * @brief Determines if the routing gradient should be flooded again
+         * 
+         * A due flood is recorded as sent at the given time.
+         * 
+         * @param now_ms: current time in milliseconds
+         * @return True if a flood is due. Otherwise false
+         */
+        bool is_beacon_due(uint32_t now_ms);
+
+        /**
+         * @brief Gets the sequence number of the most recent routing beacon flood
+         * 
+         * @return Sequence number
+         */
+        uint8_t get_beacon_seq();
+};
+
+#endif /* _BASE_STATION_STATE_HPP_ */
@@ -0,0 +1,89 @@
+/**
+* @brief: Contains the prototype of the LivenessWheel class.
+* @file: livenesswheel.hpp
+*
+* A hashed timer wheel holding the liveness deadline of every sensor node.
+* Each slot covers 2^LIVENESS_SLOT_SHIFT milliseconds and lists the nodes
+* whose deadline falls within it, so hearing from a node moves it between
+* two lists and checking for expired nodes only visits slots whose time has
+* passed, never the whole lot. The wheel spans more than one liveness
+* window, so a deadline is always in the slot its time maps to.
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _LIVENESS_WHEEL_HPP_
+#define _LIVENESS_WHEEL_HPP_
+
+// standard libraries
+#include <Arduino.h>
+
+#ifndef SENSOR_NODE_NUM
+#define SENSOR_NODE_NUM 10  // number of sensor nodes
+#endif
+
+#define LIVENESS_WINDOW_MS 30000    // time without hearing from a node before its space is stale
+#define LIVENESS_SLOT_SHIFT 11      // each slot covers 2^11 milliseconds
+#define LIVENESS_WHEEL_SLOTS 16     // slots of the wheel, spanning more than the window
+
+#define LIVENESS_NONE 0     // end of a slot's list. Node IDs start at 1
+
+
+class LivenessWheel {
+
+    private:
+
+        // first node of each slot's list
+        uint8_t slot_head[LIVENESS_WHEEL_SLOTS] = {0};
+
+        // neighbours of each node in its slot's list, by node ID
+        uint8_t next[SENSOR_NODE_NUM + 1] = {0};
+        uint8_t prev[SENSOR_NODE_NUM + 1] = {0};
+
+        // tick the deadline of each node falls in and if it is on the wheel
+        uint16_t deadline_tick[SENSOR_NODE_NUM + 1] = {0};
+        bool is_scheduled[SENSOR_NODE_NUM + 1] = {0};
+
+        // oldest tick whose slot has not been checked yet
+        uint16_t tick = 0;
+
+        /**
+         * @brief Takes a node off its slot's list
+         *
+         * @param node_id: ID of the node
+         */
+        void unlink(uint8_t node_id);
+
+
+    public:
+
+        /**
+         * @brief Sets a node's deadline one liveness window from now
+         *
+         * Any earlier deadline of the node is replaced.
+         *
+         * @param node_id: ID of the node
+         * @param now_ms: current time in milliseconds
+         */
+        void schedule(uint8_t node_id, uint32_t now_ms);
+
+        /**
+         * @brief Removes a node's deadline
+         *
+         * @param node_id: ID of the node
+         */
+        void cancel(uint8_t node_id);
+
+        /**
+         * @brief Takes the next node whose deadline has passed off the wheel
+         *
+         * Call until it returns -1 to collect every expired node. A node
+         * expires at most one slot after its deadline.
+         *
+         * @param now_ms: current time in milliseconds
+         * @return ID of the expired node, or -1 if no deadline has passed
+         */
+        int16_t expire(uint32_t now_ms);
+};
+
+#endif // _LIVENESS_WHEEL_HPP_
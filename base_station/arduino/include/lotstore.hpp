@@ -0,0 +1,91 @@
+/**
+* @brief: Contains the prototype of the LotStore class.
+* @file: lotstore.hpp
+*
+* Keeps the vacancy of every space and the sequence numbers of the base
+* station in EEPROM so a restart can show the last known lot at once.
+* Records are written round robin over a ring of slots, each one a save
+* later than the last, so wear is spread over the whole ring. Loading
+* takes the newest slot whose checksum holds, so a save cut short by a
+* power loss only loses that save.
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _LOT_STORE_HPP_
+#define _LOT_STORE_HPP_
+
+// standard libraries
+#include <Arduino.h>
+
+#ifndef SENSOR_NODE_NUM
+#define SENSOR_NODE_NUM 10  // number of sensor nodes
+#endif
+
+#define LOT_STORE_ADDR 0        // first EEPROM address of the ring
+#define LOT_STORE_SIZE 512      // EEPROM bytes given to the ring
+#define LOT_STORE_MAGIC 0xA5    // marks a slot that has been written
+
+// bytes of the vacancy bitmap, bit N - 1 set if node N is vacant
+#define LOT_BITMAP_SIZE ((SENSOR_NODE_NUM + 7) / 8)
+
+
+// state of the lot saved in one slot
+struct lot_record_t {
+    uint8_t magic;                      // LOT_STORE_MAGIC
+    uint16_t generation;                // number of saves before this one
+    uint8_t node_num;                   // SENSOR_NODE_NUM of the saving firmware
+    uint8_t epoch;                      // epoch of the saving boot
+    uint8_t sync_seq;                   // most recent network time flood
+    uint8_t beacon_seq;                 // most recent routing beacon flood
+    uint8_t request_seq;                // most recent status request
+    uint8_t vacant[LOT_BITMAP_SIZE];    // vacancy of every node
+    uint8_t checksum;                   // CRC-8 of every byte before it
+} __attribute__((packed));
+
+// slots of the ring
+#define LOT_STORE_SLOTS (LOT_STORE_SIZE / sizeof(lot_record_t))
+
+
+class LotStore {
+
+    private:
+
+        // slot the next save is written to and its generation
+        uint16_t next_slot = 0;
+        uint16_t generation = 0;
+
+        /**
+         * @brief Reads a slot and verifies it
+         *
+         * @param slot: index of the slot
+         * @param record: where to store the contents of the slot
+         * @return True if the slot holds a whole record. Otherwise false
+         */
+        bool read_slot(uint16_t slot, lot_record_t* record);
+
+
+    public:
+
+        /**
+         * @brief Finds the newest saved record
+         *
+         * Later saves continue the ring after it.
+         *
+         * @param record: where to store the record
+         * @return True if a record was found. Otherwise false
+         */
+        bool load(lot_record_t* record);
+
+        /**
+         * @brief Saves a record in the next slot of the ring
+         *
+         * Only bytes that differ from the slot's contents are written. The
+         * magic, generation and checksum are filled in.
+         *
+         * @param record: record to save
+         */
+        void save(lot_record_t* record);
+};
+
+#endif // _LOT_STORE_HPP_
@@ -0,0 +1,175 @@
+/**
+* @brief: Contains one iteration of the base station main loop.
+* @file: mainloop.hpp
+*
+* The loop is kept apart from main.cpp so host tools can drive the exact
+* firmware loop against a simulated radio and virtual clock.
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _MAIN_LOOP_HPP_
+#define _MAIN_LOOP_HPP_
+
+// standard libraries
+#include <Arduino.h>
+
+// local libraries
+#include <Log.h>
+#include <parkingmap.hpp>
+#include <Telemetry.h>
+
+// local dependencies
+#include "basestation.hpp"
+#include "messagehandler.hpp"
+#include "parkingdisplay.hpp"
+#include "probesweep.hpp"
+#include "profiling.hpp"
+#include "telemetry.hpp"
+
+// delay in main loop in milliseconds
+#define MAIN_LOOP_DELAY_MS 100
+
+// delay in main loop in milliseconds while waiting for a PONG
+#define PROBE_POLL_DELAY_MS 1
+
+
+/**
+ * @brief Runs one iteration of the base station main loop
+ *
+ * Handles a single message if one is waiting. Otherwise waits before
+ * polling the radio again. Spaces of nodes not heard from for a liveness
+ * window are then shown as stale. Nodes missing from the resync round after
+ * boot are polled. Requested status polls and timing settings, the next
+ * link probe of a sweep, network time and routing beacon floods and
+ * periodic telemetry are sent either way. The lot state is saved once
+ * enough of it has changed, the radio switches the rate it listens at if
+ * the reports heard call for it, and the display turns the page of a
+ * large lot.
+ *
+ * @param base_station: base station to run
+ * @param counters: counters reported over telemetry
+ */
+template <class Radio>
+void base_station_loop(BaseStation<Radio>* base_station, telemetry_counters_t* counters) {
+
+    if(true == base_station->is_message()) {
+
+        PROFILE_START(message_start_us);
+        PROFILE_COUNT(COUNTER_RX_MESSAGES, 1);
+
+        uint8_t buffer[MSG_BUFFER_SIZE];
+        memset(buffer, 0, sizeof(buffer));
+
+        uint8_t size = base_station->read_message((uint8_t**)(&buffer), (uint8_t)sizeof(buffer));
+        if (0 == size) {
+            ERROR("Failed to read message");
+        }
+
+        else {
+            // record raw payload for offline replay
+            telemetry_capture(buffer, size);
+
+            handle_message(base_station, buffer, counters);
+        }
+
+        PROFILE_STOP(PHASE_MESSAGE, message_start_us);
+    }
+
+    // nothing to do. Poll quickly while a PONG is awaited so it is timed accurately
+    else {
+        PROFILE_START(delay_start_us);
+        delay((true == base_station->get_probe_sweep()->is_waiting()) ? PROBE_POLL_DELAY_MS : MAIN_LOOP_DELAY_MS);
+        PROFILE_STOP(PHASE_LOOP_DELAY, delay_start_us);
+    }
+
+    // show the spaces of nodes that went silent
+    int16_t stale_id = base_station->expire_stale(millis());
+    while (0 <= stale_id) {
+
+        uint32_t silent_ms = millis() - base_station->get_heard_ms(stale_id);
+        WARN("Node %d has not been heard from for %lu ms", stale_id, (unsigned long)silent_ms);
+
+        draw_stale_parking_space(stale_id);
+        counters->stale_events++;
+        telemetry_liveness(stale_id, true, silent_ms);
+
+        stale_id = base_station->expire_stale(millis());
+    }
+
+    // ask nodes missing from the resync round directly
+    uint16_t missing = base_station->take_resync_missing(millis());
+    if (0 != missing) {
+        WARN("Resync round missed nodes 0x%04x", missing);
+        base_station->request_status(missing);
+    }
+
+    // ask the requested nodes for their status
+    uint16_t request_targets = base_station->take_request();
+    if (0 != request_targets) {
+
+        StatusRequestMessage request_msg = StatusRequestMessage(0, base_station->get_id(), base_station->get_request_seq(), 0, request_targets);
+
+        if (false == base_station->transmit_request(&request_msg, sizeof(request_msg))) {
+            WARN("Failed to send status request %u to every node", base_station->get_request_seq());
+        }
+    }
+
+    // push timing settings to the nodes they are for
+    ConfigMessage config_msg = ConfigMessage();
+    if ((true == base_station->take_config(&config_msg)) && (false == base_station->transmit_request(&config_msg, sizeof(config_msg)))) {
+        WARN("Failed to send config %u to every node", config_msg.get_seq());
+    }
+
+    // send the next link probe of a sweep
+    PingMessage ping_msg = PingMessage();
+    if (true == base_station->get_probe_sweep()->next_probe(micros(), &ping_msg)) {
+
+        bool is_sent = base_station->transmit_ping(&ping_msg);
+        base_station->get_probe_sweep()->probe_sent(is_sent, base_station->get_last_arc());
+
+        if (false == is_sent) {
+            WARN("Failed to transmit PING to Node %u", ping_msg.get_rx_id());
+        }
+    }
+
+    // flood network time down the tree of preferred hops
+    if (true == base_station->is_sync_due(millis())) {
+
+        uint8_t children[TREE_CHILDREN_MAX];
+        uint8_t num_children = get_tree_children(base_station->get_id(), children, sizeof(children));
+
+        for (uint8_t i = 0; i < num_children; i++) {
+
+            SyncMessage sync_msg = SyncMessage(children[i], base_station->get_id(), base_station->get_epoch(), base_station->get_sync_seq(), 0);
+
+            if (false == base_station->transmit_sync(&sync_msg)) {
+                WARN("Failed to transmit SYNC to Node %u", children[i]);
+            }
+        }
+    }
+
+    // flood the routing gradient to every node in range
+    if (true == base_station->is_beacon_due(millis())) {
+
+        for (uint8_t rx_id = 1; rx_id <= SENSOR_NODE_NUM; rx_id++) {
+
+            BeaconMessage beacon_msg = BeaconMessage(rx_id, base_station->get_id(), base_station->get_beacon_seq(), 0, 0, BEACON_NO_PARENT);
+            (void) base_station->transmit_beacon(&beacon_msg);
+        }
+    }
+
+    // keep the lot state for the next boot
+    (void) base_station->save_state(millis());
+
+    // senders find the new rate the next time they write to the base station
+    (void) base_station->adapt_data_rate();
+
+    // turn the page of a lot too large for one screen
+    tick_parking_display(millis());
+
+    // report periodic telemetry
+    telemetry_tick(base_station, counters);
+}
+
+#endif // _MAIN_LOOP_HPP_
@@ -0,0 +1,36 @@
+/**
+* @brief: Contains the prototype for handling messages received by the base station
+* @file: messagehandler.hpp
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _MESSAGE_HANDLER_HPP_
+#define _MESSAGE_HANDLER_HPP_
+
+// standard libraries
+#include <Arduino.h>
+
+// local libraries
+#include <Telemetry.h>
+
+// local dependencies
+#include "basestationstate.hpp"
+
+// size of message buffer
+#define MSG_BUFFER_SIZE 32
+
+
+/**
+ * @brief Reacts to a message received by the base station
+ * 
+ * Validates the message and updates the base station state, the display
+ * and telemetry according to its type.
+ * 
+ * @param base_station: base station that received the message
+ * @param buffer: zero padded buffer of MSG_BUFFER_SIZE bytes holding the message
+ * @param counters: counters to update
+ */
+void handle_message(BaseStationState* base_station, const uint8_t* buffer, telemetry_counters_t* counters);
+
+#endif // _MESSAGE_HANDLER_HPP_
@@ -2,6 +2,11 @@
 * @brief: Contains the prototypes for the GUI
 * @file: parkingdisplay.hpp
 *
+* A lot with a hand drawn layout of its size is drawn from that table.
+* Any other lot is drawn as a grid of the largest tiles that fit it on the
+* screen, or a page at a time in the smallest tiles if none do. Each space
+* keeps the state of its tile, so only tiles that changed are drawn.
+*
 * @author: jkieltyka15
 */
 
@@ -11,6 +16,12 @@
 // standard libraries
 #include <Arduino.h>
 
+#ifndef SENSOR_NODE_NUM
+#define SENSOR_NODE_NUM 10  // number of sensor nodes
+#endif
+
+#define DISPLAY_PAGE_MS 5000    // time each page of a paged lot is shown in milliseconds
+
 /**
  * @brief Initializes all objects and variables for the parking display
  * 
@@ -20,6 +31,8 @@ bool init_parking_display();
 
 /**
  * @brief Draws the parking map on the parking display
+ * 
+ * Also draws every space on the page being shown.
  */
 void draw_parking_map();
 
@@ -31,4 +44,20 @@ void draw_parking_map();
  */
 void update_parking_space(uint8_t space_id, bool is_vacant);
 
+/**
+ * @brief Draws the outline of a car in a parking space whose sensor has gone silent
+ * 
+ * The next update_parking_space() of the space paints over it.
+ * 
+ * @param space_id: ID of parking space to mark stale
+ */
+void draw_stale_parking_space(uint8_t space_id);
+
+/**
+ * @brief Shows the next page of a lot too large for one screen once it is due
+ * 
+ * @param now_ms: current time in milliseconds
+ */
+void tick_parking_display(uint32_t now_ms);
+
 #endif // _PARKING_DISPLAY_HPP_
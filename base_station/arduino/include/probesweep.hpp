@@ -0,0 +1,172 @@
+/**
+* @brief: Contains the prototype of the ProbeSweep class.
+* @file: probesweep.hpp
+*
+* A sweep sends PING probes along a route to every link of the parking map
+* and times the PONG that comes back. Every node forwards ingress messages
+* to one of at most INGRESS_HOPS_MAX next nodes, and the route probing the
+* link from a node to its next node is the preferred route out to the next
+* node followed by the node itself. The round trip time and loss of a
+* single link are what a route adds on top of the route to its next node,
+* traceroute style, so nodes need no clocks or state of their own.
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _PROBE_SWEEP_HPP_
+#define _PROBE_SWEEP_HPP_
+
+// standard libraries
+#include <Arduino.h>
+
+// local libraries
+#include <Message.h>
+#include <parkingmap.hpp>
+
+// time in microseconds to wait for a PONG before the probe is lost
+#define PROBE_TIMEOUT_US 2000000UL
+
+// number of probes sent along every route by a sweep
+#define PROBE_SWEEP_ROUNDS 5
+
+// round trip times are kept in units of this many microseconds, so the
+// probe timeout still fits in 16 bits
+#define PROBE_RTT_UNIT_US 32
+
+
+// probes along the route to a link from a node to one of its next nodes
+struct probe_link_t {
+    uint8_t sent;           // PINGs sent
+    uint8_t received;       // PONGs received
+    uint16_t rtt_avg;       // mean round trip time of the PONGs received in PROBE_RTT_UNIT_US
+    uint16_t rtt_max;       // longest round trip time in PROBE_RTT_UNIT_US
+    uint16_t arc_total;     // retransmissions of every PING received back
+};
+
+
+class ProbeSweep {
+
+    private:
+
+        // probes of every link, by node and index of the next node
+        probe_link_t links[MAP_NODE_MAX][INGRESS_HOPS_MAX] = {};
+
+        // rounds of the sweep left to run, including the current one
+        uint8_t rounds_left = 0;
+
+        // link probed next
+        uint8_t next_node_id = 1;
+        uint8_t next_hop_index = 0;
+
+        // probe waiting for a PONG
+        probe_link_t* in_flight = NULL;
+        uint8_t seq = 0;
+        uint32_t sent_us = 0;
+        uint8_t sent_arc = 0;
+
+        /**
+         * @brief Builds the route that probes a link
+         * 
+         * @param node_id: ID of node at the far end of the link
+         * @param hop_index: index of the next node of the link
+         * @param route: array of PING_ROUTE_MAX to hold the route
+         * @return Number of nodes in the route, or zero if there is no such link
+         */
+        uint8_t build_route(uint8_t node_id, uint8_t hop_index, uint8_t* route);
+
+        /**
+         * @brief Gets the average round trip time of the route to a link
+         * 
+         * @param link: probes of the link
+         * @return Average round trip time in microseconds, or zero if no PONG was received
+         */
+        uint32_t get_avg_rtt_us(const probe_link_t* link);
+
+
+    public:
+
+        /**
+         * @brief Starts a sweep, clearing the results of the previous one
+         * 
+         * @param rounds: number of probes to send along every route
+         */
+        void start(uint8_t rounds);
+
+        /**
+         * @brief Determines if a sweep is in progress
+         * 
+         * @return True if probes are left to send or a PONG is awaited. Otherwise false
+         */
+        bool is_active();
+
+        /**
+         * @brief Determines if a PONG is awaited
+         * 
+         * @return True if a probe is in flight. Otherwise false
+         */
+        bool is_waiting();
+
+        /**
+         * @brief Creates the next probe of a sweep once the previous one is done
+         * 
+         * @param now_us: current time in microseconds
+         * @param msg: PING message to fill
+         * @return True if a probe should be sent now. Otherwise false
+         */
+        bool next_probe(uint32_t now_us, PingMessage* msg);
+
+        /**
+         * @brief Records the outcome of sending the probe from next_probe()
+         * 
+         * @param is_sent: if the PING was acknowledged by the first node
+         * @param arc: retransmissions the PING needed
+         */
+        void probe_sent(bool is_sent, uint8_t arc);
+
+        /**
+         * @brief Records a PONG received by the base station
+         * 
+         * @param msg: PONG message
+         * @param now_us: time the PONG was received in microseconds
+         * @return True if the PONG answered the probe in flight. Otherwise false
+         */
+        bool handle_pong(PingMessage* msg, uint32_t now_us);
+
+        /**
+         * @brief Gets the probes of the route to a link
+         * 
+         * @param node_id: ID of node at the far end of the link
+         * @param hop_index: index of the next node of the link
+         * @return The probes of the link, or NULL if there is no such link
+         */
+        const probe_link_t* get_link(uint8_t node_id, uint8_t hop_index);
+
+        /**
+         * @brief Gets the next node of a link
+         * 
+         * @param node_id: ID of node at the far end of the link
+         * @param hop_index: index of the next node of the link
+         * @return ID of the next node, or -1 if there is no such link
+         */
+        int16_t get_link_peer(uint8_t node_id, uint8_t hop_index);
+
+        /**
+         * @brief Gets the round trip time added by a single link
+         * 
+         * @param node_id: ID of node at the far end of the link
+         * @param hop_index: index of the next node of the link
+         * @return Round trip time in microseconds, or zero if it is unknown
+         */
+        uint32_t get_link_rtt_us(uint8_t node_id, uint8_t hop_index);
+
+        /**
+         * @brief Gets the share of probes that made it across a single link and back
+         * 
+         * @param node_id: ID of node at the far end of the link
+         * @param hop_index: index of the next node of the link
+         * @return Delivery ratio in percent, or zero if it is unknown
+         */
+        uint8_t get_link_delivery_pct(uint8_t node_id, uint8_t hop_index);
+};
+
+#endif /* _PROBE_SWEEP_HPP_ */
@@ -0,0 +1,73 @@
+/**
+* @brief: Contains the prototypes for profiling the base station hot path
+* @file: profiling.hpp
+*
+* Profiling is only compiled in when PROFILE_ENABLED is defined. Otherwise
+* the macros expand to nothing and no storage is reserved.
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _PROFILING_HPP_
+#define _PROFILING_HPP_
+
+// standard libraries
+#include <Arduino.h>
+
+// phases of the main loop that are timed
+enum profile_phase_id_t {
+    PHASE_MESSAGE = 0,      // reading and handling a received message
+    PHASE_DISPLAY_PAINT,    // drawing a parking space on the display
+    PHASE_LOOP_DELAY,       // delay when there is nothing to do
+    PHASE_NUM
+};
+
+// events that are counted
+enum profile_counter_id_t {
+    COUNTER_RX_MESSAGES = 0,    // messages read from the radio
+    COUNTER_RX_FIFO_FULL,       // receive FIFO found full when reading
+    COUNTER_NUM
+};
+
+
+#ifdef PROFILE_ENABLED
+
+/**
+ * @brief Records the duration of a phase
+ *
+ * @param phase: phase that was timed
+ * @param elapsed_us: duration in microseconds
+ */
+void profile_record(profile_phase_id_t phase, uint32_t elapsed_us);
+
+/**
+ * @brief Adds to a counter
+ *
+ * @param counter: counter to add to
+ * @param amount: amount to add
+ */
+void profile_count(profile_counter_id_t counter, uint16_t amount);
+
+/**
+ * @brief Clears all phases and counters
+ */
+void profile_reset();
+
+/**
+ * @brief Prints all phases and counters to the serial port
+ */
+void profile_dump();
+
+#define PROFILE_START(start_us)         uint32_t start_us = micros()
+#define PROFILE_STOP(phase, start_us)   profile_record(phase, micros() - start_us)
+#define PROFILE_COUNT(counter, amount)  profile_count(counter, amount)
+
+#else
+
+#define PROFILE_START(start_us)         do {} while (0)
+#define PROFILE_STOP(phase, start_us)   do {} while (0)
+#define PROFILE_COUNT(counter, amount)  do {} while (0)
+
+#endif // PROFILE_ENABLED
+
+#endif // _PROFILING_HPP_
@@ -0,0 +1,93 @@
+/**
+* @brief: Contains the prototypes for the binary telemetry stream
+* @file: telemetry.hpp
+*
+* Telemetry is only compiled in when TELEMETRY_ENABLED is defined. Otherwise
+* every function is an empty inline so call sites cost nothing. Capturing raw
+* radio payloads additionally requires CAPTURE_ENABLED.
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _TELEMETRY_HPP_
+#define _TELEMETRY_HPP_
+
+// standard libraries
+#include <Arduino.h>
+
+// local libraries
+#include <Telemetry.h>
+
+// local dependencies
+#include "basestationstate.hpp"
+
+// time in milliseconds between periodic counter and snapshot frames
+#define TELEMETRY_PERIOD_MS 5000
+
+
+#ifdef TELEMETRY_ENABLED
+
+/**
+ * @brief Reports that the base station has booted
+ */
+void telemetry_boot();
+
+/**
+ * @brief Reports that the status of a parking space changed
+ *
+ * @param node_id: ID of node whose status changed
+ * @param is_vacant: new vacancy status of node
+ * @param latency_ms: time from the node seeing the change to the display showing it
+ * @param hops: number of nodes that relayed the change
+ */
+void telemetry_state_change(uint8_t node_id, bool is_vacant, uint32_t latency_ms, uint8_t hops);
+
+/**
+ * @brief Reports the network statistics of a node
+ *
+ * @param node_id: ID of node that reported its statistics
+ * @param stats: statistics reported by the node
+ */
+void telemetry_node_stats(uint8_t node_id, const node_stats_t* stats);
+
+/**
+ * @brief Reports that a node went stale or was heard from again
+ *
+ * @param node_id: ID of node
+ * @param is_stale: if the node went stale
+ * @param silent_ms: time since the node was last heard from
+ */
+void telemetry_liveness(uint8_t node_id, bool is_stale, uint32_t silent_ms);
+
+/**
+ * @brief Reports a raw payload received by the radio
+ *
+ * @param buffer: received payload
+ * @param size: size of the payload in bytes
+ */
+#ifdef CAPTURE_ENABLED
+void telemetry_capture(const uint8_t* buffer, uint8_t size);
+#else
+inline void telemetry_capture(const uint8_t* buffer, uint8_t size) {}
+#endif // CAPTURE_ENABLED
+
+/**
+ * @brief Reports counters and a lot snapshot if the period has elapsed
+ *
+ * @param base_station: base station to take the snapshot of
+ * @param counters: counters to report
+ */
+void telemetry_tick(BaseStationState* base_station, telemetry_counters_t* counters);
+
+#else
+
+inline void telemetry_boot() {}
+inline void telemetry_state_change(uint8_t node_id, bool is_vacant, uint32_t latency_ms, uint8_t hops) {}
+inline void telemetry_node_stats(uint8_t node_id, const node_stats_t* stats) {}
+inline void telemetry_liveness(uint8_t node_id, bool is_stale, uint32_t silent_ms) {}
+inline void telemetry_capture(const uint8_t* buffer, uint8_t size) {}
+inline void telemetry_tick(BaseStationState* base_station, telemetry_counters_t* counters) {}
+
+#endif // TELEMETRY_ENABLED
+
+#endif // _TELEMETRY_HPP_
@@ -0,0 +1,14 @@
+/**
+* @brief: Includes all required headers for the Link library
+* @file: Link.h
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _LINK_H_
+#define _LINK_H_
+
+#include "congestion.hpp"
+#include "linkrate.hpp"
+
+#endif // _LINK_H_
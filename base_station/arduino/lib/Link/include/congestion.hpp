@@ -0,0 +1,76 @@
+/**
+* @brief: Contains the prototype of the CongestionMeter class.
+* @file: congestion.hpp
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _CONGESTION_HPP_
+#define _CONGESTION_HPP_
+
+// standard libraries
+#include <Arduino.h>
+
+#define CONGESTION_LEVEL_MAX 3      // level of a relay that cannot keep up at all
+#define CONGESTION_SATURATED 2      // level from which children avoid a relay
+#define CONGESTION_HOLD_MS 5000UL   // time a relay's advertised level is trusted
+
+
+/**
+ * Congestion level a relay advertises in the payload of its ACKs, so the
+ * nodes sending to it learn it without any extra transmissions.
+ */
+struct __attribute__((packed)) congestion_ack_t {
+    uint8_t node_id;    // ID of the relay
+    uint8_t level;      // congestion level of the relay (0-CONGESTION_LEVEL_MAX)
+};
+
+
+/**
+ * Moving average of how well a relay keeps up. Each received message adds
+ * a sample from the depth of the receive FIFO, and each forwarded message
+ * adds one from the retransmissions it needed.
+ */
+class CongestionMeter {
+
+    private:
+
+        // moving average of the samples (0-255)
+        uint8_t load = 0;
+
+        /**
+         * @brief Adds a sample to the moving average
+         * 
+         * @param sample: load of the sample (0-255)
+         */
+        void add_sample(uint8_t sample);
+
+
+    public:
+
+        /**
+         * @brief Records that a message was read from the receive FIFO
+         * 
+         * @param is_fifo_full: if the FIFO was full before the read
+         * @param is_backlog: if another message was waiting after the read
+         */
+        void record_rx(bool is_fifo_full, bool is_backlog);
+
+        /**
+         * @brief Records that a message was forwarded
+         * 
+         * @param is_sent: if the write was acknowledged
+         * @param arc: retransmissions of the write
+         */
+        void record_tx(bool is_sent, uint8_t arc);
+
+        /**
+         * @brief Gets the congestion level to advertise
+         * 
+         * @return Level from zero to CONGESTION_LEVEL_MAX
+         */
+        uint8_t get_level();
+};
+
+
+#endif // _CONGESTION_HPP_
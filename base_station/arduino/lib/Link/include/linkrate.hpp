@@ -0,0 +1,168 @@
+/**
+* @brief: Contains the prototype of the LinkRate class.
+* @file: linkrate.hpp
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _LINK_RATE_HPP_
+#define _LINK_RATE_HPP_
+
+// standard libraries
+#include <Arduino.h>
+#include <RF24.h>
+
+#define LINK_RATE_NUM 2                 // data rates from slowest to fastest: 1 Mbps and 2 Mbps
+#define LINK_RATE_DEFAULT 0             // index of the rate every radio starts at
+#define LINK_RATE_PEERS_MAX 8           // most receivers whose rate is remembered
+#define LINK_RATE_WINDOW_MS 30000UL     // time the reports heard are judged over
+#define LINK_RATE_TRIAL_PCT 50          // share of the senders a faster rate has to hear again to be kept
+#define LINK_RATE_WEAK_MAX 4            // most weak reports in a window that keep a faster rate
+#define LINK_RATE_HOLD_MS 600000UL      // time a rate that failed is not tried again
+
+
+/**
+ * Data rate of a node's radio. A radio only hears senders at the rate it
+ * listens at, so the rate belongs to the receiver and every node sending
+ * to it has to find it.
+ *
+ * The receiver judges its rate from the status reports it hears each
+ * window. If every report came in above the received power detector's
+ * threshold it tries the next faster rate for a window, and keeps it only
+ * if most senders of the window before are heard again. A rate that loses
+ * them is held off for a while, as is a faster rate stepped back down from
+ * after too many weak reports.
+ *
+ * Senders write at the rate they last reached each receiver at. A write
+ * that fails is tried once at every other rate, so senders find a receiver
+ * that changed rate with no extra messages. Writes made once are only tried
+ * again for receivers reached before, as a receiver never reached is more
+ * likely out of range than at another rate.
+ */
+class LinkRate {
+
+    private:
+
+        // rate this radio listens at and the one before a trial
+        uint8_t rx_index = LINK_RATE_DEFAULT;
+        uint8_t prev_index = LINK_RATE_DEFAULT;
+
+        // rate that failed and when, LINK_RATE_NUM for none
+        uint8_t held_index = LINK_RATE_NUM;
+        uint32_t held_ms = 0;
+
+        // senders of status reports this window, bit N for node N % 32
+        uint32_t senders = 0;
+
+        // senders a trial has to hear from again
+        uint32_t trial_senders = 0;
+        bool is_trial = false;
+
+        // reports this window and how many were weak
+        uint8_t window_reports = 0;
+        uint8_t window_weak = 0;
+        uint32_t window_ms = 0;
+
+        // rate each receiver was last reached at
+        uint8_t peer_id[LINK_RATE_PEERS_MAX] = {0};
+        uint8_t peer_index[LINK_RATE_PEERS_MAX] = {0};
+        uint8_t num_peers = 0;
+        uint8_t next_peer = 0;
+
+        /**
+         * @brief Finds the entry of a receiver
+         *
+         * @param rx_id: ID of the receiver
+         * @return Index of the entry, or -1 if there is none
+         */
+        int8_t find(uint8_t rx_id);
+
+        /**
+         * @brief Determines if a rate failed recently
+         *
+         * @param index: index of the rate
+         * @param now_ms: current time in milliseconds
+         * @return True if the rate is held off. Otherwise false
+         */
+        bool is_held(uint8_t index, uint32_t now_ms);
+
+        /**
+         * @brief Starts listening at another rate for a window
+         *
+         * @param index: index of the rate
+         * @param expected: senders the trial has to hear from
+         */
+        void start_trial(uint8_t index, uint32_t expected);
+
+
+    public:
+
+        /**
+         * @brief Converts an index to the data rate of the radio
+         *
+         * @param index: index of the rate, slowest first
+         * @return Data rate to pass to setDataRate
+         */
+        static rf24_datarate_e get_rate(uint8_t index);
+
+        /**
+         * @brief Records a status report heard by this radio
+         *
+         * @param tx_id: ID of the node that sent the report
+         * @param is_strong: if the received power detector saw the report
+         */
+        void record_rx(uint8_t tx_id, bool is_strong);
+
+        /**
+         * @brief Judges the listening rate once a window has passed
+         *
+         * @param now_ms: current time in milliseconds
+         * @return True if the listening rate changed. Otherwise false
+         */
+        bool update(uint32_t now_ms);
+
+        /**
+         * @brief Gets the rate this radio listens at
+         *
+         * @return Index of the rate
+         */
+        uint8_t get_rx_index();
+
+        /**
+         * @brief Gets the rate to write to a receiver at
+         *
+         * @param rx_id: ID of the receiver
+         * @return Index of the rate, LINK_RATE_DEFAULT for a receiver not reached yet
+         */
+        uint8_t get_tx_index(uint8_t rx_id);
+
+        /**
+         * @brief Determines if a receiver's rate is known
+         *
+         * @param rx_id: ID of the receiver
+         * @return True if a write to the receiver was acknowledged. Otherwise false
+         */
+        bool is_reached(uint8_t rx_id);
+
+        /**
+         * @brief Gets the rate to try after a write to a receiver failed
+         *
+         * Rates are tried fastest first, skipping the one already tried.
+         *
+         * @param tried: index of the rate the write first failed at
+         * @param attempt: number of rates tried after the first
+         * @return Index of the rate, or -1 if every rate has been tried
+         */
+        int8_t get_fallback_index(uint8_t tried, uint8_t attempt);
+
+        /**
+         * @brief Records the rate a receiver acknowledged a write at
+         *
+         * @param rx_id: ID of the receiver
+         * @param index: index of the rate
+         */
+        void record_tx(uint8_t rx_id, uint8_t index);
+};
+
+
+#endif // _LINK_RATE_HPP_
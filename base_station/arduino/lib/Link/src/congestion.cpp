@@ -0,0 +1,55 @@
+/**
+* @brief: Contains the implementation of the CongestionMeter class.
+* @file: congestion.cpp
+*
+* @author: jkieltyka15
+*/
+
+// standard libraries
+#include <Arduino.h>
+
+// local dependencies
+#include "congestion.hpp"
+
+#define CONGESTION_SAMPLE_FULL 255      // sample of a full receive FIFO or failed write
+#define CONGESTION_SAMPLE_BACKLOG 128   // sample of a message waiting behind the one read
+#define CONGESTION_SAMPLE_ARC 16        // sample added by each retransmission
+
+
+void CongestionMeter::add_sample(uint8_t sample) {
+
+    // moving average over roughly the last eight samples
+    this->load = this->load - (this->load / 8) + (sample / 8);
+}
+
+
+void CongestionMeter::record_rx(bool is_fifo_full, bool is_backlog) {
+
+    if (true == is_fifo_full) {
+        this->add_sample(CONGESTION_SAMPLE_FULL);
+    }
+
+    else {
+        this->add_sample((true == is_backlog) ? CONGESTION_SAMPLE_BACKLOG : 0);
+    }
+}
+
+
+void CongestionMeter::record_tx(bool is_sent, uint8_t arc) {
+
+    if (false == is_sent) {
+        this->add_sample(CONGESTION_SAMPLE_FULL);
+    }
+
+    else {
+        uint16_t sample = (uint16_t)arc * CONGESTION_SAMPLE_ARC;
+        this->add_sample((CONGESTION_SAMPLE_FULL < sample) ? CONGESTION_SAMPLE_FULL : (uint8_t)sample);
+    }
+}
+
+
+uint8_t CongestionMeter::get_level() {
+
+    // four equal bands of the average
+    return this->load >> 6;
+}
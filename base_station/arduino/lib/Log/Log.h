@@ -2,6 +2,13 @@
 * @brief: Contains macros to simplify logging
 * @file: Log.h
 *
+* Log statements take a printf style format string that is kept in flash
+* and are formatted into a fixed size stack buffer, so logging never touches
+* the heap. The verbosity is chosen at compile time with LOG_LEVEL. Any
+* statement above the selected level expands to nothing, including its
+* arguments, so production builds can compile logging out entirely with
+* -D LOG_LEVEL=LOG_LEVEL_NONE.
+*
 * @author: jkieltyka15
 */
 
@@ -9,10 +16,64 @@
 #define _LOG_H_
 
 #include <Arduino.h>
+#include <stdarg.h>
+#include <stdio.h>
 #include <string.h>
 
-#define INFO(str)  Serial.println("INFO: " + (String)str);
-#define WARN(str)  Serial.println("WARN: " + (String)str);
-#define ERROR(str) Serial.println("ERROR: " + (String)str);
+#define LOG_LEVEL_NONE  0   // no logging
+#define LOG_LEVEL_ERROR 1   // only errors
+#define LOG_LEVEL_WARN  2   // errors and warnings
+#define LOG_LEVEL_INFO  3   // errors, warnings and information
+
+// verbosity of the build which can be overridden with a build flag
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+// size in bytes of the buffer a single log line is formatted into
+#ifndef LOG_BUFFER_SIZE
+#define LOG_BUFFER_SIZE 64
+#endif
+
+
+/**
+ * @brief Formats and writes a single log line to the serial port
+ *
+ * @param prefix: severity prefix stored in flash
+ * @param format: printf style format string stored in flash
+ *
+ * @note lines longer than LOG_BUFFER_SIZE are truncated
+ */
+inline void log_write(const __FlashStringHelper* prefix, PGM_P format, ...) {
+
+    char line[LOG_BUFFER_SIZE];
+
+    va_list args;
+    va_start(args, format);
+    vsnprintf_P(line, sizeof(line), format, args);
+    va_end(args);
+
+    Serial.print(prefix);
+    Serial.println(line);
+}
+
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define INFO(format, ...)  log_write(F("INFO: "), PSTR(format), ##__VA_ARGS__)
+#else
+#define INFO(format, ...)  do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define WARN(format, ...)  log_write(F("WARN: "), PSTR(format), ##__VA_ARGS__)
+#else
+#define WARN(format, ...)  do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define ERROR(format, ...) log_write(F("ERROR: "), PSTR(format), ##__VA_ARGS__)
+#else
+#define ERROR(format, ...) do {} while (0)
+#endif
 
 #endif // _LOG_H_
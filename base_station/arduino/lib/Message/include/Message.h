@@ -10,5 +10,12 @@
 
 #include "message.hpp"
 #include "updatemessage.hpp"
+#include "statsmessage.hpp"
+#include "pingmessage.hpp"
+#include "syncmessage.hpp"
+#include "beaconmessage.hpp"
+#include "statusrequestmessage.hpp"
+#include "resyncmessage.hpp"
+#include "configmessage.hpp"
 
 #endif // _MESSAGE_H_
@@ -0,0 +1,77 @@
+/**
+* @brief: Contains the prototype of the ResyncMessage class.
+* @file: resyncmessage.hpp
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _RESYNC_MESSAGE_HPP_
+#define _RESYNC_MESSAGE_HPP_
+
+// standard libraries
+#include <Arduino.h>
+
+// local dependencies
+#include "message.hpp"
+
+#define RESYNC_NODE_MAX 15      // highest node ID a resync report can carry
+#define RESYNC_DEPTH_MAX 4      // deepest node given its own reply slot
+#define RESYNC_SLOT_MS 500      // time between the reply slots of neighbouring depths
+
+// time from a new epoch to the last reply slot closing
+#define RESYNC_ROUND_MS ((RESYNC_DEPTH_MAX + 1) * RESYNC_SLOT_MS)
+
+
+/**
+ * The status of every node below the sender, sent once after the base
+ * station boots with a new epoch. Nodes reply in slots by depth, deepest
+ * first and spread out by node ID within a slot, so each relay has merged
+ * the reports of the nodes below it into its own before its slot comes.
+ */
+class __attribute__((packed)) ResyncMessage : public Message {
+
+    private:
+
+        uint8_t epoch = 0;      // boot of the base station being answered
+        uint16_t reported = 0;  // bit N is set if node N is reported
+        uint16_t vacant = 0;    // bit N is set if reported node N is vacant
+
+
+    public:
+
+        /**
+         * @brief Constructs a ResyncMessage object
+         * 
+         * @param rx_id: ID of receiving node
+         * @param tx_id: ID of transmitting node
+         * @param epoch: boot of the base station being answered
+         * @param reported: bitmap where bit N is set if node N is reported
+         * @param vacant: bitmap where bit N is set if reported node N is vacant
+         */
+        ResyncMessage(uint8_t rx_id, uint8_t tx_id, uint8_t epoch, uint16_t reported, uint16_t vacant);
+        ResyncMessage();
+
+        /**
+         * @brief Gets the boot of the base station being answered
+         * 
+         * @return Epoch of the base station
+         */
+        uint8_t get_epoch();
+
+        /**
+         * @brief Gets the nodes reported
+         * 
+         * @return Bitmap where bit N is set if node N is reported
+         */
+        uint16_t get_reported();
+
+        /**
+         * @brief Gets the vacancy status of the nodes reported
+         * 
+         * @return Bitmap where bit N is set if reported node N is vacant
+         */
+        uint16_t get_vacant();
+};
+
+
+#endif // _RESYNC_MESSAGE_HPP_
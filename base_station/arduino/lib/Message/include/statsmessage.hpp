@@ -0,0 +1,72 @@
+/**
+* @brief: Contains the prototype of the StatsMessage class.
+* @file: statsmessage.hpp
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _STATS_MESSAGE_HPP_
+#define _STATS_MESSAGE_HPP_
+
+// standard libraries
+#include <Arduino.h>
+
+// local dependencies
+#include "message.hpp"
+#include "updatemessage.hpp"
+
+
+// network health statistics of a sensor node since it booted
+struct node_stats_t {
+    uint16_t tx_attempts;       // messages the node attempted to send
+    uint16_t tx_failures;       // messages that were not sent
+    uint16_t arc_total;         // automatic retransmissions of all sent messages
+    uint16_t carrier_busy;      // times the receiver's channel was found busy
+    uint16_t relayed;           // messages sent on behalf of other nodes
+    uint16_t free_ram;          // free RAM in bytes
+    uint8_t queue_high_water;   // most messages ever waiting to be handled
+};
+
+
+/**
+ * A heartbeat that also carries the reporting node's network statistics.
+ * It is an UpdateMessage so it refreshes the node's vacancy status as well.
+ */
+class __attribute__((packed)) StatsMessage : public UpdateMessage {
+
+    private:
+
+        uint16_t tx_attempts = 0;
+        uint16_t tx_failures = 0;
+        uint16_t arc_total = 0;
+        uint16_t carrier_busy = 0;
+        uint16_t relayed = 0;
+        uint16_t free_ram = 0;
+        uint8_t queue_high_water = 0;
+
+
+    public:
+
+        /**
+         * @brief Constructs a StatsMessage object
+         * 
+         * @param rx_id: ID of receiving node
+         * @param tx_id: ID of transmitting node
+         * @param node_id: ID of node reporting its status
+         * @param is_vacant: Node's vacancy status
+         * @param stats: Node's network statistics
+         */
+        StatsMessage(uint8_t rx_id, uint8_t tx_id, uint8_t node_id, bool is_vacant,
+                     const node_stats_t* stats);
+        StatsMessage();
+
+        /**
+         * @brief Gets the network statistics of the reporting node
+         * 
+         * @param stats: statistics to fill
+         */
+        void get_stats(node_stats_t* stats);
+};
+
+
+#endif // _STATS_MESSAGE_HPP_
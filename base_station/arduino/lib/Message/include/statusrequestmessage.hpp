@@ -0,0 +1,109 @@
+/**
+* @brief: Contains the prototype of the StatusRequestMessage class.
+* @file: statusrequestmessage.hpp
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _STATUS_REQUEST_MESSAGE_HPP_
+#define _STATUS_REQUEST_MESSAGE_HPP_
+
+// standard libraries
+#include <Arduino.h>
+
+// local dependencies
+#include "message.hpp"
+
+#define REQUEST_NODE_MAX 15     // highest node ID a status request can target
+#define REQUEST_HOPS_MAX 8      // copies this far from the base station are dropped, ending any loop of stale routes
+
+
+/**
+ * Asks a set of nodes to report their status now instead of at their next
+ * heartbeat. The request travels down from the base station and every node
+ * splits it among its next egress nodes, so each copy only targets the
+ * nodes reached through its receiver.
+ */
+class __attribute__((packed)) StatusRequestMessage : public Message {
+
+    private:
+
+        uint8_t seq = 0;        // request started by the base station
+        uint8_t hops = 0;       // hops from the base station to the sender
+        uint16_t targets = 0;   // bit N is set if node N should report
+
+
+    protected:
+
+        /**
+         * @brief Constructs a StatusRequestMessage object of a derived message type
+         * 
+         * @param rx_id: ID of receiving node
+         * @param tx_id: ID of transmitting node
+         * @param seq: request started by the base station
+         * @param hops: hops from the base station to the sender
+         * @param targets: bitmap where bit N is set if node N should report
+         * @param msg_type: type of message
+         */
+        StatusRequestMessage(uint8_t rx_id, uint8_t tx_id, uint8_t seq, uint8_t hops, uint16_t targets, uint8_t msg_type);
+
+
+    public:
+
+        /**
+         * @brief Constructs a StatusRequestMessage object
+         * 
+         * @param rx_id: ID of receiving node
+         * @param tx_id: ID of transmitting node
+         * @param seq: request started by the base station
+         * @param hops: hops from the base station to the sender
+         * @param targets: bitmap where bit N is set if node N should report
+         */
+        StatusRequestMessage(uint8_t rx_id, uint8_t tx_id, uint8_t seq, uint8_t hops, uint16_t targets);
+        StatusRequestMessage();
+
+        /**
+         * @brief Gets the request started by the base station
+         * 
+         * @return Sequence number of the request
+         */
+        uint8_t get_seq();
+
+        /**
+         * @brief Gets the hops from the base station to the sender
+         * 
+         * @return Number of hops
+         */
+        uint8_t get_hops();
+
+        /**
+         * @brief Gets the nodes that should report
+         * 
+         * @return Bitmap where bit N is set if node N should report
+         */
+        uint16_t get_targets();
+
+        /**
+         * @brief Determines if a node should report
+         * 
+         * @param node_id: ID of the node
+         * @return True if the node is a target. Otherwise false
+         */
+        bool is_target(uint8_t node_id);
+
+        /**
+         * @brief Readdresses the request to the next node on its way
+         * 
+         * Derived requests keep the rest of their payload, so one copy can be
+         * sent on to each next node in turn.
+         * 
+         * @param rx_id: ID of receiving node
+         * @param tx_id: ID of transmitting node
+         * @param hops: hops from the base station to the new sender
+         * @param targets: targets reached through the receiver
+         */
+        void readdress(uint8_t rx_id, uint8_t tx_id, uint8_t hops, uint16_t targets);
+};
+
+
+#endif // _STATUS_REQUEST_MESSAGE_HPP_
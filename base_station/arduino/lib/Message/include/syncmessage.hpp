@@ -0,0 +1,100 @@
+/**
+* @brief: Contains the prototype of the SyncMessage class.
+* @file: syncmessage.hpp
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _SYNC_MESSAGE_HPP_
+#define _SYNC_MESSAGE_HPP_
+
+// standard libraries
+#include <Arduino.h>
+
+// local dependencies
+#include "message.hpp"
+
+// expected time in milliseconds from stamping a sync message to it being received
+#define SYNC_TX_DELAY_MS 1
+
+// most the time from stamping to being received differs from SYNC_TX_DELAY_MS
+#define SYNC_TX_JITTER_MS 1
+
+
+/**
+ * Network time flooded outwards from the base station, whose millis() is
+ * network time. The sender stamps the message just before writing it,
+ * without automatic retransmissions, so it carries the network time at
+ * which it is received and how far that may be off.
+ */
+class __attribute__((packed)) SyncMessage : public Message {
+
+    private:
+
+        uint8_t epoch = 0;          // changes every time the base station boots
+        uint8_t seq = 0;            // sync round started by the base station
+        uint8_t hops = 0;           // hops from the base station to the sender
+        uint32_t network_ms = 0;    // network time when the message is received
+        uint16_t error_ms = 0;      // most network_ms may be off
+
+
+    public:
+
+        /**
+         * @brief Constructs a SyncMessage object
+         * 
+         * @param rx_id: ID of receiving node
+         * @param tx_id: ID of transmitting node
+         * @param epoch: boot of the base station that started the round
+         * @param seq: sync round started by the base station
+         * @param hops: hops from the base station to the sender
+         */
+        SyncMessage(uint8_t rx_id, uint8_t tx_id, uint8_t epoch, uint8_t seq, uint8_t hops);
+        SyncMessage();
+
+        /**
+         * @brief Stamps the network time just before the message is written
+         * 
+         * @param network_ms: sender's network time now
+         * @param error_ms: most the sender's network time may be off
+         */
+        void stamp(uint32_t network_ms, uint16_t error_ms);
+
+        /**
+         * @brief Gets the boot of the base station that started the round
+         * 
+         * @return Epoch of the base station, never 0
+         */
+        uint8_t get_epoch();
+
+        /**
+         * @brief Gets the sync round
+         * 
+         * @return Sequence number of the round
+         */
+        uint8_t get_seq();
+
+        /**
+         * @brief Gets the hops from the base station to the sender
+         * 
+         * @return Number of hops
+         */
+        uint8_t get_hops();
+
+        /**
+         * @brief Gets the network time when the message is received
+         * 
+         * @return Network time in milliseconds
+         */
+        uint32_t get_network_ms();
+
+        /**
+         * @brief Gets the most the network time may be off
+         * 
+         * @return Error bound in milliseconds
+         */
+        uint16_t get_error_ms();
+};
+
+
+#endif // _SYNC_MESSAGE_HPP_
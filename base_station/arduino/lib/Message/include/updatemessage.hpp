@@ -14,13 +14,52 @@
 // local dependencies
 #include "message.hpp"
 
+#define PRIORITY_STATE_CHANGE 0 // a parking space changed status
+#define PRIORITY_HEARTBEAT 1    // periodic report that may be dropped or coalesced under load
 
-class UpdateMessage : public Message {
+#define ALIVE_NODE_MAX 15       // highest node ID that fits in the alive bitmap
+
+#define PATH_TRACE_MAX 8        // relays recorded in the path trace, four bits each
+#define PATH_NODE_MAX 14        // highest relay ID that fits in the path trace
+#define PATH_RELAY_UNKNOWN 0    // relay not recorded or with an ID that does not fit
+
+
+/**
+ * A vacancy status report forwarded hop by hop to the base station. The
+ * message carries how long ago the reporting node saw its status change,
+ * grown by every node it passes through, so the base station can tell how
+ * old the news is without a clock shared across the network.
+ *
+ * Relays also mark themselves and the nodes they recently heard from in an
+ * alive bitmap, so liveness reaches the base station on any report instead
+ * of needing a heartbeat from every node. The first relays also write their
+ * IDs into a path trace, so the base station sees the route a report took.
+ */
+class __attribute__((packed)) UpdateMessage : public Message {
 
     private:
 
         uint8_t node_id = 0;
         uint8_t is_vacant = true;
+        uint16_t age_ms = 0;    // time since the status changed, saturating
+        uint8_t hops = 0;       // number of nodes that relayed the message
+        uint8_t priority = PRIORITY_STATE_CHANGE;   // lower values are sent first
+        uint16_t alive = 0;     // bit N is set if node N was heard by a relay of the message
+        uint8_t path[PATH_TRACE_MAX / 2] = {0};    // relay IDs in order, two to a byte, low half first
+
+
+    protected:
+
+        /**
+         * @brief Constructs an UpdateMessage object of a derived message type
+         * 
+         * @param rx_id: ID of receiving node
+         * @param tx_id: ID of transmitting node
+         * @param node_id: ID of node reporting its status
+         * @param is_vacant: Node's vacancy status
+         * @param msg_type: type of message
+         */
+        UpdateMessage(uint8_t rx_id, uint8_t tx_id, uint8_t node_id, bool is_vacant, uint8_t msg_type);
 
 
     public:
@@ -49,6 +88,97 @@ class UpdateMessage : public Message {
          * @return True if the status is vacant. Otherwise false.
          */
         bool get_is_vacant();
+
+        /**
+         * @brief Gets the time since the reporting node saw its status change
+         * 
+         * @return Age in milliseconds
+         */
+        uint16_t get_age_ms();
+
+        /**
+         * @brief Gets the number of nodes that relayed the message
+         * 
+         * @return Number of relays
+         */
+        uint8_t get_hops();
+
+        /**
+         * @brief Gets the priority of the message
+         * 
+         * @return PRIORITY_STATE_CHANGE or PRIORITY_HEARTBEAT
+         */
+        uint8_t get_priority();
+
+        /**
+         * @brief Sets the priority carried over from a received message
+         * 
+         * @param priority: PRIORITY_STATE_CHANGE or PRIORITY_HEARTBEAT
+         */
+        void set_priority(uint8_t priority);
+
+        /**
+         * @brief Gets the nodes the relays of the message heard from
+         * 
+         * @return Bitmap where bit N is set if node N is alive
+         */
+        uint16_t get_alive();
+
+        /**
+         * @brief Determines if a node is marked alive by the message
+         * 
+         * @param node_id: ID of the node
+         * @return True if the node is marked alive. Otherwise false
+         */
+        bool is_alive(uint8_t node_id);
+
+        /**
+         * @brief Marks more nodes alive
+         * 
+         * @param alive: bitmap where bit N is set if node N is alive
+         */
+        void add_alive(uint16_t alive);
+
+        /**
+         * @brief Sets the age and relay count carried over from a received message
+         * 
+         * @param age_ms: time since the status changed in milliseconds
+         * @param hops: number of nodes that relayed the message
+         */
+        void set_age(uint16_t age_ms, uint8_t hops);
+
+        /**
+         * @brief Adds time the message spent waiting at the current node
+         * 
+         * @param elapsed_ms: time in milliseconds
+         */
+        void add_age(uint32_t elapsed_ms);
+
+        /**
+         * @brief Carries the path trace of a received message over and adds a relay
+         * 
+         * The relay is recorded as hop get_hops() + 1 of the received message.
+         * Relays past PATH_TRACE_MAX are only counted in the hops.
+         * 
+         * @param msg: message being relayed
+         * @param relay_id: ID of the relaying node
+         */
+        void trace_relay(UpdateMessage* msg, uint8_t relay_id);
+
+        /**
+         * @brief Gets the number of relays recorded in the path trace
+         * 
+         * @return Number of relays, at most PATH_TRACE_MAX
+         */
+        uint8_t get_path_length();
+
+        /**
+         * @brief Gets a relay recorded in the path trace
+         * 
+         * @param index: position of the relay, 0 being the first after the reporting node
+         * @return ID of the relay, or PATH_RELAY_UNKNOWN if it was not recorded
+         */
+        uint8_t get_relay(uint8_t index);
 };
 
 
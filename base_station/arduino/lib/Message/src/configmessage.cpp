@@ -0,0 +1,72 @@
+/**
+* @brief: Contains the implementation of the ConfigMessage class.
+* @file: configmessage.cpp
+*
+* @author: jkieltyka15
+*/
+
+// standard libraries
+#include <Arduino.h>
+
+// local dependencies
+#include "message.hpp"
+#include "statusrequestmessage.hpp"
+#include "configmessage.hpp"
+
+
+ConfigMessage::ConfigMessage() : StatusRequestMessage() {}
+
+
+ConfigMessage::ConfigMessage(uint8_t rx_id,
+                             uint8_t tx_id,
+                             uint8_t seq,
+                             uint8_t hops,
+                             uint16_t targets)
+                             : StatusRequestMessage(rx_id, tx_id, seq, hops, targets, MESSAGE_CONFIG) {}
+
+
+bool ConfigMessage::add_setting(uint8_t setting, uint16_t value) {
+
+    // setting is not known
+    if (CONFIG_SETTING_NUM <= setting) {
+        return false;
+    }
+
+    // a later value of a setting replaces the earlier one
+    for (uint8_t i = 0; i < this->num_settings; i++) {
+        if (setting == this->settings[i]) {
+            this->values[i] = value;
+            return true;
+        }
+    }
+
+    // no room for another setting
+    if (CONFIG_SETTINGS_MAX <= this->num_settings) {
+        return false;
+    }
+
+    this->settings[this->num_settings] = setting;
+    this->values[this->num_settings] = value;
+    this->num_settings++;
+
+    return true;
+}
+
+
+uint8_t ConfigMessage::get_num_settings() {
+
+    return (CONFIG_SETTINGS_MAX < this->num_settings) ? CONFIG_SETTINGS_MAX : this->num_settings;
+}
+
+
+bool ConfigMessage::get_setting(uint8_t index, uint8_t* setting, uint16_t* value) {
+
+    if (this->get_num_settings() <= index) {
+        return false;
+    }
+
+    *setting = this->settings[index];
+    *value = this->values[index];
+
+    return true;
+}
@@ -34,6 +34,18 @@ uint8_t Message::get_rx_id() {
 }
 
 
+void Message::set_rx_id(uint8_t rx_id) {
+
+    this->rx_id = rx_id;
+}
+
+
+void Message::set_tx_id(uint8_t tx_id) {
+
+    this->tx_id = tx_id;
+}
+
+
 uint8_t Message::get_tx_id() {
 
     return this->tx_id;
@@ -0,0 +1,76 @@
+/**
+* @brief: Contains the implementation of the PingMessage class.
+* @file: pingmessage.cpp
+*
+* @author: jkieltyka15
+*/
+
+// standard libraries
+#include <Arduino.h>
+
+// local dependencies
+#include "message.hpp"
+#include "pingmessage.hpp"
+
+
+PingMessage::PingMessage() : Message() {}
+
+
+PingMessage::PingMessage(uint8_t rx_id,
+                         uint8_t tx_id,
+                         uint8_t msg_type,
+                         uint8_t seq,
+                         const uint8_t* route,
+                         uint8_t route_len,
+                         uint8_t hop,
+                         uint32_t send_us,
+                         uint8_t arc) : Message(rx_id, tx_id, msg_type) {
+
+    // routes longer than a message can hold are cut short
+    if (PING_ROUTE_MAX < route_len) {
+        route_len = PING_ROUTE_MAX;
+    }
+
+    this->seq = seq;
+    this->hop = hop;
+    this->route_len = route_len;
+    memcpy(this->route, route, route_len);
+    this->send_us = send_us;
+    this->arc = arc;
+}
+
+
+uint8_t PingMessage::get_seq() {
+
+    return this->seq;
+}
+
+
+uint8_t PingMessage::get_hop() {
+
+    return this->hop;
+}
+
+
+uint8_t PingMessage::get_route_len() {
+
+    return this->route_len;
+}
+
+
+const uint8_t* PingMessage::get_route() {
+
+    return this->route;
+}
+
+
+uint32_t PingMessage::get_send_us() {
+
+    return this->send_us;
+}
+
+
+uint8_t PingMessage::get_arc() {
+
+    return this->arc;
+}
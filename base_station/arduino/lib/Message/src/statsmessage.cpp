@@ -0,0 +1,49 @@
+/**
+* @brief: Contains the implementation of the StatsMessage class.
+* @file: statsmessage.cpp
+*
+* @author: jkieltyka15
+*/
+
+// standard libraries
+#include <Arduino.h>
+
+// local dependencies
+#include "message.hpp"
+#include "updatemessage.hpp"
+#include "statsmessage.hpp"
+
+
+StatsMessage::StatsMessage() : UpdateMessage() {}
+
+
+StatsMessage::StatsMessage(uint8_t rx_id,
+                           uint8_t tx_id,
+                           uint8_t node_id,
+                           bool is_vacant,
+                           const node_stats_t* stats)
+                           : UpdateMessage(rx_id, tx_id, node_id, is_vacant, MESSAGE_STATS) {
+
+    // statistics are periodic so they give way to status changes
+    this->set_priority(PRIORITY_HEARTBEAT);
+
+    this->tx_attempts = stats->tx_attempts;
+    this->tx_failures = stats->tx_failures;
+    this->arc_total = stats->arc_total;
+    this->carrier_busy = stats->carrier_busy;
+    this->relayed = stats->relayed;
+    this->free_ram = stats->free_ram;
+    this->queue_high_water = stats->queue_high_water;
+}
+
+
+void StatsMessage::get_stats(node_stats_t* stats) {
+
+    stats->tx_attempts = this->tx_attempts;
+    stats->tx_failures = this->tx_failures;
+    stats->arc_total = this->arc_total;
+    stats->carrier_busy = this->carrier_busy;
+    stats->relayed = this->relayed;
+    stats->free_ram = this->free_ram;
+    stats->queue_high_water = this->queue_high_water;
+}
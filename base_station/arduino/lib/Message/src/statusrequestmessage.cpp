@@ -0,0 +1,78 @@
+/**
+* @brief: Contains the implementation of the StatusRequestMessage class.
+* @file: statusrequestmessage.cpp
+*
+* @author: jkieltyka15
+*/
+
+// standard libraries
+#include <Arduino.h>
+
+// local dependencies
+#include "message.hpp"
+#include "statusrequestmessage.hpp"
+
+
+StatusRequestMessage::StatusRequestMessage() : Message() {}
+
+
+StatusRequestMessage::StatusRequestMessage(uint8_t rx_id,
+                                           uint8_t tx_id,
+                                           uint8_t seq,
+                                           uint8_t hops,
+                                           uint16_t targets) : Message(rx_id, tx_id, MESSAGE_STATUS_REQUEST) {
+
+    this->seq = seq;
+    this->hops = hops;
+    this->targets = targets;
+}
+
+
+StatusRequestMessage::StatusRequestMessage(uint8_t rx_id,
+                                           uint8_t tx_id,
+                                           uint8_t seq,
+                                           uint8_t hops,
+                                           uint16_t targets,
+                                           uint8_t msg_type) : Message(rx_id, tx_id, msg_type) {
+
+    this->seq = seq;
+    this->hops = hops;
+    this->targets = targets;
+}
+
+
+uint8_t StatusRequestMessage::get_seq() {
+
+    return this->seq;
+}
+
+
+uint8_t StatusRequestMessage::get_hops() {
+
+    return this->hops;
+}
+
+
+uint16_t StatusRequestMessage::get_targets() {
+
+    return this->targets;
+}
+
+
+bool StatusRequestMessage::is_target(uint8_t node_id) {
+
+    if (REQUEST_NODE_MAX < node_id) {
+        return false;
+    }
+
+    return 0 != (this->targets & (1U << node_id));
+}
+
+
+void StatusRequestMessage::readdress(uint8_t rx_id, uint8_t tx_id, uint8_t hops, uint16_t targets) {
+
+    this->set_rx_id(rx_id);
+    this->set_tx_id(tx_id);
+    this->hops = hops;
+    this->targets = targets;
+}
@@ -0,0 +1,63 @@
+/**
+* @brief: Contains the prototype functions for the parking map.
+* @file: parkingmap.hpp
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _PARKING_MAP_H_
+#define _PARKING_MAP_H_
+
+// standard libraries
+#include <Arduino.h>
+
+#define MAP_NODE_MAX 10         // highest sensor node ID on the parking map
+#define INGRESS_HOPS_MAX 2      // most next nodes a node can forward an ingress message to
+#define TREE_CHILDREN_MAX 4     // most child nodes a node can have in the flooding tree
+
+/**
+ * @brief Gets the next node ID for forwarding an ingress message
+ * 
+ * @param node_id: ID of current node
+ * @return Next node ID on success. Otherwise -1
+ */
+int16_t get_next_ingress_node(uint8_t node_id);
+
+/**
+ * @brief Gets every node an ingress message may be forwarded to
+ * 
+ * The first node is the preferred one down a row when there is a choice,
+ * so following the first node from any node always reaches the base station.
+ * 
+ * @param node_id: ID of current node
+ * @param hops: array of INGRESS_HOPS_MAX to hold the next node IDs
+ * @return Number of next nodes
+ */
+uint8_t get_ingress_hops(uint8_t node_id, uint8_t* hops);
+
+/**
+ * @brief Gets the nodes that forward ingress messages to a node by preference
+ * 
+ * Together these form a tree rooted at the base station that reaches
+ * every node, for flooding messages outwards.
+ * 
+ * @param node_id: ID of current node, or the base station
+ * @param children: array of size to hold the child node IDs
+ * @param size: size of children
+ * @return Number of child nodes
+ */
+uint8_t get_tree_children(uint8_t node_id, uint8_t* children, uint8_t size);
+
+/**
+ * @brief Gets the next node ID for forwarding an egress message
+ * 
+ * Follows the flooding tree from the current node towards the target, so
+ * the result is the child whose subtree holds the target.
+ * 
+ * @param node_id: ID of current node, or the base station
+ * @param target_id: ID of node the message is for
+ * @return Next node ID on success. Otherwise -1
+ */
+int16_t get_next_egress_node(uint8_t node_id, uint8_t target_id);
+
+#endif // _PARKING_MAP_H_
@@ -0,0 +1,80 @@
+/**
+* @brief: Contains the implementation of the EgressTable class.
+* @file: egresstable.cpp
+*
+* @author: jkieltyka15
+*/
+
+// standard libraries
+#include <Arduino.h>
+
+// local dependencies
+#include "egresstable.hpp"
+#include "parkingmap.hpp"
+
+
+void EgressTable::learn(uint8_t target_id, uint8_t via_id) {
+
+    if ((0 == target_id) || (MAP_NODE_MAX < target_id) || (MAP_NODE_MAX < via_id)) {
+        return;
+    }
+
+    this->via[target_id] = via_id;
+}
+
+
+void EgressTable::forget(uint8_t target_id) {
+
+    if ((0 == target_id) || (MAP_NODE_MAX < target_id)) {
+        return;
+    }
+
+    this->via[target_id] = EGRESS_UNKNOWN;
+}
+
+
+int16_t EgressTable::get_next_node(uint8_t node_id, uint8_t target_id) {
+
+    if ((0 == target_id) || (MAP_NODE_MAX < target_id) || (node_id == target_id)) {
+        return -1;
+    }
+
+    // learned from the reports of the target
+    uint8_t via_id = this->via[target_id];
+    if ((EGRESS_UNKNOWN != via_id) && (node_id != via_id)) {
+        return via_id;
+    }
+
+    return get_next_egress_node(node_id, target_id);
+}
+
+
+uint16_t EgressTable::take_group(uint8_t node_id, uint16_t* targets, int16_t* next_id) {
+
+    uint16_t group = 0;
+    bool is_first = true;
+
+    for (uint8_t target_id = 1; target_id <= MAP_NODE_MAX; target_id++) {
+
+        uint16_t bit = (uint16_t)(1U << target_id);
+        if (0 == (*targets & bit)) {
+            continue;
+        }
+
+        int16_t target_next_id = this->get_next_node(node_id, target_id);
+
+        // lowest remaining target picks the next node of the group
+        if (true == is_first) {
+            *next_id = target_next_id;
+            is_first = false;
+        }
+
+        if (*next_id == target_next_id) {
+            group |= bit;
+        }
+    }
+
+    *targets &= ~group;
+
+    return group;
+}
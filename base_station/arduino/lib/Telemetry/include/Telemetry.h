@@ -0,0 +1,14 @@
+/**
+* @brief: Includes all required headers for the Telemetry library
+* @file: Telemetry.h
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _TELEMETRY_H_
+#define _TELEMETRY_H_
+
+#include "cobs.hpp"
+#include "telemetryframe.hpp"
+
+#endif // _TELEMETRY_H_
@@ -0,0 +1,58 @@
+/**
+* @brief: Contains the prototypes for COBS framing and CRC checks.
+* @file: cobs.hpp
+*
+* Shared by the base station firmware and the host tools, so only the
+* standard integer headers are used.
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _COBS_HPP_
+#define _COBS_HPP_
+
+// standard libraries
+#include <stdint.h>
+#include <stddef.h>
+
+// byte that terminates every encoded frame
+#define COBS_DELIMITER 0x00
+
+/**
+ * @brief Calculates the worst case size of a COBS encoded buffer
+ *
+ * @param len: number of bytes to be encoded
+ * @return Worst case number of encoded bytes, excluding the delimiter
+ */
+#define COBS_ENCODED_MAX(len) ((len) + ((len) / 254) + 1)
+
+/**
+ * @brief COBS encodes a buffer so it contains no delimiter bytes
+ *
+ * @param src: bytes to encode
+ * @param len: number of bytes to encode
+ * @param dst: buffer of at least COBS_ENCODED_MAX(len) bytes for the result
+ * @return Number of encoded bytes written to dst. The delimiter is not written
+ */
+uint16_t cobs_encode(const uint8_t* src, uint16_t len, uint8_t* dst);
+
+/**
+ * @brief Decodes a COBS encoded buffer
+ *
+ * @param src: encoded bytes without the trailing delimiter
+ * @param len: number of encoded bytes
+ * @param dst: buffer of at least len bytes for the result
+ * @return Number of decoded bytes on success. Otherwise -1
+ */
+int16_t cobs_decode(const uint8_t* src, uint16_t len, uint8_t* dst);
+
+/**
+ * @brief Calculates the CRC-16/CCITT-FALSE of a buffer
+ *
+ * @param data: bytes to calculate the CRC over
+ * @param len: number of bytes
+ * @return CRC of the buffer
+ */
+uint16_t crc16_ccitt(const uint8_t* data, uint16_t len);
+
+#endif // _COBS_HPP_
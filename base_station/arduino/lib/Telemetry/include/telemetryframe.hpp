@@ -0,0 +1,157 @@
+/**
+* @brief: Contains the prototype of the TelemetryFrame class.
+* @file: telemetryframe.hpp
+*
+* A frame is a type, a sequence number, a millisecond timestamp and a small
+* payload of little endian fields followed by a CRC-16. On the wire the frame
+* is COBS encoded and terminated by a zero byte, so a reader can always
+* resynchronize on the next delimiter.
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _TELEMETRY_FRAME_HPP_
+#define _TELEMETRY_FRAME_HPP_
+
+// standard libraries
+#include <stdint.h>
+#include <stddef.h>
+
+// local dependencies
+#include "cobs.hpp"
+
+// frame types and their payloads (all fields little endian)
+#define TELEMETRY_BOOT          0   // u8 number of sensor nodes
+#define TELEMETRY_STATE_CHANGE  1   // u8 node ID, u8 is vacant, u16 sensor to paint latency in ms, u8 relays
+#define TELEMETRY_COUNTERS      2   // telemetry_counters_t fields in order
+#define TELEMETRY_SNAPSHOT      3   // u8 number of nodes, u8 number vacant, vacancy bitmap, u8 number stale
+#define TELEMETRY_NODE_STATS    4   // u8 node ID, u16 tx attempts, u16 tx failures, u16 ARC total,
+                                    // u16 carrier busy, u16 relayed, u16 free RAM, u8 queue high water
+#define TELEMETRY_CAPTURE       5   // u32 receive time in microseconds, raw radio payload
+#define TELEMETRY_LIVENESS      6   // u8 node ID, u8 is stale, u32 time since last heard in ms
+
+#define TELEMETRY_HEADER_SIZE   6   // type, sequence number and timestamp
+#define TELEMETRY_CRC_SIZE      2   // size of the trailing CRC
+#define TELEMETRY_PAYLOAD_MAX   40  // largest payload a frame can carry
+
+// largest decoded frame
+#define TELEMETRY_FRAME_MAX (TELEMETRY_HEADER_SIZE + TELEMETRY_PAYLOAD_MAX + TELEMETRY_CRC_SIZE)
+
+// largest encoded frame including the delimiter
+#define TELEMETRY_ENCODED_MAX (COBS_ENCODED_MAX(TELEMETRY_FRAME_MAX) + 1)
+
+
+// base station counters reported in a TELEMETRY_COUNTERS frame
+struct telemetry_counters_t {
+    uint16_t rx_messages;       // messages read from the radio
+    uint16_t rx_rejected;       // messages for another node or from an invalid node
+    uint16_t rx_unknown;        // messages of an unknown type
+    uint16_t state_changes;     // parking space status changes
+    uint16_t frames_dropped;    // telemetry frames dropped since serial was busy
+    uint16_t stale_events;      // times a node went a liveness window without being heard
+};
+
+
+class TelemetryFrame {
+
+    private:
+
+        uint8_t data[TELEMETRY_FRAME_MAX];  // header, payload and room for the CRC
+        uint8_t len = 0;                    // number of header and payload bytes
+
+
+    public:
+
+        /**
+         * @brief Constructs a TelemetryFrame object
+         *
+         * @param type: type of frame
+         * @param seq: sequence number of frame
+         * @param timestamp: time in milliseconds the frame was created
+         */
+        TelemetryFrame(uint8_t type, uint8_t seq, uint32_t timestamp);
+        TelemetryFrame();
+
+        /**
+         * @brief Appends a field to the payload
+         *
+         * @param value: value of the field
+         * @return True if the payload had room. Otherwise false
+         */
+        bool put_u8(uint8_t value);
+        bool put_u16(uint16_t value);
+        bool put_u32(uint32_t value);
+
+        /**
+         * @brief Appends raw bytes to the payload
+         *
+         * @param bytes: bytes to append
+         * @param size: number of bytes
+         * @return True if the payload had room. Otherwise false
+         */
+        bool put_bytes(const uint8_t* bytes, uint8_t size);
+
+        /**
+         * @brief Encodes the frame for transmission
+         *
+         * @param buffer: buffer of at least TELEMETRY_ENCODED_MAX bytes
+         * @return Number of encoded bytes including the delimiter
+         */
+        uint8_t encode(uint8_t* buffer);
+
+        /**
+         * @brief Decodes a received frame and verifies its CRC
+         *
+         * @param buffer: encoded bytes without the delimiter
+         * @param size: number of encoded bytes
+         * @return True if the frame is valid. Otherwise false
+         */
+        bool decode(const uint8_t* buffer, uint16_t size);
+
+        /**
+         * @brief Gets the type of frame
+         *
+         * @return Type of frame
+         */
+        uint8_t get_type();
+
+        /**
+         * @brief Gets the sequence number of the frame
+         *
+         * @return Sequence number of the frame
+         */
+        uint8_t get_seq();
+
+        /**
+         * @brief Gets the time in milliseconds the frame was created
+         *
+         * @return Timestamp of the frame
+         */
+        uint32_t get_timestamp();
+
+        /**
+         * @brief Gets the payload of the frame
+         *
+         * @return Pointer to the first payload byte
+         */
+        const uint8_t* get_payload();
+
+        /**
+         * @brief Gets the size of the payload
+         *
+         * @return Number of payload bytes
+         */
+        uint8_t get_payload_size();
+};
+
+
+/**
+ * @brief Reads a little endian field from a payload
+ *
+ * @param bytes: first byte of the field
+ * @return Value of the field
+ */
+uint16_t telemetry_read_u16(const uint8_t* bytes);
+uint32_t telemetry_read_u32(const uint8_t* bytes);
+
+#endif // _TELEMETRY_FRAME_HPP_
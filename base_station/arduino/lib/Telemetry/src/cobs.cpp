@@ -0,0 +1,101 @@
+/**
+* @brief: Contains the implementation of COBS framing and CRC checks.
+* @file: cobs.cpp
+*
+* @author: jkieltyka15
+*/
+
+// standard libraries
+#include <stdint.h>
+#include <stddef.h>
+
+// local dependencies
+#include "cobs.hpp"
+
+
+// CRC-16/CCITT-FALSE polynomial and initial value
+#define CRC16_POLYNOMIAL 0x1021
+#define CRC16_INITIAL    0xFFFF
+
+// largest run a single COBS code byte can describe
+#define COBS_MAX_RUN 0xFF
+
+
+uint16_t cobs_encode(const uint8_t* src, uint16_t len, uint8_t* dst) {
+
+    uint16_t write_index = 1;
+    uint16_t code_index = 0;
+    uint8_t code = 1;
+
+    for (uint16_t i = 0; i < len; i++) {
+
+        // delimiter ends the current run
+        if (COBS_DELIMITER == src[i]) {
+            dst[code_index] = code;
+            code_index = write_index++;
+            code = 1;
+            continue;
+        }
+
+        dst[write_index++] = src[i];
+        code++;
+
+        // run is as long as a code byte allows so start a new one
+        if (COBS_MAX_RUN == code) {
+            dst[code_index] = code;
+            code_index = write_index++;
+            code = 1;
+        }
+    }
+
+    dst[code_index] = code;
+
+    return write_index;
+}
+
+
+int16_t cobs_decode(const uint8_t* src, uint16_t len, uint8_t* dst) {
+
+    uint16_t read_index = 0;
+    uint16_t write_index = 0;
+
+    while (read_index < len) {
+
+        uint8_t code = src[read_index];
+
+        // a delimiter or a run past the end of the buffer is corrupt
+        if ((COBS_DELIMITER == code) || ((read_index + code) > len)) {
+            return -1;
+        }
+
+        read_index++;
+
+        for (uint8_t i = 1; i < code; i++) {
+            dst[write_index++] = src[read_index++];
+        }
+
+        // every run except a maximum length or final run implies a zero
+        if ((COBS_MAX_RUN != code) && (read_index < len)) {
+            dst[write_index++] = COBS_DELIMITER;
+        }
+    }
+
+    return write_index;
+}
+
+
+uint16_t crc16_ccitt(const uint8_t* data, uint16_t len) {
+
+    uint16_t crc = CRC16_INITIAL;
+
+    for (uint16_t i = 0; i < len; i++) {
+
+        crc ^= (uint16_t)data[i] << 8;
+
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ CRC16_POLYNOMIAL : (crc << 1);
+        }
+    }
+
+    return crc;
+}
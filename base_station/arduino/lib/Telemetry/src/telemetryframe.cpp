@@ -0,0 +1,170 @@
+/**
+* @brief: Contains the implementation of the TelemetryFrame class.
+* @file: telemetryframe.cpp
+*
+* @author: jkieltyka15
+*/
+
+// standard libraries
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+// local dependencies
+#include "cobs.hpp"
+#include "telemetryframe.hpp"
+
+
+TelemetryFrame::TelemetryFrame() {
+
+    memset(this->data, 0, sizeof(this->data));
+    this->len = 0;
+}
+
+
+TelemetryFrame::TelemetryFrame(uint8_t type, uint8_t seq, uint32_t timestamp) {
+
+    memset(this->data, 0, sizeof(this->data));
+    this->len = 0;
+
+    (void) this->put_u8(type);
+    (void) this->put_u8(seq);
+    (void) this->put_u32(timestamp);
+}
+
+
+bool TelemetryFrame::put_u8(uint8_t value) {
+
+    // leave room for the CRC
+    if ((TELEMETRY_FRAME_MAX - TELEMETRY_CRC_SIZE) < (this->len + sizeof(value))) {
+        return false;
+    }
+
+    this->data[this->len++] = value;
+
+    return true;
+}
+
+
+bool TelemetryFrame::put_u16(uint16_t value) {
+
+    const uint8_t bytes[] = { (uint8_t)value, (uint8_t)(value >> 8) };
+
+    return this->put_bytes(bytes, sizeof(bytes));
+}
+
+
+bool TelemetryFrame::put_u32(uint32_t value) {
+
+    const uint8_t bytes[] = {
+        (uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24)
+    };
+
+    return this->put_bytes(bytes, sizeof(bytes));
+}
+
+
+bool TelemetryFrame::put_bytes(const uint8_t* bytes, uint8_t size) {
+
+    // leave room for the CRC
+    if ((TELEMETRY_FRAME_MAX - TELEMETRY_CRC_SIZE) < (this->len + size)) {
+        return false;
+    }
+
+    memcpy(&this->data[this->len], bytes, size);
+    this->len += size;
+
+    return true;
+}
+
+
+uint8_t TelemetryFrame::encode(uint8_t* buffer) {
+
+    // append CRC of header and payload
+    uint8_t frame[TELEMETRY_FRAME_MAX];
+    uint16_t crc = crc16_ccitt(this->data, this->len);
+    memcpy(frame, this->data, this->len);
+    frame[this->len] = (uint8_t)crc;
+    frame[this->len + 1] = (uint8_t)(crc >> 8);
+
+    // encode and terminate the frame
+    uint16_t size = cobs_encode(frame, this->len + TELEMETRY_CRC_SIZE, buffer);
+    buffer[size++] = COBS_DELIMITER;
+
+    return (uint8_t)size;
+}
+
+
+bool TelemetryFrame::decode(const uint8_t* buffer, uint16_t size) {
+
+    // frame cannot fit
+    if (COBS_ENCODED_MAX(TELEMETRY_FRAME_MAX) < size) {
+        return false;
+    }
+
+    uint8_t frame[COBS_ENCODED_MAX(TELEMETRY_FRAME_MAX)];
+    int16_t frame_len = cobs_decode(buffer, size, frame);
+
+    // frame is corrupt or too short to contain a header
+    if ((TELEMETRY_HEADER_SIZE + TELEMETRY_CRC_SIZE) > frame_len
+        || TELEMETRY_FRAME_MAX < frame_len) {
+        return false;
+    }
+
+    // verify CRC
+    uint16_t len = frame_len - TELEMETRY_CRC_SIZE;
+    uint16_t crc = frame[len] | ((uint16_t)frame[len + 1] << 8);
+    if (crc != crc16_ccitt(frame, len)) {
+        return false;
+    }
+
+    memcpy(this->data, frame, len);
+    this->len = (uint8_t)len;
+
+    return true;
+}
+
+
+uint8_t TelemetryFrame::get_type() {
+
+    return this->data[0];
+}
+
+
+uint8_t TelemetryFrame::get_seq() {
+
+    return this->data[1];
+}
+
+
+uint32_t TelemetryFrame::get_timestamp() {
+
+    return telemetry_read_u32(&this->data[2]);
+}
+
+
+const uint8_t* TelemetryFrame::get_payload() {
+
+    return &this->data[TELEMETRY_HEADER_SIZE];
+}
+
+
+uint8_t TelemetryFrame::get_payload_size() {
+
+    return this->len - TELEMETRY_HEADER_SIZE;
+}
+
+
+uint16_t telemetry_read_u16(const uint8_t* bytes) {
+
+    return bytes[0] | ((uint16_t)bytes[1] << 8);
+}
+
+
+uint32_t telemetry_read_u32(const uint8_t* bytes) {
+
+    return bytes[0]
+        | ((uint32_t)bytes[1] << 8)
+        | ((uint32_t)bytes[2] << 16)
+        | ((uint32_t)bytes[3] << 24);
+}
@@ -0,0 +1,663 @@
+/**
+* @brief: Contains the implementation of the BaseStationState class.
+* @file: basestationstate.cpp
+*
+* @author: jkieltyka15
+*/
+
+// standard libraries
+#include <Arduino.h>
+
+// local libraries
+#include <Message.h>
+
+// local dependencies
+#include "basestationstate.hpp"
+
+
+BaseStationState::BaseStationState(uint8_t node_id) {
+
+    this->node_id = node_id;
+}
+
+
+bool BaseStationState::init() {
+
+    // assuming status of all sensor nodes are vacant on initialization
+    for (uint8_t i = 0; i < sizeof(this->node_status); i++) {
+        this->node_status[i] = true;
+    }
+
+    // every sensor node has one liveness window from boot to be heard
+    uint32_t now_ms = millis();
+    for (uint8_t node_id = 1; node_id <= SENSOR_NODE_NUM; node_id++) {
+        if (true == this->is_valid_sensor_node(node_id)) {
+            this->heard_ms[node_id - 1] = now_ms;
+            this->liveness.schedule(node_id, now_ms);
+        }
+    }
+
+    // show the lot as the last boot left it. Nodes tell a reboot from a
+    // missed flood by the epoch changing, so without one pick it at random
+    this->is_restored = this->restore_state();
+
+    if (false == this->is_restored) {
+        this->epoch = (uint8_t)random(1, 256);
+    }
+
+    // the next boot must not reuse this epoch
+    this->write_state(now_ms);
+
+    return true;
+}
+
+
+uint8_t BaseStationState::get_id() {
+
+    return this->node_id;
+}
+
+
+bool BaseStationState::is_valid_sensor_node(uint8_t node_id) {
+
+    return node_id <= SENSOR_NODE_NUM && node_id != this->node_id;
+}
+
+
+bool BaseStationState::update_node_status(uint8_t node_id, bool is_vacant) {
+
+    // provided node id is not valid
+    if (false == this->is_valid_sensor_node(node_id)) {
+        return false;
+    }
+
+    // changes are saved in batches
+    if (is_vacant != this->node_status[node_id - 1]) {
+
+        if (0 == this->unsaved_changes) {
+            this->unsaved_since_ms = millis();
+        }
+
+        if (0xFF > this->unsaved_changes) {
+            this->unsaved_changes++;
+        }
+    }
+
+    this->node_status[node_id - 1] = is_vacant;
+
+    return true;
+}
+
+bool BaseStationState::get_node_status(uint8_t node_id) {
+
+    // provided node id is not valid
+    if (false == this->is_valid_sensor_node(node_id)) {
+        return false;
+    }
+
+    return this->node_status[node_id - 1];
+}
+
+
+uint8_t BaseStationState::num_vacant() {
+
+    uint8_t num_vacant = 0;
+
+    // count number of vacant statuses
+    for (uint8_t i = 0; i < sizeof(this->node_status); i++) {
+
+        // status is vacant
+        if (true == node_status[i]) {
+            num_vacant++;
+        }
+    }
+
+    return num_vacant;
+}
+
+
+bool BaseStationState::update_node_stats(uint8_t node_id, const node_stats_t* stats) {
+
+    // provided node id is not valid
+    if (false == this->is_valid_sensor_node(node_id)) {
+        return false;
+    }
+
+    this->node_stats[node_id - 1] = *stats;
+    this->node_stats_reports[node_id - 1]++;
+
+    return true;
+}
+
+
+const node_stats_t* BaseStationState::get_node_stats(uint8_t node_id) {
+
+    // provided node id is not valid
+    if (false == this->is_valid_sensor_node(node_id)) {
+        return NULL;
+    }
+
+    return &this->node_stats[node_id - 1];
+}
+
+
+uint16_t BaseStationState::get_node_stats_reports(uint8_t node_id) {
+
+    // provided node id is not valid
+    if (false == this->is_valid_sensor_node(node_id)) {
+        return 0;
+    }
+
+    return this->node_stats_reports[node_id - 1];
+}
+
+
+bool BaseStationState::record_latency(uint8_t node_id, uint32_t latency_ms) {
+
+    // provided node id is not valid
+    if (false == this->is_valid_sensor_node(node_id)) {
+        return false;
+    }
+
+    // find the first bin whose upper bound is above the latency
+    uint8_t bin = 0;
+    while ((LATENCY_HIST_BINS - 1 > bin) && ((1UL << (LATENCY_HIST_SHIFT + bin)) <= latency_ms)) {
+        bin++;
+    }
+
+    uint8_t* hist = this->latency_hist[node_id - 1];
+
+    // halve every count of the node rather than let one saturate
+    if (0xFF == hist[bin]) {
+        for (uint8_t i = 0; i < LATENCY_HIST_BINS; i++) {
+            hist[i] /= 2;
+        }
+    }
+
+    hist[bin]++;
+
+    uint16_t saturated_ms = (0xFFFF < latency_ms) ? 0xFFFF : (uint16_t)latency_ms;
+    if (saturated_ms > this->latency_max_ms[node_id - 1]) {
+        this->latency_max_ms[node_id - 1] = saturated_ms;
+    }
+
+    return true;
+}
+
+
+const uint8_t* BaseStationState::get_latency_hist(uint8_t node_id) {
+
+    // provided node id is not valid
+    if (false == this->is_valid_sensor_node(node_id)) {
+        return NULL;
+    }
+
+    return this->latency_hist[node_id - 1];
+}
+
+
+uint16_t BaseStationState::get_latency_max_ms(uint8_t node_id) {
+
+    // provided node id is not valid
+    if (false == this->is_valid_sensor_node(node_id)) {
+        return 0;
+    }
+
+    return this->latency_max_ms[node_id - 1];
+}
+
+
+bool BaseStationState::record_route(UpdateMessage* msg) {
+
+    uint8_t node_id = msg->get_node_id();
+
+    // provided node id is not valid
+    if (false == this->is_valid_sensor_node(node_id)) {
+        return false;
+    }
+
+#ifdef ROUTE_HIST_ENABLED
+    uint8_t* hops = this->route_hops[node_id - 1];
+    uint8_t* relays = this->route_relays[node_id - 1];
+    uint8_t bin = (ROUTE_HOP_BINS - 1 < msg->get_hops()) ? ROUTE_HOP_BINS - 1 : msg->get_hops();
+
+    // halve every count of the node rather than let one saturate
+    if (0xFF == hops[bin]) {
+        for (uint8_t i = 0; i < ROUTE_HOP_BINS; i++) {
+            hops[i] /= 2;
+        }
+    }
+
+    hops[bin]++;
+#endif // ROUTE_HIST_ENABLED
+
+    uint8_t path_len = msg->get_path_length();
+    uint8_t* path = this->route_last[node_id - 1];
+
+    this->route_last_len[node_id - 1] = path_len;
+    memset(path, 0, PATH_TRACE_MAX / 2);
+
+    for (uint8_t i = 0; i < path_len; i++) {
+
+        uint8_t relay_id = msg->get_relay(i);
+        path[i / 2] |= relay_id << ((i % 2) * 4);
+
+        // relay not recorded or not one of the counted nodes
+        if ((PATH_RELAY_UNKNOWN == relay_id) || (ROUTE_RELAY_NUM < relay_id)) {
+            continue;
+        }
+
+#ifdef ROUTE_HIST_ENABLED
+        if (0xFF == relays[relay_id - 1]) {
+            for (uint8_t j = 0; j < ROUTE_RELAY_NUM; j++) {
+                relays[j] /= 2;
+            }
+        }
+
+        relays[relay_id - 1]++;
+#endif // ROUTE_HIST_ENABLED
+
+        if (0xFFFF > this->relay_load[relay_id - 1]) {
+            this->relay_load[relay_id - 1]++;
+        }
+    }
+
+    return true;
+}
+
+
+#ifdef ROUTE_HIST_ENABLED
+const uint8_t* BaseStationState::get_route_hops(uint8_t node_id) {
+
+    // provided node id is not valid
+    if (false == this->is_valid_sensor_node(node_id)) {
+        return NULL;
+    }
+
+    return this->route_hops[node_id - 1];
+}
+
+
+const uint8_t* BaseStationState::get_route_relays(uint8_t node_id) {
+
+    // provided node id is not valid
+    if (false == this->is_valid_sensor_node(node_id)) {
+        return NULL;
+    }
+
+    return this->route_relays[node_id - 1];
+}
+#endif // ROUTE_HIST_ENABLED
+
+
+uint8_t BaseStationState::get_route_last(uint8_t node_id, uint8_t* path) {
+
+    // provided node id is not valid
+    if (false == this->is_valid_sensor_node(node_id)) {
+        return 0;
+    }
+
+    uint8_t path_len = this->route_last_len[node_id - 1];
+    const uint8_t* packed = this->route_last[node_id - 1];
+
+    for (uint8_t i = 0; i < path_len; i++) {
+        path[i] = (packed[i / 2] >> ((i % 2) * 4)) & 0x0F;
+    }
+
+    return path_len;
+}
+
+
+uint16_t BaseStationState::get_relay_load(uint8_t relay_id) {
+
+    // relay is not one of the counted nodes
+    if ((0 == relay_id) || (ROUTE_RELAY_NUM < relay_id)) {
+        return 0;
+    }
+
+    return this->relay_load[relay_id - 1];
+}
+
+
+bool BaseStationState::mark_heard(uint8_t node_id, uint32_t now_ms) {
+
+    // provided node id is not valid
+    if (false == this->is_valid_sensor_node(node_id)) {
+        return false;
+    }
+
+    this->heard_ms[node_id - 1] = now_ms;
+    this->liveness.schedule(node_id, now_ms);
+
+    // node was stale until now
+    if (true == this->node_stale[node_id - 1]) {
+        this->node_stale[node_id - 1] = false;
+        this->stale_num--;
+        return true;
+    }
+
+    return false;
+}
+
+
+uint32_t BaseStationState::get_heard_ms(uint8_t node_id) {
+
+    // provided node id is not valid
+    if (false == this->is_valid_sensor_node(node_id)) {
+        return 0;
+    }
+
+    return this->heard_ms[node_id - 1];
+}
+
+
+int16_t BaseStationState::expire_stale(uint32_t now_ms) {
+
+    int16_t node_id = this->liveness.expire(now_ms);
+
+    // nodes leave the wheel when they expire so each goes stale once
+    if (0 < node_id) {
+        this->node_stale[node_id - 1] = true;
+        this->stale_num++;
+    }
+
+    return node_id;
+}
+
+
+bool BaseStationState::is_node_stale(uint8_t node_id) {
+
+    // provided node id is not valid
+    if (false == this->is_valid_sensor_node(node_id)) {
+        return false;
+    }
+
+    return this->node_stale[node_id - 1];
+}
+
+
+uint8_t BaseStationState::num_stale() {
+
+    return this->stale_num;
+}
+
+
+EgressTable* BaseStationState::get_egress() {
+
+    return &this->egress;
+}
+
+
+void BaseStationState::request_status(uint16_t targets) {
+
+    this->request_targets |= targets;
+}
+
+
+uint16_t BaseStationState::take_request() {
+
+    uint16_t targets = this->request_targets;
+
+    if (0 != targets) {
+        this->request_targets = 0;
+        this->request_seq++;
+    }
+
+    return targets;
+}
+
+
+bool BaseStationState::push_config(uint16_t targets, uint8_t setting, uint16_t value) {
+
+    // settings waiting for other targets must go first
+    if ((0 != this->config.get_num_settings()) && (targets != this->config.get_targets())) {
+        return false;
+    }
+
+    // the first setting names the targets
+    if (0 == this->config.get_num_settings()) {
+        this->config = ConfigMessage(0, this->node_id, 0, 0, targets);
+    }
+
+    return this->config.add_setting(setting, value);
+}
+
+
+bool BaseStationState::take_config(ConfigMessage* msg) {
+
+    if ((0 == this->config.get_num_settings()) || (0 == this->config.get_targets())) {
+        return false;
+    }
+
+    this->request_seq++;
+    *msg = ConfigMessage(0, this->node_id, this->request_seq, 0, this->config.get_targets());
+
+    for (uint8_t i = 0; i < this->config.get_num_settings(); i++) {
+
+        uint8_t setting = 0;
+        uint16_t value = 0;
+
+        (void) this->config.get_setting(i, &setting, &value);
+        (void) msg->add_setting(setting, value);
+    }
+
+    this->config = ConfigMessage();
+
+    return true;
+}
+
+
+uint8_t BaseStationState::get_request_seq() {
+
+    return this->request_seq;
+}
+
+
+uint8_t BaseStationState::get_epoch() {
+
+    return this->epoch;
+}
+
+
+void BaseStationState::mark_resynced(uint8_t node_id) {
+
+    // provided node id is not valid
+    if (false == this->is_valid_sensor_node(node_id)) {
+        return;
+    }
+
+    this->node_resynced[node_id - 1] = true;
+}
+
+
+bool BaseStationState::apply_resync(uint8_t node_id, bool is_vacant) {
+
+    // provided node id is not valid or its status is already known
+    if ((false == this->is_valid_sensor_node(node_id)) || (true == this->node_resynced[node_id - 1])) {
+        return false;
+    }
+
+    this->node_resynced[node_id - 1] = true;
+
+    if (is_vacant == this->node_status[node_id - 1]) {
+        return false;
+    }
+
+    return this->update_node_status(node_id, is_vacant);
+}
+
+
+uint16_t BaseStationState::take_resync_missing(uint32_t now_ms) {
+
+    // round has not started, has not ended or was already checked
+    if ((false == this->is_sync_sent) || (true == this->is_resync_checked) ||
+        ((RESYNC_ROUND_MS + RESYNC_SLOT_MS) > (now_ms - this->resync_start_ms))) {
+        return 0;
+    }
+
+    this->is_resync_checked = true;
+
+    uint16_t missing = 0;
+    for (uint8_t node_id = 1; (node_id <= SENSOR_NODE_NUM) && (node_id <= REQUEST_NODE_MAX); node_id++) {
+        if ((true == this->is_valid_sensor_node(node_id)) && (false == this->node_resynced[node_id - 1])) {
+            missing |= (uint16_t)(1U << node_id);
+        }
+    }
+
+    return missing;
+}
+
+
+bool BaseStationState::restore_state() {
+
+    lot_record_t record;
+
+    // nothing saved or saved for a lot of another size
+    if ((false == this->lot_store.load(&record)) || (SENSOR_NODE_NUM != record.node_num)) {
+        return false;
+    }
+
+    for (uint8_t node_id = 1; node_id <= SENSOR_NODE_NUM; node_id++) {
+        this->node_status[node_id - 1] = (0 != (record.vacant[(node_id - 1) / 8] & (1 << ((node_id - 1) % 8))));
+    }
+
+    // floods sent after the last save are never more than the drift ahead of it
+    this->sync_seq = record.sync_seq + LOT_SEQ_DRIFT_MAX;
+    this->beacon_seq = record.beacon_seq + LOT_SEQ_DRIFT_MAX;
+    this->request_seq = record.request_seq + LOT_SEQ_DRIFT_MAX;
+
+    // epoch 0 is never used so a node's initial epoch always differs
+    this->epoch = (0xFF == record.epoch) ? 1 : record.epoch + 1;
+
+    return true;
+}
+
+
+void BaseStationState::write_state(uint32_t now_ms) {
+
+    lot_record_t record;
+    memset(&record, 0, sizeof(record));
+
+    record.node_num = SENSOR_NODE_NUM;
+    record.epoch = this->epoch;
+    record.sync_seq = this->sync_seq;
+    record.beacon_seq = this->beacon_seq;
+    record.request_seq = this->request_seq;
+
+    for (uint8_t node_id = 1; node_id <= SENSOR_NODE_NUM; node_id++) {
+        if (true == this->node_status[node_id - 1]) {
+            record.vacant[(node_id - 1) / 8] |= 1 << ((node_id - 1) % 8);
+        }
+    }
+
+    this->lot_store.save(&record);
+
+    memcpy(&this->saved, &record, sizeof(record));
+    this->saved_ms = now_ms;
+    this->unsaved_changes = 0;
+}
+
+
+bool BaseStationState::is_state_restored() {
+
+    return this->is_restored;
+}
+
+
+bool BaseStationState::save_state(uint32_t now_ms) {
+
+    // spread saves out even while the lot is busy
+    if (LOT_SAVE_SPACING_MS > (now_ms - this->saved_ms)) {
+        return false;
+    }
+
+    bool is_changes_due = (LOT_SAVE_CHANGES <= this->unsaved_changes) ||
+        ((0 < this->unsaved_changes) && (LOT_SAVE_PERIOD_MS <= (now_ms - this->unsaved_since_ms)));
+
+    bool is_seq_due = (LOT_SEQ_DRIFT_MAX <= (uint8_t)(this->sync_seq - this->saved.sync_seq)) ||
+        (LOT_SEQ_DRIFT_MAX <= (uint8_t)(this->beacon_seq - this->saved.beacon_seq)) ||
+        (LOT_SEQ_DRIFT_MAX <= (uint8_t)(this->request_seq - this->saved.request_seq));
+
+    if ((false == is_changes_due) && (false == is_seq_due)) {
+        return false;
+    }
+
+    this->write_state(now_ms);
+
+    return true;
+}
+
+
+void BaseStationState::set_rx_idle_ms(uint32_t now_ms) {
+
+    this->rx_idle_ms = now_ms;
+}
+
+
+uint32_t BaseStationState::get_rx_idle_ms() {
+
+    return this->rx_idle_ms;
+}
+
+
+ProbeSweep* BaseStationState::get_probe_sweep() {
+
+    return &this->probe_sweep;
+}
+
+
+CongestionMeter* BaseStationState::get_congestion() {
+
+    return &this->congestion;
+}
+
+
+LinkRate* BaseStationState::get_link_rate() {
+
+    return &this->link_rate;
+}
+
+
+bool BaseStationState::is_sync_due(uint32_t now_ms) {
+
+    if ((true == this->is_sync_sent) && (SYNC_PERIOD_MS > now_ms - this->sync_sent_ms)) {
+        return false;
+    }
+
+    // the first flood carries the new epoch and starts the resync round
+    if (false == this->is_sync_sent) {
+        this->resync_start_ms = now_ms;
+    }
+
+    this->sync_sent_ms = now_ms;
+    this->sync_seq++;
+    this->is_sync_sent = true;
+
+    return true;
+}
+
+
+uint8_t BaseStationState::get_sync_seq() {
+
+    return this->sync_seq;
+}
+
+
+bool BaseStationState::is_beacon_due(uint32_t now_ms) {
+
+    if ((true == this->is_beacon_sent) && (BEACON_PERIOD_MS > now_ms - this->beacon_sent_ms)) {
+        return false;
+    }
+
+    this->beacon_sent_ms = now_ms;
+    this->beacon_seq++;
+    this->is_beacon_sent = true;
+
+    return true;
+}
+
+
+uint8_t BaseStationState::get_beacon_seq() {
+
+    return this->beacon_seq;
+}
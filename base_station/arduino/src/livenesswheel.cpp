@@ -0,0 +1,106 @@
+/**
+* @brief: Contains the implementation of the LivenessWheel class.
+* @file: livenesswheel.cpp
+*
+* @author: jkieltyka15
+*/
+
+// standard libraries
+#include <Arduino.h>
+
+// local dependencies
+#include "livenesswheel.hpp"
+
+
+void LivenessWheel::unlink(uint8_t node_id) {
+
+    uint8_t next_id = this->next[node_id];
+    uint8_t prev_id = this->prev[node_id];
+
+    // node is first in its slot
+    if (LIVENESS_NONE == prev_id) {
+        this->slot_head[this->deadline_tick[node_id] % LIVENESS_WHEEL_SLOTS] = next_id;
+    }
+
+    else {
+        this->next[prev_id] = next_id;
+    }
+
+    if (LIVENESS_NONE != next_id) {
+        this->prev[next_id] = prev_id;
+    }
+
+    this->is_scheduled[node_id] = false;
+}
+
+
+void LivenessWheel::schedule(uint8_t node_id, uint32_t now_ms) {
+
+    // provided node id is not valid
+    if ((LIVENESS_NONE == node_id) || (SENSOR_NODE_NUM < node_id)) {
+        return;
+    }
+
+    if (true == this->is_scheduled[node_id]) {
+        this->unlink(node_id);
+    }
+
+    // push the node onto the slot of its deadline
+    uint16_t deadline = (uint16_t)((now_ms + LIVENESS_WINDOW_MS) >> LIVENESS_SLOT_SHIFT);
+    uint8_t slot = deadline % LIVENESS_WHEEL_SLOTS;
+
+    this->deadline_tick[node_id] = deadline;
+    this->prev[node_id] = LIVENESS_NONE;
+    this->next[node_id] = this->slot_head[slot];
+
+    if (LIVENESS_NONE != this->slot_head[slot]) {
+        this->prev[this->slot_head[slot]] = node_id;
+    }
+
+    this->slot_head[slot] = node_id;
+    this->is_scheduled[node_id] = true;
+}
+
+
+void LivenessWheel::cancel(uint8_t node_id) {
+
+    if ((LIVENESS_NONE == node_id) || (SENSOR_NODE_NUM < node_id)) {
+        return;
+    }
+
+    if (true == this->is_scheduled[node_id]) {
+        this->unlink(node_id);
+    }
+}
+
+
+int16_t LivenessWheel::expire(uint32_t now_ms) {
+
+    uint16_t now_tick = (uint16_t)(now_ms >> LIVENESS_SLOT_SHIFT);
+
+    // after a long pause one turn of the wheel still finds every overdue node
+    if (LIVENESS_WHEEL_SLOTS < (uint16_t)(now_tick - this->tick)) {
+        this->tick = now_tick - LIVENESS_WHEEL_SLOTS;
+    }
+
+    // a slot is checked once its whole span has passed
+    while (this->tick != now_tick) {
+
+        uint8_t node_id = this->slot_head[this->tick % LIVENESS_WHEEL_SLOTS];
+
+        while (LIVENESS_NONE != node_id) {
+
+            // deadlines of a later turn of the wheel share the slot
+            if (0 >= (int16_t)(this->deadline_tick[node_id] - this->tick)) {
+                this->unlink(node_id);
+                return node_id;
+            }
+
+            node_id = this->next[node_id];
+        }
+
+        this->tick++;
+    }
+
+    return -1;
+}
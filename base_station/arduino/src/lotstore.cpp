@@ -0,0 +1,94 @@
+/**
+* @brief: Contains the implementation of the LotStore class.
+* @file: lotstore.cpp
+*
+* @author: jkieltyka15
+*/
+
+// standard libraries
+#include <Arduino.h>
+#include <EEPROM.h>
+
+// local dependencies
+#include "lotstore.hpp"
+
+
+/**
+ * @brief Calculates the CRC-8 of a buffer
+ *
+ * @param data: bytes to calculate the CRC over
+ * @param len: number of bytes
+ * @return CRC of the buffer
+ */
+static uint8_t crc8(const uint8_t* data, uint8_t len) {
+
+    uint8_t crc = 0;
+
+    for (uint8_t i = 0; i < len; i++) {
+
+        crc ^= data[i];
+
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (0 != (crc & 0x80)) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+
+bool LotStore::read_slot(uint16_t slot, lot_record_t* record) {
+
+    uint8_t* bytes = (uint8_t*)record;
+    uint16_t address = LOT_STORE_ADDR + (slot * sizeof(lot_record_t));
+
+    for (uint8_t i = 0; i < sizeof(lot_record_t); i++) {
+        bytes[i] = EEPROM.read(address + i);
+    }
+
+    return (LOT_STORE_MAGIC == record->magic) &&
+        (record->checksum == crc8(bytes, sizeof(lot_record_t) - 1));
+}
+
+
+bool LotStore::load(lot_record_t* record) {
+
+    bool is_found = false;
+    lot_record_t slot_record;
+
+    for (uint16_t slot = 0; slot < LOT_STORE_SLOTS; slot++) {
+
+        if (false == this->read_slot(slot, &slot_record)) {
+            continue;
+        }
+
+        // generations in the ring are never more than a ring apart, so they compare across a wrap
+        if ((false == is_found) || (0 < (int16_t)(slot_record.generation - record->generation))) {
+            memcpy(record, &slot_record, sizeof(slot_record));
+            this->next_slot = (slot + 1) % LOT_STORE_SLOTS;
+            is_found = true;
+        }
+    }
+
+    this->generation = (true == is_found) ? record->generation + 1 : 0;
+
+    return is_found;
+}
+
+
+void LotStore::save(lot_record_t* record) {
+
+    record->magic = LOT_STORE_MAGIC;
+    record->generation = this->generation;
+    record->checksum = crc8((const uint8_t*)record, sizeof(lot_record_t) - 1);
+
+    const uint8_t* bytes = (const uint8_t*)record;
+    uint16_t address = LOT_STORE_ADDR + (this->next_slot * sizeof(lot_record_t));
+
+    for (uint8_t i = 0; i < sizeof(lot_record_t); i++) {
+        EEPROM.update(address + i, bytes[i]);
+    }
+
+    this->next_slot = (this->next_slot + 1) % LOT_STORE_SLOTS;
+    this->generation++;
+}
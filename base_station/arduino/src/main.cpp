@@ -9,151 +9,560 @@
 #include <Arduino.h>
 #include <stdlib.h>
 #include <Wire.h>
+#include <nRF24L01.h>
+#include <RF24.h>
 
 // local libraries
 #include <Log.h>
 
 // local dependencies
 #include "basestation.hpp"
+#include "mainloop.hpp"
+#include "messagehandler.hpp"
 #include "parkingdisplay.hpp"
+#include "probesweep.hpp"
+#include "profiling.hpp"
+#include "telemetry.hpp"
 
 
 // unique ID for base station
 #define BASE_STATION 0
 
-// baud rate for serial connection
+// unconnected analog pin whose noise seeds the epoch of each boot
+#define RANDOM_SEED_PIN A0
+
+// baud rate for serial connection. Telemetry needs a faster link to keep up
+#ifdef TELEMETRY_ENABLED
+#define SERIAL_BAUD 115200
+#else
 #define SERIAL_BAUD 9600
+#endif
 
-// delay in main loop in milliseconds
-#define MAIN_LOOP_DELAY_MS 100
+#define SERIAL_CMD_PROFILE_DUMP  'p'    // print profiling phases and counters
+#define SERIAL_CMD_PROFILE_RESET 'r'    // clear profiling phases and counters
+#define SERIAL_CMD_NODE_STATS    's'    // print network statistics of every node
+#define SERIAL_CMD_PROBE_SWEEP   'g'    // probe every link of the parking map
+#define SERIAL_CMD_PROBE_LINKS   'l'    // print round trip time and delivery of every link
+#define SERIAL_CMD_LATENCY       'e'    // print sensor to paint latency histogram of every node
+#define SERIAL_CMD_LIVENESS      'h'    // print time since every node was last heard from
+#define SERIAL_CMD_ROUTES        't'    // print the last path of every node, relay loads and any route histograms
+#define SERIAL_CMD_STATUS_REQUEST 'q'   // poll the lot, q<id> one node or q<first>-<last> a region
+#define SERIAL_CMD_CONFIG         'c'   // c<setting>=<value> pushes a timing setting, ,<id> or ,<first>-<last> to some nodes
 
-// size of message buffer
-#define MSG_BUFFER_SIZE 32
+#define SERIAL_LINE_MAX 24              // longest command line after the command byte, including the terminator
+#define SERIAL_LINE_TIMEOUT_MS 1000UL   // time the rest of a command line has to arrive in
 
 
 // base station of WSN
-BaseStation base_station = BaseStation(BASE_STATION);
+BaseStation<RF24> base_station = BaseStation<RF24>(BASE_STATION);
+
+// counters reported over telemetry
+telemetry_counters_t counters = {};
 
 
 /**
- * @brief Initialize all necessary objects and variables.
+ * @brief Prints the most recent network statistics of every sensor node
  */
-void setup() {
+static void print_node_stats() {
+
+    Serial.println(F("STATS: node,reports,tx_attempts,tx_failures,avg_arc_x100,carrier_busy,relayed,queue_high_water,free_ram"));
+
+    for (uint8_t node_id = 1; node_id <= SENSOR_NODE_NUM; node_id++) {
+
+        const node_stats_t* stats = base_station.get_node_stats(node_id);
+        uint16_t avg_arc = (0 == stats->tx_attempts)
+            ? 0 : (uint16_t)(((uint32_t)stats->arc_total * 100) / stats->tx_attempts);
+
+        Serial.print(node_id);
+        Serial.print(',');
+        Serial.print(base_station.get_node_stats_reports(node_id));
+        Serial.print(',');
+        Serial.print(stats->tx_attempts);
+        Serial.print(',');
+        Serial.print(stats->tx_failures);
+        Serial.print(',');
+        Serial.print(avg_arc);
+        Serial.print(',');
+        Serial.print(stats->carrier_busy);
+        Serial.print(',');
+        Serial.print(stats->relayed);
+        Serial.print(',');
+        Serial.print(stats->queue_high_water);
+        Serial.print(',');
+        Serial.println(stats->free_ram);
+    }
+}
 
-    Serial.begin(SERIAL_BAUD);
-  
-    // initialize the base station
-    if (false == base_station.init()) {
 
-        ERROR("Failed to initialize base station. Check hardware")
+/**
+ * @brief Prints the sensor to paint latency histogram of every sensor node
+ */
+static void print_latency() {
+
+    Serial.print(F("LATENCY: node,max_ms"));
+    for (uint8_t bin = 0; bin < LATENCY_HIST_BINS; bin++) {
 
-        // hang since failure is not recoverable
-        while(1);
+        // label each bin by its upper bound
+        Serial.print(F(",lt"));
+        if (LATENCY_HIST_BINS - 1 == bin) {
+            Serial.print(F("inf"));
+        }
+        else {
+            Serial.print(1UL << (LATENCY_HIST_SHIFT + bin));
+        }
     }
+    Serial.println();
 
-    // intialize the screen
-    if (false == init_parking_display()) {
+    for (uint8_t node_id = 1; node_id <= SENSOR_NODE_NUM; node_id++) {
 
-        ERROR("Failed to initialize screen. Check hardware")
+        const uint8_t* hist = base_station.get_latency_hist(node_id);
 
-        // hang since failure is not recoverable
-        while(1);
+        Serial.print(node_id);
+        Serial.print(',');
+        Serial.print(base_station.get_latency_max_ms(node_id));
+
+        for (uint8_t bin = 0; bin < LATENCY_HIST_BINS; bin++) {
+            Serial.print(',');
+            Serial.print(hist[bin]);
+        }
+        Serial.println();
     }
+}
 
-    // update screen to show the parking map
-    draw_parking_map();
 
-    INFO("setup complete")
+/**
+ * @brief Prints the time since every sensor node was last heard from
+ */
+static void print_liveness() {
+
+    uint32_t now_ms = millis();
+
+    Serial.print(F("LIVENESS: "));
+    Serial.print(base_station.num_stale());
+    Serial.println(F(" stale"));
+    Serial.println(F("LIVENESS: node,stale,silent_ms"));
+
+    for (uint8_t node_id = 1; node_id <= SENSOR_NODE_NUM; node_id++) {
+
+        Serial.print(node_id);
+        Serial.print(',');
+        Serial.print(base_station.is_node_stale(node_id));
+        Serial.print(',');
+        Serial.println(now_ms - base_station.get_heard_ms(node_id));
+    }
 }
 
 
 /**
- * @brief Main program run loop.
- * 
- * Continuously listens for messages from sensor nodes and updates
- * the parking space status accordingly on a display.
+ * @brief Prints the routes taken by the reports of every sensor node and the load of every relay
  */
-void loop() {
+static void print_routes() {
+
+    Serial.print(F("ROUTES: node"));
+#ifdef ROUTE_HIST_ENABLED
+    for (uint8_t bin = 0; bin < ROUTE_HOP_BINS; bin++) {
+        Serial.print(F(",hops"));
+        Serial.print(bin);
+    }
+    Serial.print(F("+"));
+    for (uint8_t relay_id = 1; relay_id <= ROUTE_RELAY_NUM; relay_id++) {
+        Serial.print(F(",via"));
+        Serial.print(relay_id);
+    }
+#endif // ROUTE_HIST_ENABLED
+    Serial.println(F(",last_path"));
 
-    if(true == base_station.is_message()) {
+    for (uint8_t node_id = 1; node_id <= SENSOR_NODE_NUM; node_id++) {
 
-        uint8_t buffer[MSG_BUFFER_SIZE];
-        memset(buffer, 0, sizeof(buffer));
+        Serial.print(node_id);
 
-        if (false == base_station.read_message((uint8_t**)(&buffer), (uint8_t)sizeof(buffer))) {
-            ERROR("Failed to read message");
+#ifdef ROUTE_HIST_ENABLED
+        const uint8_t* hops = base_station.get_route_hops(node_id);
+        const uint8_t* relays = base_station.get_route_relays(node_id);
+
+        for (uint8_t bin = 0; bin < ROUTE_HOP_BINS; bin++) {
+            Serial.print(',');
+            Serial.print(hops[bin]);
         }
 
-        else {
-            // convert buffer to Message
-            Message msg = Message();
-            memcpy(&msg, buffer, sizeof(msg));
+        for (uint8_t i = 0; i < ROUTE_RELAY_NUM; i++) {
+            Serial.print(',');
+            Serial.print(relays[i]);
+        }
+#endif // ROUTE_HIST_ENABLED
 
-            // verify message is for base station
-            if (base_station.get_id() != msg.get_rx_id()) {
-                WARN("Messaged intended for Node " + msg.get_rx_id() + " not Node " + base_station.get_id());
+        // relays from the node to the base station, ? for one not recorded
+        uint8_t path[PATH_TRACE_MAX];
+        uint8_t path_len = base_station.get_route_last(node_id, path);
+
+        Serial.print(',');
+        for (uint8_t i = 0; i < path_len; i++) {
+            if (0 != i) {
+                Serial.print('>');
+            }
+            if (PATH_RELAY_UNKNOWN == path[i]) {
+                Serial.print('?');
+            }
+            else {
+                Serial.print(path[i]);
             }
+        }
+        Serial.println();
+    }
+
+    Serial.println(F("RELAYS: relay,carried"));
+    for (uint8_t relay_id = 1; relay_id <= ROUTE_RELAY_NUM; relay_id++) {
+        Serial.print(relay_id);
+        Serial.print(',');
+        Serial.println(base_station.get_relay_load(relay_id));
+    }
+}
+
+
+/**
+ * @brief Prints the results of the most recent probe sweep for every link
+ */
+static void print_probe_links() {
+
+    ProbeSweep* sweep = base_station.get_probe_sweep();
+
+    Serial.print(F("LINKS: "));
+    Serial.println((true == sweep->is_active()) ? F("sweep in progress") : F("sweep done"));
+    Serial.println(F("LINKS: node,next,sent,received,route_rtt_avg_us,route_rtt_max_us,route_avg_arc_x100,link_rtt_us,link_delivery_pct"));
 
-            // verify sender has a valid ID
-            else if(false == base_station.is_valid_sensor_node(msg.get_tx_id())) {
-                WARN("Message was from invalid Node " + msg.get_tx_id());
+    for (uint8_t node_id = 1; node_id <= MAP_NODE_MAX; node_id++) {
+        for (uint8_t hop_index = 0; hop_index < INGRESS_HOPS_MAX; hop_index++) {
+
+            const probe_link_t* link = sweep->get_link(node_id, hop_index);
+
+            // node has fewer next nodes
+            if (NULL == link) {
+                continue;
             }
 
-            // react accordingly based on message type
-            else {
+            uint32_t rtt_avg_us = (uint32_t)link->rtt_avg * PROBE_RTT_UNIT_US;
+            uint32_t rtt_max_us = (uint32_t)link->rtt_max * PROBE_RTT_UNIT_US;
+            uint16_t avg_arc = (0 == link->received)
+                ? 0 : (uint16_t)(((uint32_t)link->arc_total * 100) / link->received);
+
+            Serial.print(node_id);
+            Serial.print(',');
+            Serial.print(sweep->get_link_peer(node_id, hop_index));
+            Serial.print(',');
+            Serial.print(link->sent);
+            Serial.print(',');
+            Serial.print(link->received);
+            Serial.print(',');
+            Serial.print(rtt_avg_us);
+            Serial.print(',');
+            Serial.print(rtt_max_us);
+            Serial.print(',');
+            Serial.print(avg_arc);
+            Serial.print(',');
+            Serial.print(sweep->get_link_rtt_us(node_id, hop_index));
+            Serial.print(',');
+            Serial.println(sweep->get_link_delivery_pct(node_id, hop_index));
+        }
+    }
+}
+
+
+/**
+ * @brief Reads the rest of a command line from the serial port
+ *
+ * The characters after the command byte may still be on their way, so
+ * they are waited for until the line ends or the timeout passes.
+ *
+ * @param line: buffer to store the line in without its line ending
+ * @param len: size of the buffer in bytes
+ * @return True if the whole line ended in time and fit. Otherwise false
+ */
+static bool read_serial_line(char* line, uint8_t len) {
+
+    uint8_t size = 0;
+    bool is_overflow = false;
+    uint32_t start_ms = millis();
+
+    while (SERIAL_LINE_TIMEOUT_MS > millis() - start_ms) {
 
-                uint8_t type = msg.get_type();
-                switch(type) {
+        int c = Serial.read();
 
-                    case MESSAGE_UPDATE: {
+        // nothing arrived yet or the carriage return of a CRLF ending
+        if ((0 > c) || ('\r' == c)) {
+            continue;
+        }
+
+        if ('\n' == c) {
+            line[size] = '\0';
+            return (false == is_overflow);
+        }
+
+        // line too long, the rest is read and discarded
+        if (len - 1 <= size) {
+            is_overflow = true;
+            continue;
+        }
+
+        line[size++] = (char)c;
+    }
+
+    return false;
+}
+
+
+/**
+ * @brief Parses the decimal number at a position in a command line, if any
+ *
+ * @param cursor: position in the line, moved past the digits
+ * @param value: the number, or 0 if no digits follow
+ * @return True if the number fits in 16 bits. Otherwise false
+ */
+static bool parse_serial_number(const char** cursor, uint16_t* value) {
+
+    uint32_t number = 0;
+
+    while (('0' <= **cursor) && ('9' >= **cursor)) {
 
-                        INFO("Received UPDATE message from Node " + msg.get_tx_id())
-                        
-                        // convert buffer to UpdateMessage
-                        UpdateMessage update_msg = UpdateMessage();
-                        memcpy(&update_msg, buffer, sizeof(update_msg));
+        number = (number * 10) + (**cursor - '0');
+        (*cursor)++;
+
+        if (0xFFFF < number) {
+            return false;
+        }
+    }
 
-                        uint8_t node_id = update_msg.get_node_id();
-                        bool is_vacant = update_msg.get_is_vacant();
+    *value = (uint16_t)number;
+    return true;
+}
 
-                        // verify node to update has a valid ID
-                        if(false == base_station.is_valid_sensor_node(node_id)) {
-                            WARN("Cannot update status of invalid Node " + node_id);
-                        }
 
-                        // only update if vacancy status changed
-                        else if (is_vacant != base_station.get_node_status(node_id)) {
+/**
+ * @brief Parses the nodes named at a position in a command line
+ *
+ * No number names the whole lot, one number a single node and two numbers
+ * separated by '-' every node in between.
+ *
+ * @param cursor: position in the line, moved past the nodes
+ * @param targets: bitmap where bit N is set if node N was named
+ * @return True if the nodes could be parsed. Otherwise false
+ */
+static bool parse_serial_targets(const char** cursor, uint16_t* targets) {
 
-                            // update the status of the reporting node
-                            (void) base_station.update_node_status(node_id, is_vacant);
-                            
-                            // node status is vacant
-                            if (true == is_vacant) {
-                                INFO("Node " + node_id + " is now vacant")
-                            }
+    uint8_t last_id = (REQUEST_NODE_MAX < SENSOR_NODE_NUM) ? REQUEST_NODE_MAX : SENSOR_NODE_NUM;
+    uint16_t first_id = 0;
 
-                            // node status is occupied
-                            else {
-                                INFO("Node " + node_id + " is now occupied")
-                            }
+    if (false == parse_serial_number(cursor, &first_id)) {
+        return false;
+    }
 
-                            // update the status of the parking space
-                            update_parking_space(node_id, is_vacant);
-                        }
+    // one node or a region
+    if (0 != first_id) {
 
-                        break;
-                    }
+        uint16_t region_last_id = first_id;
+        if ('-' == **cursor) {
+            (*cursor)++;
 
-                    default:
-                        WARN("Unknown message type received")
-                        break;
-                }
+            if (false == parse_serial_number(cursor, &region_last_id)) {
+                return false;
             }
         }
+
+        last_id = (region_last_id < last_id) ? region_last_id : last_id;
     }
 
-    // nothing to do
     else {
-        delay(MAIN_LOOP_DELAY_MS);
+        first_id = 1;
+    }
+
+    *targets = 0;
+    for (uint16_t node_id = first_id; node_id <= last_id; node_id++) {
+        *targets |= (uint16_t)(1U << node_id);
+    }
+
+    return true;
+}
+
+
+/**
+ * @brief Polls the nodes named in the rest of the command line
+ *
+ * The command is followed by the nodes, or nothing for the whole lot.
+ */
+static void request_status() {
+
+    char line[SERIAL_LINE_MAX];
+    const char* cursor = line;
+    uint16_t targets = 0;
+
+    // only a whole line is acted on, so a slow one cannot poll the wrong nodes
+    if ((false == read_serial_line(line, sizeof(line))) || (false == parse_serial_targets(&cursor, &targets))
+        || ('\0' != *cursor)) {
+        ERROR("Expected q[<first>[-<last>]]");
+        return;
+    }
+
+    base_station.request_status(targets);
+}
+
+
+/**
+ * @brief Pushes the timing setting named in the rest of the command line to sensor nodes
+ *
+ * The command is followed by the setting ID, '=' and its value, then
+ * optionally ',' and the nodes as for a status request. Without nodes
+ * the setting goes to the whole lot.
+ */
+static void push_config() {
+
+    char line[SERIAL_LINE_MAX];
+    const char* cursor = line;
+    uint16_t setting = 0;
+    uint16_t value = 0;
+    uint16_t targets = 0;
+
+    // only a whole line is acted on, so a slow one cannot push a cut off value
+    bool is_valid = (true == read_serial_line(line, sizeof(line)))
+        && (true == parse_serial_number(&cursor, &setting)) && ('=' == *cursor);
+
+    if (true == is_valid) {
+        cursor++;
+        is_valid = parse_serial_number(&cursor, &value);
+    }
+
+    if ((true == is_valid) && (',' == *cursor)) {
+        cursor++;
+    }
+
+    if ((false == is_valid) || (false == parse_serial_targets(&cursor, &targets)) || ('\0' != *cursor)) {
+        ERROR("Expected c<setting>=<value>[,<first>[-<last>]]");
+        return;
+    }
+
+    if ((0xFF < setting) || (false == base_station.push_config(targets, (uint8_t)setting, value))) {
+        ERROR("Failed to push setting %u. Unknown, full or for other nodes", setting);
+    }
+}
+
+
+/**
+ * @brief Handles a single character command from the serial port
+ */
+static void handle_serial_command() {
+
+    // no command received
+    if (0 == Serial.available()) {
+        return;
+    }
+
+    char cmd = Serial.read();
+    switch (cmd) {
+
+        case SERIAL_CMD_NODE_STATS:
+            print_node_stats();
+            break;
+
+        case SERIAL_CMD_PROBE_SWEEP:
+            base_station.get_probe_sweep()->start(PROBE_SWEEP_ROUNDS);
+            break;
+
+        case SERIAL_CMD_PROBE_LINKS:
+            print_probe_links();
+            break;
+
+        case SERIAL_CMD_LATENCY:
+            print_latency();
+            break;
+
+        case SERIAL_CMD_LIVENESS:
+            print_liveness();
+            break;
+
+        case SERIAL_CMD_ROUTES:
+            print_routes();
+            break;
+
+        case SERIAL_CMD_STATUS_REQUEST:
+            request_status();
+            break;
+
+        case SERIAL_CMD_CONFIG:
+            push_config();
+            break;
+
+#ifdef PROFILE_ENABLED
+        case SERIAL_CMD_PROFILE_DUMP:
+            profile_dump();
+            break;
+
+        case SERIAL_CMD_PROFILE_RESET:
+            profile_reset();
+            break;
+#endif // PROFILE_ENABLED
+
+        default:
+            break;
     }
 }
+
+
+/**
+ * @brief Initialize all necessary objects and variables.
+ */
+void setup() {
+
+    Serial.begin(SERIAL_BAUD);
+
+    // seed the epoch of this boot from the noise of a floating pin
+    randomSeed(analogRead(RANDOM_SEED_PIN));
+  
+    // initialize the base station
+    if (false == base_station.init()) {
+
+        ERROR("Failed to initialize base station. Check hardware");
+
+        // hang since failure is not recoverable
+        while(1);
+    }
+
+    // intialize the screen
+    if (false == init_parking_display()) {
+
+        ERROR("Failed to initialize screen. Check hardware");
+
+        // hang since failure is not recoverable
+        while(1);
+    }
+
+    // update screen to show the parking map
+    draw_parking_map();
+
+    // show the spaces as the last boot left them
+    for (uint8_t node_id = 1; node_id <= SENSOR_NODE_NUM; node_id++) {
+        if (false == base_station.get_node_status(node_id)) {
+            update_parking_space(node_id, false);
+        }
+    }
+
+    if (true == base_station.is_state_restored()) {
+        INFO("Restored lot state saved by the last boot");
+    }
+
+    telemetry_boot();
+
+    INFO("setup complete");
+}
+
+
+/**
+ * @brief Main program run loop.
+ * 
+ * Continuously listens for messages from sensor nodes and updates
+ * the parking space status accordingly on a display.
+ */
+void loop() {
+
+    handle_serial_command();
+
+    base_station_loop(&base_station, &counters);
+}
+
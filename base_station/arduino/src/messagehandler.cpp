@@ -0,0 +1,226 @@
+/**
+* @brief: Contains the implementation for handling messages received by the base station
+* @file: messagehandler.cpp
+*
+* @author: jkieltyka15
+*/
+
+// standard libraries
+#include <Arduino.h>
+
+// local libraries
+#include <Log.h>
+#include <Message.h>
+#include <Telemetry.h>
+
+// local dependencies
+#include "basestationstate.hpp"
+#include "messagehandler.hpp"
+#include "parkingdisplay.hpp"
+#include "profiling.hpp"
+#include "telemetry.hpp"
+
+
+/**
+ * @brief Restarts a node's liveness window and repaints its space if it was stale
+ * 
+ * @param base_station: base station that heard from the node
+ * @param node_id: ID of the node
+ * @param now_ms: current time in milliseconds
+ */
+static void mark_heard(BaseStationState* base_station, uint8_t node_id, uint32_t now_ms) {
+
+    uint32_t silent_ms = now_ms - base_station->get_heard_ms(node_id);
+
+    if (true == base_station->mark_heard(node_id, now_ms)) {
+
+        INFO("Node %u is alive again", node_id);
+
+        update_parking_space(node_id, base_station->get_node_status(node_id));
+        telemetry_liveness(node_id, false, silent_ms);
+    }
+}
+
+
+void handle_message(BaseStationState* base_station, const uint8_t* buffer, telemetry_counters_t* counters) {
+
+    // convert buffer to Message
+    Message msg = Message();
+    memcpy(&msg, buffer, sizeof(msg));
+
+    counters->rx_messages++;
+
+    // verify message is for base station
+    if (base_station->get_id() != msg.get_rx_id()) {
+        counters->rx_rejected++;
+        WARN("Messaged intended for Node %u not Node %u", msg.get_rx_id(), base_station->get_id());
+    }
+
+    // verify sender has a valid ID
+    else if(false == base_station->is_valid_sensor_node(msg.get_tx_id())) {
+        counters->rx_rejected++;
+        WARN("Message was from invalid Node %u", msg.get_tx_id());
+    }
+
+    // react accordingly based on message type
+    else {
+
+        uint8_t type = msg.get_type();
+        switch(type) {
+
+            case MESSAGE_STATS: {
+
+                INFO("Received STATS message from Node %u", msg.get_tx_id());
+
+                // convert buffer to StatsMessage
+                StatsMessage stats_msg = StatsMessage();
+                memcpy(&stats_msg, buffer, sizeof(stats_msg));
+
+                uint8_t node_id = stats_msg.get_node_id();
+                node_stats_t stats;
+                stats_msg.get_stats(&stats);
+
+                // record statistics of the reporting node
+                if (true == base_station->update_node_stats(node_id, &stats)) {
+                    telemetry_node_stats(node_id, &stats);
+                }
+            }
+                // a stats message is also a heartbeat carrying the node's status
+                // fall through
+
+            case MESSAGE_UPDATE: {
+
+                // stats messages were already logged
+                if (MESSAGE_UPDATE == type) {
+                    INFO("Received UPDATE message from Node %u", msg.get_tx_id());
+                }
+
+                // convert buffer to UpdateMessage
+                UpdateMessage update_msg = UpdateMessage();
+                memcpy(&update_msg, buffer, sizeof(update_msg));
+
+                uint8_t node_id = update_msg.get_node_id();
+                bool is_vacant = update_msg.get_is_vacant();
+
+                // any report shows its origin, its relays and the nodes they heard from are alive
+                uint32_t now_ms = millis();
+                mark_heard(base_station, msg.get_tx_id(), now_ms);
+                mark_heard(base_station, node_id, now_ms);
+
+                // status requests reach these nodes the way the report came
+                base_station->get_egress()->learn(node_id, msg.get_tx_id());
+
+                for (uint8_t alive_id = 1; alive_id <= ALIVE_NODE_MAX; alive_id++) {
+                    if (true == update_msg.is_alive(alive_id)) {
+                        mark_heard(base_station, alive_id, now_ms);
+                        base_station->get_egress()->learn(alive_id, msg.get_tx_id());
+                    }
+                }
+
+                // any update is newer than the status a resync round holds
+                base_station->mark_resynced(node_id);
+
+                // which relays carried the report and how far it came
+                (void) base_station->record_route(&update_msg);
+
+                // verify node to update has a valid ID
+                if(false == base_station->is_valid_sensor_node(node_id)) {
+                    WARN("Cannot update status of invalid Node %u", node_id);
+                }
+
+                // only update if vacancy status changed
+                else if (is_vacant != base_station->get_node_status(node_id)) {
+
+                    // update the status of the reporting node
+                    (void) base_station->update_node_status(node_id, is_vacant);
+                    counters->state_changes++;
+                    
+                    // node status is vacant
+                    if (true == is_vacant) {
+                        INFO("Node %u is now vacant", node_id);
+                    }
+
+                    // node status is occupied
+                    else {
+                        INFO("Node %u is now occupied", node_id);
+                    }
+
+                    // update the status of the parking space
+                    PROFILE_START(paint_start_us);
+                    update_parking_space(node_id, is_vacant);
+                    PROFILE_STOP(PHASE_DISPLAY_PAINT, paint_start_us);
+
+                    // age of the change plus the time since the message could have arrived
+                    uint32_t latency_ms = update_msg.get_age_ms() + (millis() - base_station->get_rx_idle_ms());
+                    (void) base_station->record_latency(node_id, latency_ms);
+                    telemetry_state_change(node_id, is_vacant, latency_ms, update_msg.get_hops());
+                }
+
+                break;
+            }
+
+            case MESSAGE_RESYNC: {
+
+                INFO("Received RESYNC message from Node %u", msg.get_tx_id());
+
+                // convert buffer to ResyncMessage
+                ResyncMessage resync_msg = ResyncMessage();
+                memcpy(&resync_msg, buffer, sizeof(resync_msg));
+
+                // statuses held for an earlier boot of the base station
+                if (base_station->get_epoch() != resync_msg.get_epoch()) {
+                    WARN("RESYNC is for epoch %u not %u", resync_msg.get_epoch(), base_station->get_epoch());
+                    break;
+                }
+
+                uint32_t now_ms = millis();
+                mark_heard(base_station, msg.get_tx_id(), now_ms);
+
+                for (uint8_t node_id = 1; node_id <= RESYNC_NODE_MAX; node_id++) {
+
+                    if (0 == (resync_msg.get_reported() & (1U << node_id))) {
+                        continue;
+                    }
+
+                    // a reported node is alive and reached the way its status came
+                    mark_heard(base_station, node_id, now_ms);
+                    base_station->get_egress()->learn(node_id, msg.get_tx_id());
+
+                    bool is_vacant = (0 != (resync_msg.get_vacant() & (1U << node_id)));
+
+                    // the time of the change is unknown so no latency is recorded
+                    if (true == base_station->apply_resync(node_id, is_vacant)) {
+
+                        counters->state_changes++;
+                        INFO("Node %u is %s after resync", node_id, (true == is_vacant) ? "vacant" : "occupied");
+
+                        update_parking_space(node_id, is_vacant);
+                    }
+                }
+
+                break;
+            }
+
+            case MESSAGE_PONG: {
+
+                INFO("Received PONG message from Node %u", msg.get_tx_id());
+
+                // convert buffer to PingMessage
+                PingMessage pong_msg = PingMessage();
+                memcpy(&pong_msg, buffer, sizeof(pong_msg));
+
+                // time the round trip of the probe
+                if (false == base_station->get_probe_sweep()->handle_pong(&pong_msg, micros())) {
+                    WARN("PONG %u does not answer the probe in flight", pong_msg.get_seq());
+                }
+
+                break;
+            }
+
+            default:
+                counters->rx_unknown++;
+                WARN("Unknown message type received");
+                break;
+        }
+    }
+}
@@ -1,6 +1,6 @@
 /**
-* @brief: Contains the prototypes for the GUI
-* @file: parkingdisplay.hpp
+* @brief: Contains the implementation of the GUI
+* @file: parkingdisplay.cpp
 *
 * @author: jkieltyka15
 */
@@ -9,6 +9,9 @@
 #include <Arduino.h>
 #include <TVout.h>
 
+// local dependencies
+#include "parkingdisplay.hpp"
+
 
 #define SCREEN_REGION NTSC // region of the display
 #define SCREEN_W      64   // width in pixels of the display
@@ -17,9 +20,13 @@
 // thickness of all lines drawn
 #define LINE_PIXEL_THICKNESS 2
 
-#define NUM_OF_CARS 10  // max number of cars that can be parked
-#define CAR_PIXEL_W 6   // width of car icon in pixels
-#define CAR_PIXEL_H 5   // height of car icon in pixels
+// rows at the bottom of the screen showing the page of a paged grid
+#define PAGE_BAR_H 1
+
+// state of each tile
+#define TILE_OCCUPIED 0x01  // a car is parked in the space
+#define TILE_STALE    0x02  // the space's sensor has gone silent
+#define TILE_DIRTY    0x80  // the tile differs from what is on the screen
 
 
 // 2D coordinate
@@ -28,7 +35,35 @@ struct position_t {
     uint8_t y;
 };
 
-position_t space_locations[NUM_OF_CARS] = {
+// filled rectangle of a hand drawn layout
+struct wall_t {
+    uint8_t x;
+    uint8_t y;
+    uint8_t width;
+    uint8_t height;
+};
+
+// hand drawn layout of a lot of a particular size
+struct lot_layout_t {
+    uint8_t num_spaces;         // spaces of the lot
+    const position_t* spaces;   // upper left corner of the car in each space
+    uint8_t num_walls;          // walls and separators of the lot
+    const wall_t* walls;        // walls and separators
+    uint8_t car_w;              // width of a car in pixels
+    uint8_t car_h;              // height of a car in pixels
+};
+
+// size of the tiles of a generated grid
+struct tile_size_t {
+    uint8_t car_w;      // width of a car in pixels
+    uint8_t car_h;      // height of a car in pixels
+    uint8_t pitch_w;    // horizontal distance between tiles in pixels
+    uint8_t pitch_h;    // vertical distance between tiles in pixels
+};
+
+
+// the parking lot of the original ten spaces
+static const position_t lot10_spaces[] = {
     {4, 15},    // parking space 1
     {4, 4},     // parking space 2
     {21, 17},   // parking space 3
@@ -41,20 +76,69 @@ position_t space_locations[NUM_OF_CARS] = {
     {50, 15}    // parking space 10
 };
 
+static const wall_t lot10_walls[] = {
+    {0, 0, LINE_PIXEL_THICKNESS, 24},   // left boarder
+    {2, 0, 56, LINE_PIXEL_THICKNESS},   // top boarder
+    {58, 0, LINE_PIXEL_THICKNESS, 24},  // right boarder
+    {0, 46, 60, LINE_PIXEL_THICKNESS},  // bottom boarder
+    {2, 11, 8, LINE_PIXEL_THICKNESS},   // top left
+    {2, 22, 8, LINE_PIXEL_THICKNESS},   // bottom left
+    {50, 11, 8, LINE_PIXEL_THICKNESS},  // top right
+    {50, 22, 8, LINE_PIXEL_THICKNESS},  // bottom right
+    {21, 13, 18, LINE_PIXEL_THICKNESS}, // top middle
+    {21, 24, 18, LINE_PIXEL_THICKNESS}, // middle middle
+    {21, 35, 18, LINE_PIXEL_THICKNESS}, // bottom middle
+    {29, 15, LINE_PIXEL_THICKNESS, 31}  // middle vertical divider
+};
+
+// lots with a hand drawn layout. Any other size gets a generated grid
+static const lot_layout_t lot_layouts[] = {
+    {10, lot10_spaces, sizeof(lot10_walls) / sizeof(wall_t), lot10_walls, 6, 5}
+};
+
+// tile sizes of a generated grid from largest to smallest. Lots that do not
+// fit the smallest on one screen are shown a page at a time
+static const tile_size_t tile_sizes[] = {
+    {6, 5, 8, 7},   // 8 x 6 spaces
+    {4, 3, 5, 4},   // 12 x 12 spaces
+    {3, 3, 4, 4}    // 16 x 12 spaces, or 16 x 11 a page
+};
+
 
 // screen for displaying parking space status
 TVout screen = TVout();
 
+// hand drawn layout of the lot, or NULL for a generated grid
+static const lot_layout_t* layout = NULL;
+
+// geometry of the tiles
+static uint8_t car_w = 0;
+static uint8_t car_h = 0;
+static uint8_t pitch_w = 0;
+static uint8_t pitch_h = 0;
+static uint8_t grid_cols = 0;
+static uint8_t grid_x = 0;
+static uint8_t grid_y = 0;
+
+// spaces shown at once and the page on the screen
+static uint8_t page_spaces = SENSOR_NODE_NUM;
+static uint8_t num_pages = 1;
+static uint8_t page = 0;
+static uint32_t page_shown_ms = 0;
+
+// state of the tile of each space
+static uint8_t tiles[SENSOR_NODE_NUM] = {0};
+
 
 /**
  * @brief Draws a black or white rectangle line by line.
- * 
+ *
  * @param color: color of rectangle which must be either BLACK or WHITE
  * @param x: horizontal position of upper left corner of rectangle on screen
  * @param y: vertical position of upper left corner of rectangle on screen
  * @param width: width of rectangle in pixels
  * @param height: height of rectangle in pixels
- * 
+ *
  * @note value of color is not checked, nor is a valid screen position nor rectangle
  *      being drawn off the screen
  */
@@ -70,19 +154,135 @@ static void draw_rectangle(uint8_t color, uint8_t x, uint8_t y, uint8_t width, u
 
 
 /**
- * @brief Draws a black or white rectangle line by line.
- * 
- * @param color: color of rectangle which must be either BLACK or WHITE
- * @param position: position of upper left corner of rectangle on screen
- * @param width: width of rectangle in pixels
- * @param height: height of rectangle in pixels
- * 
- * @note value of color is not checked, nor is a valid screen position nor rectangle
- *      being drawn off the screen
+ * @brief Finds where the car of a space is drawn
+ *
+ * @param space_id: ID of parking space
+ * @param position: where to store the upper left corner of the car
+ * @return True if the space is on the page being shown. Otherwise false
+ */
+static bool get_tile_position(uint8_t space_id, position_t* position) {
+
+    if (NULL != layout) {
+        *position = layout->spaces[space_id - 1];
+        return true;
+    }
+
+    uint8_t index = space_id - 1;
+
+    // space is on another page
+    if ((index / page_spaces) != page) {
+        return false;
+    }
+
+    index %= page_spaces;
+    position->x = grid_x + ((index % grid_cols) * pitch_w);
+    position->y = grid_y + ((index / grid_cols) * pitch_h);
+
+    return true;
+}
+
+
+/**
+ * @brief Draws the tile of a space if it is shown and has changed
+ *
+ * @param space_id: ID of parking space
+ */
+static void draw_tile(uint8_t space_id) {
+
+    uint8_t* tile = &tiles[space_id - 1];
+    position_t position;
+
+    // tile is as shown or not shown at all
+    if ((0 == (*tile & TILE_DIRTY)) || (false == get_tile_position(space_id, &position))) {
+        return;
+    }
+
+    *tile &= ~TILE_DIRTY;
+
+    // outline of a car, hollow so it differs from both an occupied and a vacant space
+    if (0 != (*tile & TILE_STALE)) {
+        draw_rectangle(WHITE, position.x, position.y, car_w, car_h);
+        draw_rectangle(BLACK, position.x + 1, position.y + 1, car_w - 2, car_h - 2);
+    }
+
+    // draw or erase car
+    else {
+        draw_rectangle((0 != (*tile & TILE_OCCUPIED)) ? WHITE : BLACK, position.x, position.y, car_w, car_h);
+    }
+}
+
+
+/**
+ * @brief Sets the state of a tile and draws it if it changed
+ *
+ * @param space_id: ID of parking space
+ * @param state: TILE_OCCUPIED and TILE_STALE bits of the new state
  */
-static void draw_rectangle(uint8_t color, position_t position, uint8_t width, uint8_t height) {
+static void set_tile(uint8_t space_id, uint8_t state) {
+
+    // check to ensure space ID is valid
+    if ((0 == space_id) || (space_id > SENSOR_NODE_NUM)) {
+        return;
+    }
+
+    uint8_t* tile = &tiles[space_id - 1];
+
+    if ((*tile & ~TILE_DIRTY) != state) {
+        *tile = state | TILE_DIRTY;
+    }
+
+    draw_tile(space_id);
+}
+
+
+/**
+ * @brief Picks the layout of the lot and the size of its tiles
+ */
+static void select_layout() {
+
+    // a hand drawn layout of the lot's size is used as is
+    for (uint8_t i = 0; i < sizeof(lot_layouts) / sizeof(lot_layout_t); i++) {
+        if (SENSOR_NODE_NUM == lot_layouts[i].num_spaces) {
+            layout = &lot_layouts[i];
+            car_w = layout->car_w;
+            car_h = layout->car_h;
+            return;
+        }
+    }
+
+    // the largest tiles that fit the whole lot, otherwise the smallest a page at a time
+    uint8_t num_sizes = sizeof(tile_sizes) / sizeof(tile_size_t);
+    const tile_size_t* size = &tile_sizes[num_sizes - 1];
+
+    for (uint8_t i = 0; i < num_sizes; i++) {
+        if (SENSOR_NODE_NUM <= (SCREEN_W / tile_sizes[i].pitch_w) * (SCREEN_H / tile_sizes[i].pitch_h)) {
+            size = &tile_sizes[i];
+            break;
+        }
+    }
+
+    car_w = size->car_w;
+    car_h = size->car_h;
+    pitch_w = size->pitch_w;
+    pitch_h = size->pitch_h;
+    grid_cols = SCREEN_W / pitch_w;
 
-    draw_rectangle(color, position.x, position.y, width, height);
+    uint8_t grid_rows = SCREEN_H / pitch_h;
+    uint16_t screen_spaces = (uint16_t)grid_cols * grid_rows;
+
+    // a page gives up the bottom rows to show which page it is
+    if (SENSOR_NODE_NUM > screen_spaces) {
+        grid_rows = (SCREEN_H - PAGE_BAR_H) / pitch_h;
+        page_spaces = grid_cols * grid_rows;
+        num_pages = (SENSOR_NODE_NUM + page_spaces - 1) / page_spaces;
+    }
+
+    // only as many rows as the spaces need, centred on the screen
+    uint8_t used_rows = (page_spaces + grid_cols - 1) / grid_cols;
+    uint8_t used_cols = (page_spaces < grid_cols) ? page_spaces : grid_cols;
+
+    grid_x = (SCREEN_W - (used_cols * pitch_w) + (pitch_w - car_w)) / 2;
+    grid_y = (((1 < num_pages) ? SCREEN_H - PAGE_BAR_H : SCREEN_H) - (used_rows * pitch_h) + (pitch_h - car_h)) / 2;
 }
 
 
@@ -96,40 +296,66 @@ bool init_parking_display() {
     // clear the screen
     screen.clear_screen();
 
+    select_layout();
+
     return true;
 }
 
 
 void draw_parking_map() {
 
-    // draw boarders
-    draw_rectangle(WHITE, 0, 0, LINE_PIXEL_THICKNESS, 24);  // left boarder
-    draw_rectangle(WHITE, 2, 0, 56, LINE_PIXEL_THICKNESS);  // top boarder
-    draw_rectangle(WHITE, 58, 0, LINE_PIXEL_THICKNESS, 24); // right boarder
-    draw_rectangle(WHITE, 0, 46, 60, LINE_PIXEL_THICKNESS); // bottom boarder
-
-    // draw parking space seperators
-    draw_rectangle(WHITE, 2, 11, 8, LINE_PIXEL_THICKNESS);      // top left
-    draw_rectangle(WHITE, 2, 22, 8, LINE_PIXEL_THICKNESS);      // bottom left
-    draw_rectangle(WHITE, 50, 11, 8, LINE_PIXEL_THICKNESS);     // top right
-    draw_rectangle(WHITE, 50, 22, 8, LINE_PIXEL_THICKNESS);     // bottom left
-    draw_rectangle(WHITE, 21, 13, 18, LINE_PIXEL_THICKNESS);    // top middle
-    draw_rectangle(WHITE, 21, 24, 18, LINE_PIXEL_THICKNESS);    // middle middle
-    draw_rectangle(WHITE, 21, 35, 18, LINE_PIXEL_THICKNESS);    // bottom middle
-    draw_rectangle(WHITE, 29, 15, LINE_PIXEL_THICKNESS, 31);    // middle vertical divider
+    // draw walls of a hand drawn layout
+    if (NULL != layout) {
+        for (uint8_t i = 0; i < layout->num_walls; i++) {
+            const wall_t* wall = &layout->walls[i];
+            draw_rectangle(WHITE, wall->x, wall->y, wall->width, wall->height);
+        }
+    }
+
+    // mark the page being shown
+    if (1 < num_pages) {
+        uint8_t bar_w = SCREEN_W / num_pages;
+        draw_rectangle(BLACK, 0, SCREEN_H - PAGE_BAR_H, SCREEN_W, PAGE_BAR_H);
+        draw_rectangle(WHITE, page * bar_w, SCREEN_H - PAGE_BAR_H, bar_w, PAGE_BAR_H);
+    }
+
+    // every tile of the page, since the screen may not show any of them
+    for (uint8_t space_id = 1; space_id <= SENSOR_NODE_NUM; space_id++) {
+        tiles[space_id - 1] |= TILE_DIRTY;
+        draw_tile(space_id);
+    }
 }
 
 
 void update_parking_space(uint8_t space_id, bool is_vacant) {
 
+    set_tile(space_id, (true == is_vacant) ? 0 : TILE_OCCUPIED);
+}
+
+
+void draw_stale_parking_space(uint8_t space_id) {
+
     // check to ensure space ID is valid
-    if ((0 == space_id) || ((space_id - 1) > NUM_OF_CARS)) {
+    if ((0 == space_id) || (space_id > SENSOR_NODE_NUM)) {
         return;
     }
 
-    // determine if car should be drawn or erased
-    uint8_t color = (true == is_vacant) ? BLACK : WHITE;
+    // whether a car is parked is kept for when the space is heard from again
+    set_tile(space_id, (tiles[space_id - 1] & TILE_OCCUPIED) | TILE_STALE);
+}
 
-    // draw or erase car
-    draw_rectangle(color, space_locations[space_id - 1], CAR_PIXEL_W, CAR_PIXEL_H);
+
+void tick_parking_display(uint32_t now_ms) {
+
+    // whole lot fits on the screen or the page has not been shown long enough
+    if ((1 >= num_pages) || (DISPLAY_PAGE_MS > (now_ms - page_shown_ms))) {
+        return;
+    }
+
+    page_shown_ms = now_ms;
+    page = (page + 1) % num_pages;
+
+    // tiles of the old page are cleared rather than each drawn over
+    draw_rectangle(BLACK, 0, 0, SCREEN_W, SCREEN_H - PAGE_BAR_H);
+    draw_parking_map();
 }
@@ -0,0 +1,263 @@
+/**
+* @brief: Contains the implementation of the ProbeSweep class.
+* @file: probesweep.cpp
+*
+* @author: jkieltyka15
+*/
+
+// standard libraries
+#include <Arduino.h>
+
+// local libraries
+#include <Message.h>
+#include <parkingmap.hpp>
+
+// local dependencies
+#include "probesweep.hpp"
+
+#define BASE_STATION_ID 0   // ID of base station
+
+
+uint8_t ProbeSweep::build_route(uint8_t node_id, uint8_t hop_index, uint8_t* route) {
+
+    uint8_t hops[INGRESS_HOPS_MAX];
+    if (hop_index >= get_ingress_hops(node_id, hops)) {
+        return 0;
+    }
+
+    // follow preferred next nodes from the next node to the base station
+    uint8_t path[PING_ROUTE_MAX];
+    uint8_t len = 0;
+    uint8_t id = hops[hop_index];
+
+    while (BASE_STATION_ID != id) {
+
+        // route would not fit in a message
+        if (PING_ROUTE_MAX - 1 <= len) {
+            return 0;
+        }
+
+        path[len++] = id;
+
+        uint8_t next_hops[INGRESS_HOPS_MAX];
+        if (0 == get_ingress_hops(id, next_hops)) {
+            return 0;
+        }
+
+        id = next_hops[0];
+    }
+
+    // route runs from the base station outwards and ends with the node
+    for (uint8_t i = 0; i < len; i++) {
+        route[i] = path[len - 1 - i];
+    }
+    route[len] = node_id;
+
+    return len + 1;
+}
+
+
+uint32_t ProbeSweep::get_avg_rtt_us(const probe_link_t* link) {
+
+    return (uint32_t)link->rtt_avg * PROBE_RTT_UNIT_US;
+}
+
+
+void ProbeSweep::start(uint8_t rounds) {
+
+    memset(this->links, 0, sizeof(this->links));
+
+    this->rounds_left = rounds;
+    this->next_node_id = 1;
+    this->next_hop_index = 0;
+    this->in_flight = NULL;
+}
+
+
+bool ProbeSweep::is_active() {
+
+    return (0 < this->rounds_left) || (NULL != this->in_flight);
+}
+
+
+bool ProbeSweep::is_waiting() {
+
+    return NULL != this->in_flight;
+}
+
+
+bool ProbeSweep::next_probe(uint32_t now_us, PingMessage* msg) {
+
+    // previous probe is still within its timeout
+    if (NULL != this->in_flight) {
+
+        if (PROBE_TIMEOUT_US > now_us - this->sent_us) {
+            return false;
+        }
+
+        // PONG never came back
+        this->in_flight = NULL;
+    }
+
+    // find the next link of the map
+    uint8_t route[PING_ROUTE_MAX];
+    uint8_t len = 0;
+    uint8_t node_id = 0;
+    uint8_t hop_index = 0;
+
+    while (0 == len) {
+
+        // sweep is over
+        if (0 == this->rounds_left) {
+            return false;
+        }
+
+        node_id = this->next_node_id;
+        hop_index = this->next_hop_index;
+        len = this->build_route(node_id, hop_index, route);
+
+        // step to the following link, starting the next round after the last node
+        if (INGRESS_HOPS_MAX <= ++this->next_hop_index) {
+            this->next_hop_index = 0;
+            this->next_node_id++;
+        }
+
+        if (MAP_NODE_MAX < this->next_node_id) {
+            this->next_node_id = 1;
+            this->rounds_left--;
+        }
+    }
+
+    // probe is addressed to the first node of the route
+    *msg = PingMessage(route[0], BASE_STATION_ID, MESSAGE_PING, ++this->seq, route, len, 1, now_us, 0);
+
+    this->in_flight = &this->links[node_id - 1][hop_index];
+    this->in_flight->sent++;
+    this->sent_us = now_us;
+    this->sent_arc = 0;
+
+    return true;
+}
+
+
+void ProbeSweep::probe_sent(bool is_sent, uint8_t arc) {
+
+    if (NULL == this->in_flight) {
+        return;
+    }
+
+    // first node never acknowledged the PING so no PONG will come
+    if (false == is_sent) {
+        this->in_flight = NULL;
+        return;
+    }
+
+    this->sent_arc = arc;
+}
+
+
+bool ProbeSweep::handle_pong(PingMessage* msg, uint32_t now_us) {
+
+    // late answer to a probe that already timed out
+    if ((NULL == this->in_flight) || (this->seq != msg->get_seq())) {
+        return false;
+    }
+
+    probe_link_t* link = this->in_flight;
+
+    // a PONG within the timeout fits, a later one is counted at the longest time
+    uint32_t rtt = (now_us - msg->get_send_us()) / PROBE_RTT_UNIT_US;
+    rtt = (0xFFFF < rtt) ? 0xFFFF : rtt;
+
+    // only the running mean is kept rather than the sum of every round
+    link->received++;
+    link->rtt_avg = (uint16_t)((((uint32_t)link->rtt_avg * (link->received - 1)) + rtt) / link->received);
+    link->arc_total += this->sent_arc + msg->get_arc();
+
+    if (rtt > link->rtt_max) {
+        link->rtt_max = (uint16_t)rtt;
+    }
+
+    this->in_flight = NULL;
+
+    return true;
+}
+
+
+const probe_link_t* ProbeSweep::get_link(uint8_t node_id, uint8_t hop_index) {
+
+    if (0 > this->get_link_peer(node_id, hop_index)) {
+        return NULL;
+    }
+
+    return &this->links[node_id - 1][hop_index];
+}
+
+
+int16_t ProbeSweep::get_link_peer(uint8_t node_id, uint8_t hop_index) {
+
+    // node is not on the map
+    if ((0 == node_id) || (MAP_NODE_MAX < node_id)) {
+        return -1;
+    }
+
+    uint8_t hops[INGRESS_HOPS_MAX];
+    if (hop_index >= get_ingress_hops(node_id, hops)) {
+        return -1;
+    }
+
+    return hops[hop_index];
+}
+
+
+uint32_t ProbeSweep::get_link_rtt_us(uint8_t node_id, uint8_t hop_index) {
+
+    const probe_link_t* link = this->get_link(node_id, hop_index);
+    if ((NULL == link) || (0 == link->received)) {
+        return 0;
+    }
+
+    uint32_t rtt_us = this->get_avg_rtt_us(link);
+
+    // links to the base station are the whole route
+    int16_t peer_id = this->get_link_peer(node_id, hop_index);
+    if (BASE_STATION_ID == peer_id) {
+        return rtt_us;
+    }
+
+    // take off the route to the next node
+    uint32_t prefix_rtt_us = this->get_avg_rtt_us(&this->links[peer_id - 1][0]);
+    if (0 == prefix_rtt_us) {
+        return 0;
+    }
+
+    return (rtt_us > prefix_rtt_us) ? rtt_us - prefix_rtt_us : 0;
+}
+
+
+uint8_t ProbeSweep::get_link_delivery_pct(uint8_t node_id, uint8_t hop_index) {
+
+    const probe_link_t* link = this->get_link(node_id, hop_index);
+    if ((NULL == link) || (0 == link->sent)) {
+        return 0;
+    }
+
+    uint32_t delivery_pct = ((uint32_t)link->received * 100) / link->sent;
+
+    // links to the base station are the whole route
+    int16_t peer_id = this->get_link_peer(node_id, hop_index);
+    if (BASE_STATION_ID == peer_id) {
+        return (uint8_t)delivery_pct;
+    }
+
+    // take off the losses of the route to the next node
+    const probe_link_t* prefix = &this->links[peer_id - 1][0];
+    if (0 == prefix->received) {
+        return 0;
+    }
+
+    uint32_t prefix_pct = ((uint32_t)prefix->received * 100) / prefix->sent;
+    delivery_pct = (delivery_pct * 100) / prefix_pct;
+
+    return (100 < delivery_pct) ? 100 : (uint8_t)delivery_pct;
+}
@@ -0,0 +1,71 @@
+/**
+* @brief: Contains the implementation for profiling the base station hot path
+* @file: profiling.cpp
+*
+* @author: jkieltyka15
+*/
+
+#ifdef PROFILE_ENABLED
+
+// standard libraries
+#include <Arduino.h>
+
+// local libraries
+#include <Profile.h>
+
+// local dependencies
+#include "profiling.hpp"
+
+
+// timing of each phase
+static profile_phase_t phases[PHASE_NUM];
+
+// value of each counter
+static uint32_t counters[COUNTER_NUM];
+
+// time profiling was last reset
+static uint32_t reset_ms = 0;
+
+
+void profile_record(profile_phase_id_t phase, uint32_t elapsed_us) {
+
+    // first use so start from a clean state
+    if (0 == reset_ms) {
+        profile_reset();
+    }
+
+    profile_phase_record(&phases[phase], elapsed_us);
+}
+
+
+void profile_count(profile_counter_id_t counter, uint16_t amount) {
+
+    counters[counter] += amount;
+}
+
+
+void profile_reset() {
+
+    for (uint8_t i = 0; i < PHASE_NUM; i++) {
+        profile_phase_reset(&phases[i]);
+    }
+
+    memset(counters, 0, sizeof(counters));
+    reset_ms = millis() | 1;
+}
+
+
+void profile_dump() {
+
+    Serial.print(F("PROFILE: window_ms="));
+    Serial.println(millis() - reset_ms);
+
+    profile_phase_print(F("message"), &phases[PHASE_MESSAGE]);
+    profile_phase_print(F("display_paint"), &phases[PHASE_DISPLAY_PAINT]);
+    profile_phase_print(F("loop_delay"), &phases[PHASE_LOOP_DELAY]);
+
+    profile_counter_print(F("rx_messages"), counters[COUNTER_RX_MESSAGES]);
+    profile_counter_print(F("rx_fifo_full"), counters[COUNTER_RX_FIFO_FULL]);
+}
+
+#endif // PROFILE_ENABLED
@@ -0,0 +1,157 @@
+/**
+* @brief: Contains the implementation of the binary telemetry stream
+* @file: telemetry.cpp
+*
+* @author: jkieltyka15
+*/
+
+#ifdef TELEMETRY_ENABLED
+
+// standard libraries
+#include <Arduino.h>
+
+// local libraries
+#include <Telemetry.h>
+
+// local dependencies
+#include "basestationstate.hpp"
+#include "telemetry.hpp"
+
+
+// sequence number of the next frame
+static uint8_t frame_seq = 0;
+
+// number of frames dropped since the serial transmit buffer was full
+static uint16_t frames_dropped = 0;
+
+// time the last periodic frames were sent
+static uint32_t last_period_ms = 0;
+
+
+/**
+ * @brief Queues an encoded frame on the serial port without blocking
+ *
+ * @param frame: frame to send
+ *
+ * @note frames that do not fit in the serial transmit buffer are dropped
+ *      and counted instead of stalling the main loop
+ */
+static void send_frame(TelemetryFrame* frame) {
+
+    uint8_t buffer[TELEMETRY_ENCODED_MAX];
+    uint8_t size = frame->encode(buffer);
+
+    // not enough room to send without blocking
+    if (size > Serial.availableForWrite()) {
+        frames_dropped++;
+        return;
+    }
+
+    Serial.write(buffer, size);
+}
+
+
+void telemetry_boot() {
+
+    TelemetryFrame frame = TelemetryFrame(TELEMETRY_BOOT, frame_seq++, millis());
+    (void) frame.put_u8(SENSOR_NODE_NUM);
+
+    send_frame(&frame);
+}
+
+
+void telemetry_state_change(uint8_t node_id, bool is_vacant, uint32_t latency_ms, uint8_t hops) {
+
+    TelemetryFrame frame = TelemetryFrame(TELEMETRY_STATE_CHANGE, frame_seq++, millis());
+    (void) frame.put_u8(node_id);
+    (void) frame.put_u8(is_vacant);
+    (void) frame.put_u16((0xFFFF < latency_ms) ? 0xFFFF : (uint16_t)latency_ms);
+    (void) frame.put_u8(hops);
+
+    send_frame(&frame);
+}
+
+
+void telemetry_node_stats(uint8_t node_id, const node_stats_t* stats) {
+
+    TelemetryFrame frame = TelemetryFrame(TELEMETRY_NODE_STATS, frame_seq++, millis());
+    (void) frame.put_u8(node_id);
+    (void) frame.put_u16(stats->tx_attempts);
+    (void) frame.put_u16(stats->tx_failures);
+    (void) frame.put_u16(stats->arc_total);
+    (void) frame.put_u16(stats->carrier_busy);
+    (void) frame.put_u16(stats->relayed);
+    (void) frame.put_u16(stats->free_ram);
+    (void) frame.put_u8(stats->queue_high_water);
+
+    send_frame(&frame);
+}
+
+
+void telemetry_liveness(uint8_t node_id, bool is_stale, uint32_t silent_ms) {
+
+    TelemetryFrame frame = TelemetryFrame(TELEMETRY_LIVENESS, frame_seq++, millis());
+    (void) frame.put_u8(node_id);
+    (void) frame.put_u8(is_stale);
+    (void) frame.put_u32(silent_ms);
+
+    send_frame(&frame);
+}
+
+
+#ifdef CAPTURE_ENABLED
+void telemetry_capture(const uint8_t* buffer, uint8_t size) {
+
+    TelemetryFrame frame = TelemetryFrame(TELEMETRY_CAPTURE, frame_seq++, millis());
+    (void) frame.put_u32(micros());
+    (void) frame.put_bytes(buffer, size);
+
+    send_frame(&frame);
+}
+#endif // CAPTURE_ENABLED
+
+
+void telemetry_tick(BaseStationState* base_station, telemetry_counters_t* counters) {
+
+    uint32_t now = millis();
+
+    // period has not elapsed
+    if (TELEMETRY_PERIOD_MS > (now - last_period_ms)) {
+        return;
+    }
+
+    last_period_ms = now;
+    counters->frames_dropped = frames_dropped;
+
+    // report counters
+    TelemetryFrame counter_frame = TelemetryFrame(TELEMETRY_COUNTERS, frame_seq++, now);
+    (void) counter_frame.put_u16(counters->rx_messages);
+    (void) counter_frame.put_u16(counters->rx_rejected);
+    (void) counter_frame.put_u16(counters->rx_unknown);
+    (void) counter_frame.put_u16(counters->state_changes);
+    (void) counter_frame.put_u16(counters->frames_dropped);
+    (void) counter_frame.put_u16(counters->stale_events);
+
+    send_frame(&counter_frame);
+
+    // pack vacancy status of every node into a bitmap
+    uint8_t bitmap[(SENSOR_NODE_NUM + 7) / 8];
+    memset(bitmap, 0, sizeof(bitmap));
+
+    for (uint8_t node_id = 1; node_id <= SENSOR_NODE_NUM; node_id++) {
+        if (true == base_station->get_node_status(node_id)) {
+            bitmap[(node_id - 1) / 8] |= 1 << ((node_id - 1) % 8);
+        }
+    }
+
+    // report snapshot of the lot
+    TelemetryFrame snapshot_frame = TelemetryFrame(TELEMETRY_SNAPSHOT, frame_seq++, now);
+    (void) snapshot_frame.put_u8(SENSOR_NODE_NUM);
+    (void) snapshot_frame.put_u8(base_station->num_vacant());
+    (void) snapshot_frame.put_bytes(bitmap, sizeof(bitmap));
+    (void) snapshot_frame.put_u8(base_station->num_stale());
+
+    send_frame(&snapshot_frame);
+}
+
+#endif // TELEMETRY_ENABLED
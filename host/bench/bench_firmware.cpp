@@ -0,0 +1,255 @@
+/**
+* @brief: Micro-benchmarks of the firmware hot paths on the host.
+* @file: bench_firmware.cpp
+*
+* The binary is built once per lot size with SENSOR_NODE_NUM set by CMake,
+* so results of the same benchmark can be compared across lot sizes and
+* across alternative implementations before flashing.
+*
+* @author: jkieltyka15
+*/
+
+// standard libraries
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <benchmark/benchmark.h>
+
+// local libraries
+#include <Message.h>
+
+// local dependencies
+#include "basestation.hpp"
+#include "messagehandler.hpp"
+#include "parkingdisplay.hpp"
+#include "parkingmap.hpp"
+#include "shim.hpp"
+#include "simradio.hpp"
+
+
+// number of routed sensor nodes in the parking map
+#define ROUTED_NODE_NUM 10
+
+
+/**
+ * @brief Labels a benchmark with the lot size it was built for
+ *
+ * @param state: benchmark state
+ */
+static void label_lot_size(benchmark::State& state) {
+
+    state.SetLabel("lot=" + std::to_string(SENSOR_NODE_NUM));
+}
+
+
+static void BM_GetNextIngressNode(benchmark::State& state) {
+
+    uint8_t node_id = (uint8_t)state.range(0);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(get_next_ingress_node(node_id));
+    }
+}
+BENCHMARK(BM_GetNextIngressNode)->DenseRange(1, ROUTED_NODE_NUM);
+
+
+static void BM_UpdateMessageEncode(benchmark::State& state) {
+
+    uint8_t buffer[MSG_BUFFER_SIZE];
+    uint8_t node_id = 1;
+
+    for (auto _ : state) {
+        UpdateMessage msg = UpdateMessage(0, node_id, node_id, true);
+        memcpy(buffer, &msg, sizeof(msg));
+        benchmark::DoNotOptimize(buffer);
+        node_id = (node_id % ROUTED_NODE_NUM) + 1;
+    }
+}
+BENCHMARK(BM_UpdateMessageEncode);
+
+
+static void BM_UpdateMessageDecode(benchmark::State& state) {
+
+    uint8_t buffer[MSG_BUFFER_SIZE] = {0};
+    UpdateMessage sent = UpdateMessage(0, 3, 3, false);
+    memcpy(buffer, &sent, sizeof(sent));
+
+    for (auto _ : state) {
+
+        // same steps as the main loop of both firmwares
+        Message msg = Message();
+        memcpy(&msg, buffer, sizeof(msg));
+        benchmark::DoNotOptimize(msg.get_type());
+
+        UpdateMessage update_msg = UpdateMessage();
+        memcpy(&update_msg, buffer, sizeof(update_msg));
+        benchmark::DoNotOptimize(update_msg.get_node_id());
+        benchmark::DoNotOptimize(update_msg.get_is_vacant());
+    }
+}
+BENCHMARK(BM_UpdateMessageDecode);
+
+
+static void BM_StatsMessageEncode(benchmark::State& state) {
+
+    uint8_t buffer[MSG_BUFFER_SIZE];
+    node_stats_t stats = {100, 2, 37, 5, 40, 812, 2};
+
+    for (auto _ : state) {
+        StatsMessage msg = StatsMessage(0, 4, 4, true, &stats);
+        memcpy(buffer, &msg, sizeof(msg));
+        benchmark::DoNotOptimize(buffer);
+    }
+}
+BENCHMARK(BM_StatsMessageEncode);
+
+
+static void BM_StatsMessageDecode(benchmark::State& state) {
+
+    uint8_t buffer[MSG_BUFFER_SIZE] = {0};
+    node_stats_t sent_stats = {100, 2, 37, 5, 40, 812, 2};
+    StatsMessage sent = StatsMessage(0, 4, 4, true, &sent_stats);
+    memcpy(buffer, &sent, sizeof(sent));
+
+    for (auto _ : state) {
+        StatsMessage msg = StatsMessage();
+        memcpy(&msg, buffer, sizeof(msg));
+
+        node_stats_t stats;
+        msg.get_stats(&stats);
+        benchmark::DoNotOptimize(stats);
+    }
+}
+BENCHMARK(BM_StatsMessageDecode);
+
+
+static void BM_UpdateNodeStatus(benchmark::State& state) {
+
+    BaseStationState base_station = BaseStationState(0);
+    (void) base_station.init();
+
+    uint8_t node_id = 1;
+    bool is_vacant = false;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(base_station.update_node_status(node_id, is_vacant));
+
+        // walk the whole lot and flip the status on every pass
+        if (SENSOR_NODE_NUM == node_id) {
+            node_id = 1;
+            is_vacant = !is_vacant;
+        }
+        else {
+            node_id++;
+        }
+    }
+
+    label_lot_size(state);
+}
+BENCHMARK(BM_UpdateNodeStatus);
+
+
+static void BM_NumVacant(benchmark::State& state) {
+
+    BaseStationState base_station = BaseStationState(0);
+    (void) base_station.init();
+
+    // occupy every third space
+    for (uint8_t node_id = 1; node_id <= SENSOR_NODE_NUM; node_id += 3) {
+        (void) base_station.update_node_status(node_id, false);
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(base_station.num_vacant());
+    }
+
+    label_lot_size(state);
+}
+BENCHMARK(BM_NumVacant);
+
+
+static void BM_UpdateParkingSpace(benchmark::State& state) {
+
+    (void) init_parking_display();
+    draw_parking_map();
+
+    uint8_t space_id = 1;
+    bool is_vacant = false;
+
+    for (auto _ : state) {
+        update_parking_space(space_id, is_vacant);
+
+        // walk the whole lot and flip the status on every pass
+        if (SENSOR_NODE_NUM == space_id) {
+            space_id = 1;
+            is_vacant = !is_vacant;
+        }
+        else {
+            space_id++;
+        }
+    }
+
+    label_lot_size(state);
+}
+BENCHMARK(BM_UpdateParkingSpace);
+
+
+static void BM_DrawParkingMap(benchmark::State& state) {
+
+    (void) init_parking_display();
+
+    for (auto _ : state) {
+        draw_parking_map();
+    }
+}
+BENCHMARK(BM_DrawParkingMap);
+
+
+static void BM_BaseStationReceive(benchmark::State& state) {
+
+    sim_medium().reset(1);
+
+    BaseStation<SimRadio> base_station = BaseStation<SimRadio>(0);
+    (void) base_station.init();
+    (void) init_parking_display();
+    draw_parking_map();
+
+    // sensor node radio writing to the base station
+    SimRadio sender = SimRadio(0, 0);
+    sender.setRetries(15, 15);
+    sender.setChannel(base_station.get_radio().getChannel());
+    sender.openWritingPipe(BASE_STATION_ADDRESS);
+
+    telemetry_counters_t counters = {};
+    uint8_t node_id = 1;
+    bool is_vacant = false;
+
+    for (auto _ : state) {
+
+        state.PauseTiming();
+        UpdateMessage sent = UpdateMessage(0, node_id, node_id, is_vacant);
+        (void) sender.write(&sent, sizeof(sent));
+        state.ResumeTiming();
+
+        // same steps as the base station main loop
+        uint8_t buffer[MSG_BUFFER_SIZE] = {0};
+        uint8_t size = base_station.read_message((uint8_t**)(&buffer), (uint8_t)sizeof(buffer));
+        benchmark::DoNotOptimize(size);
+        handle_message(&base_station, buffer, &counters);
+
+        // walk the whole lot and flip the status on every pass
+        if (SENSOR_NODE_NUM == node_id) {
+            node_id = 1;
+            is_vacant = !is_vacant;
+        }
+        else {
+            node_id++;
+        }
+    }
+
+    label_lot_size(state);
+}
+BENCHMARK(BM_BaseStationReceive);
+
+
+BENCHMARK_MAIN();
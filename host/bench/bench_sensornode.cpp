@@ -0,0 +1,71 @@
+/**
+* @brief: Micro-benchmarks of the sensor node hot paths on the host.
+* @file: bench_sensornode.cpp
+*
+* The same SensorNode template is instantiated with the RF24 and VL6180X
+* stand-ins and with the simulated devices, which also shows the firmware
+* code accepting alternative devices without virtual calls.
+*
+* @author: jkieltyka15
+*/
+
+// standard libraries
+#include <cstdint>
+#include <benchmark/benchmark.h>
+
+// local libraries
+#include <Message.h>
+
+// local dependencies
+#include "sensornode.hpp"
+#include "simradio.hpp"
+#include "simrangesensor.hpp"
+
+
+// ID of the sensor node being benchmarked
+#define BENCH_NODE_ID 1
+
+
+template <class Radio, class RangeSensor>
+static void BM_SensorNodeTransmitUpdate(benchmark::State& state) {
+
+    sim_medium().reset(1);
+
+    // base station radio that acknowledges every update
+    SimRadio base_radio = SimRadio(0, 0);
+    base_radio.setChannel(0);
+    base_radio.openReadingPipe(1, BASE_STATION_ADDRESS);
+    base_radio.startListening();
+
+    SensorNode<Radio, RangeSensor> node = SensorNode<Radio, RangeSensor>(BENCH_NODE_ID);
+    (void) node.init();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(node.transmit_update((uint8_t)BASE_STATION_ID));
+        (void) base_radio.flush_rx();
+    }
+}
+BENCHMARK_TEMPLATE(BM_SensorNodeTransmitUpdate, RF24, Adafruit_VL6180X);
+BENCHMARK_TEMPLATE(BM_SensorNodeTransmitUpdate, SimRadio, SimRangeSensor);
+
+
+template <class Radio, class RangeSensor>
+static void BM_SensorNodeStatusChanged(benchmark::State& state) {
+
+    SensorNode<Radio, RangeSensor> node = SensorNode<Radio, RangeSensor>(BENCH_NODE_ID);
+    (void) node.init();
+
+    bool is_vacant = false;
+
+    for (auto _ : state) {
+
+        // alternate between a car and an empty space
+        node.get_sensor().set_reading(is_vacant ? 0 : 50,
+            is_vacant ? VL6180X_ERROR_NOCONVERGE : VL6180X_ERROR_NONE);
+        is_vacant = !is_vacant;
+
+        benchmark::DoNotOptimize(node.is_sensor_status_changed());
+    }
+}
+BENCHMARK_TEMPLATE(BM_SensorNodeStatusChanged, RF24, Adafruit_VL6180X);
+BENCHMARK_TEMPLATE(BM_SensorNodeStatusChanged, SimRadio, SimRangeSensor);
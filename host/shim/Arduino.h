@@ -0,0 +1,103 @@
+/**
+* @brief: Host stand-in for the Arduino core used by the firmware.
+* @file: Arduino.h
+*
+* Only the parts of the Arduino API the firmware uses are provided. Time is
+* virtual and only moves when delay() is called or a host tool advances it,
+* which keeps simulations deterministic and independent of the host speed.
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _SHIM_ARDUINO_H_
+#define _SHIM_ARDUINO_H_
+
+// standard libraries
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+#include <avr/pgmspace.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+// flash strings are ordinary strings on the host
+class __FlashStringHelper;
+#define F(str) (reinterpret_cast<const __FlashStringHelper*>(PSTR(str)))
+
+#define DEC 10
+#define HEX 16
+
+
+class Print {
+
+    public:
+
+        virtual ~Print() {}
+
+        /**
+         * @brief Writes a single byte
+         *
+         * @param byte: byte to write
+         * @return Number of bytes written
+         */
+        virtual size_t write(uint8_t byte) = 0;
+
+        size_t write(const uint8_t* buffer, size_t size);
+
+        size_t print(const char* str);
+        size_t print(const __FlashStringHelper* str);
+        size_t print(char c);
+        size_t print(unsigned char value, int base = DEC);
+        size_t print(int value, int base = DEC);
+        size_t print(unsigned int value, int base = DEC);
+        size_t print(long value, int base = DEC);
+        size_t print(unsigned long value, int base = DEC);
+        size_t print(double value, int digits = 2);
+
+        size_t println();
+
+        template <typename T>
+        size_t println(T value) {
+            return this->print(value) + this->println();
+        }
+
+        template <typename T>
+        size_t println(T value, int format) {
+            return this->print(value, format) + this->println();
+        }
+};
+
+
+class HardwareSerial : public Print {
+
+    public:
+
+        using Print::write;
+
+        void begin(unsigned long baud);
+        int available();
+        int read();
+        int peek();
+        int availableForWrite();
+        void flush();
+        size_t write(uint8_t byte) override;
+        operator bool() { return true; }
+};
+
+extern HardwareSerial Serial;
+
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+#endif // _SHIM_ARDUINO_H_
@@ -0,0 +1,60 @@
+/**
+* @brief: Host stand-in for the Arduino EEPROM library.
+* @file: EEPROM.h
+*
+* Holds the 1 KB EEPROM of an ATmega328P per thread. It starts erased, and
+* every byte that is actually written advances virtual time by the write
+* time of the real part, so code that writes too often shows up in timings.
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _SHIM_EEPROM_H_
+#define _SHIM_EEPROM_H_
+
+// standard libraries
+#include <stdint.h>
+
+#define SHIM_EEPROM_SIZE 1024       // bytes of EEPROM on an ATmega328P
+#define SHIM_EEPROM_WRITE_US 3300   // time to erase and write one byte in microseconds
+
+
+class EEPROMClass {
+
+    public:
+
+        /**
+         * @brief Reads a byte
+         *
+         * @param address: address of the byte
+         * @return Value of the byte. Erased bytes read as 0xFF
+         */
+        uint8_t read(int address);
+
+        /**
+         * @brief Writes a byte
+         *
+         * @param address: address of the byte
+         * @param value: value to write
+         */
+        void write(int address, uint8_t value);
+
+        /**
+         * @brief Writes a byte only if it differs from what is stored
+         *
+         * @param address: address of the byte
+         * @param value: value to write
+         */
+        void update(int address, uint8_t value);
+
+        /**
+         * @brief Gets the size of the EEPROM
+         *
+         * @return Number of bytes
+         */
+        uint16_t length();
+};
+
+extern EEPROMClass EEPROM;
+
+#endif // _SHIM_EEPROM_H_
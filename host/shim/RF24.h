@@ -0,0 +1,104 @@
+/**
+* @brief: Host stand-in for the RF24 radio driver.
+* @file: RF24.h
+*
+* Received payloads are injected by host tools into a FIFO of the same depth
+* as the NRF24L01. Written payloads are handed to an optional handler that
+* decides whether the write was acknowledged.
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _SHIM_RF24_H_
+#define _SHIM_RF24_H_
+
+// standard libraries
+#include <stdint.h>
+#include <deque>
+#include <functional>
+#include <vector>
+
+// number of payloads the NRF24L01 receive FIFO holds
+#define RF24_SHIM_FIFO_DEPTH 3
+
+// largest payload of the NRF24L01
+#define RF24_SHIM_PAYLOAD_MAX 32
+
+typedef enum { RF24_PA_MIN = 0, RF24_PA_LOW, RF24_PA_HIGH, RF24_PA_MAX, RF24_PA_ERROR } rf24_pa_dbm_e;
+typedef enum { RF24_1MBPS = 0, RF24_2MBPS, RF24_250KBPS } rf24_datarate_e;
+
+
+class RF24 {
+
+    private:
+
+        std::deque<std::vector<uint8_t>> rx_fifo;
+        uint8_t channel = 76;
+        uint8_t pa_level = RF24_PA_MAX;
+        rf24_datarate_e data_rate = RF24_1MBPS;
+        uint64_t writing_address = 0;
+        uint8_t arc = 0;
+        bool is_listening = false;
+
+
+    public:
+
+        /**
+         * @brief Decides if a written payload is acknowledged
+         *
+         * Called with the channel, address, payload and size of each write.
+         * Returns the number of retransmissions needed, or a negative value
+         * if the payload was not acknowledged. Writes succeed immediately
+         * when no handler is set.
+         */
+        std::function<int(uint8_t, uint64_t, const uint8_t*, uint8_t)> on_write;
+
+        RF24(uint16_t ce_pin, uint16_t csn_pin);
+
+        bool begin();
+        void enableDynamicPayloads();
+        void enableAckPayload();
+        void enableDynamicAck();
+        void setAutoAck(bool enable);
+        void setRetries(uint8_t delay, uint8_t count);
+        void setAddressWidth(uint8_t width);
+        void setPALevel(uint8_t level, bool lna_enable = true);
+        uint8_t getPALevel();
+        bool setDataRate(rf24_datarate_e speed);
+        rf24_datarate_e getDataRate();
+        void setChannel(uint8_t channel);
+        uint8_t getChannel();
+
+        void openReadingPipe(uint8_t pipe, uint64_t address);
+        void openWritingPipe(uint64_t address);
+        void closeReadingPipe(uint8_t pipe);
+        void startListening();
+        void stopListening();
+
+        bool write(const void* buffer, uint8_t size);
+        bool write(const void* buffer, uint8_t size, const bool multicast);
+        bool writeAckPayload(uint8_t pipe, const void* buffer, uint8_t size);
+        bool isAckPayloadAvailable();
+
+        bool testCarrier();
+        bool testRPD();
+        bool available();
+        bool available(uint8_t* pipe);
+        void read(void* buffer, uint8_t size);
+        uint8_t getDynamicPayloadSize();
+        uint8_t getARC();
+        bool rxFifoFull();
+        uint8_t flush_rx();
+        uint8_t flush_tx();
+
+        /**
+         * @brief Places a payload in the receive FIFO as if it was received
+         *
+         * @param buffer: payload
+         * @param size: size of payload
+         * @return True if the FIFO had room. Otherwise false
+         */
+        bool inject(const void* buffer, uint8_t size);
+};
+
+#endif // _SHIM_RF24_H_
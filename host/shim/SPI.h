@@ -0,0 +1,13 @@
+/**
+* @brief: Host stand-in for the SPI library.
+* @file: SPI.h
+*
+* Nothing in this header is used by the firmware directly.
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _SHIM_SPI_H_
+#define _SHIM_SPI_H_
+
+#endif // _SHIM_SPI_H_
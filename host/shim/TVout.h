@@ -0,0 +1,61 @@
+/**
+* @brief: Host stand-in for the TVout library.
+* @file: TVout.h
+*
+* Pixels are drawn into a bit packed framebuffer laid out like TVout's, so
+* drawing code does the same amount of work on the host. The firmware draws
+* through a single global TVout, so the framebuffer is thread local to let
+* independent simulations run on separate threads.
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _SHIM_TVOUT_H_
+#define _SHIM_TVOUT_H_
+
+// standard libraries
+#include <stdint.h>
+#include <vector>
+
+#define NTSC 0
+#define PAL 1
+
+#define BLACK 0
+#define WHITE 1
+#define INVERT 2
+
+
+// framebuffer of the current thread
+struct tvout_state_t {
+    uint8_t width = 0;
+    uint8_t height = 0;
+
+    // bit packed framebuffer with eight horizontal pixels per byte
+    std::vector<uint8_t> screen;
+};
+
+
+class TVout {
+
+    private:
+
+        /**
+         * @brief Gets the framebuffer of the current thread
+         *
+         * @return Framebuffer of the current thread
+         */
+        static tvout_state_t& state();
+
+
+    public:
+
+        char begin(uint8_t mode, uint8_t x, uint8_t y);
+        void clear_screen();
+        void fill(uint8_t color);
+        void set_pixel(uint8_t x, uint8_t y, char color);
+        unsigned char get_pixel(uint8_t x, uint8_t y);
+        unsigned char hres();
+        unsigned char vres();
+};
+
+#endif // _SHIM_TVOUT_H_
@@ -0,0 +1,13 @@
+/**
+* @brief: Host stand-in for the Wire library.
+* @file: Wire.h
+*
+* Nothing in this header is used by the firmware directly.
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _SHIM_WIRE_H_
+#define _SHIM_WIRE_H_
+
+#endif // _SHIM_WIRE_H_
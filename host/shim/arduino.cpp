@@ -0,0 +1,246 @@
+/**
+* @brief: Contains the host implementation of the Arduino core stand-in.
+* @file: arduino.cpp
+*
+* @author: jkieltyka15
+*/
+
+// standard libraries
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <random>
+#include <string>
+#include <utility>
+
+// local dependencies
+#include "Arduino.h"
+#include "shim.hpp"
+
+
+HardwareSerial Serial;
+
+// virtual time of the current thread in microseconds
+static thread_local uint64_t time_us = 0;
+
+// random number generator of the current thread
+static thread_local std::minstd_rand generator;
+
+// destination of bytes written to Serial, which defaults to standard output
+static thread_local std::function<void(uint8_t)> serial_sink = [](uint8_t byte) {
+    fputc(byte, stdout);
+};
+
+// bytes waiting to be read from Serial
+static thread_local std::deque<uint8_t> serial_input;
+
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+
+    for (size_t i = 0; i < size; i++) {
+        this->write(buffer[i]);
+    }
+
+    return size;
+}
+
+
+size_t Print::print(const char* str) {
+
+    return this->write((const uint8_t*)str, strlen(str));
+}
+
+
+size_t Print::print(const __FlashStringHelper* str) {
+
+    return this->print(reinterpret_cast<const char*>(str));
+}
+
+
+size_t Print::print(char c) {
+
+    return this->write((uint8_t)c);
+}
+
+
+size_t Print::print(unsigned char value, int base) {
+
+    return this->print((unsigned long)value, base);
+}
+
+
+size_t Print::print(int value, int base) {
+
+    return this->print((long)value, base);
+}
+
+
+size_t Print::print(unsigned int value, int base) {
+
+    return this->print((unsigned long)value, base);
+}
+
+
+size_t Print::print(long value, int base) {
+
+    char buffer[24];
+    snprintf(buffer, sizeof(buffer), (HEX == base) ? "%lx" : "%ld", value);
+
+    return this->print(buffer);
+}
+
+
+size_t Print::print(unsigned long value, int base) {
+
+    char buffer[24];
+    snprintf(buffer, sizeof(buffer), (HEX == base) ? "%lx" : "%lu", value);
+
+    return this->print(buffer);
+}
+
+
+size_t Print::print(double value, int digits) {
+
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.*f", digits, value);
+
+    return this->print(buffer);
+}
+
+
+size_t Print::println() {
+
+    return this->print("\r\n");
+}
+
+
+void HardwareSerial::begin(unsigned long baud) {}
+
+
+int HardwareSerial::available() {
+
+    return (int)serial_input.size();
+}
+
+
+int HardwareSerial::read() {
+
+    if (true == serial_input.empty()) {
+        return -1;
+    }
+
+    uint8_t byte = serial_input.front();
+    serial_input.pop_front();
+
+    return byte;
+}
+
+
+int HardwareSerial::peek() {
+
+    return (true == serial_input.empty()) ? -1 : serial_input.front();
+}
+
+
+int HardwareSerial::availableForWrite() {
+
+    // the host never runs out of room
+    return 64;
+}
+
+
+void HardwareSerial::flush() {
+
+    fflush(stdout);
+}
+
+
+size_t HardwareSerial::write(uint8_t byte) {
+
+    if (serial_sink) {
+        serial_sink(byte);
+    }
+
+    return 1;
+}
+
+
+unsigned long millis() {
+
+    return (unsigned long)(uint32_t)(time_us / 1000);
+}
+
+
+unsigned long micros() {
+
+    return (unsigned long)(uint32_t)time_us;
+}
+
+
+void delay(unsigned long ms) {
+
+    time_us += (uint64_t)ms * 1000;
+}
+
+
+void delayMicroseconds(unsigned int us) {
+
+    time_us += us;
+}
+
+
+long random(long howbig) {
+
+    if (0 >= howbig) {
+        return 0;
+    }
+
+    return (long)(generator() % (unsigned long)howbig);
+}
+
+
+long random(long howsmall, long howbig) {
+
+    if (howsmall >= howbig) {
+        return howsmall;
+    }
+
+    return howsmall + random(howbig - howsmall);
+}
+
+
+void randomSeed(unsigned long seed) {
+
+    generator.seed(0 == seed ? 1 : seed);
+}
+
+
+void shim_set_micros(uint64_t time) {
+
+    time_us = time;
+}
+
+
+void shim_advance_micros(uint64_t elapsed_us) {
+
+    time_us += elapsed_us;
+}
+
+
+uint64_t shim_get_micros() {
+
+    return time_us;
+}
+
+
+void shim_serial_set_sink(std::function<void(uint8_t)> sink) {
+
+    serial_sink = std::move(sink);
+}
+
+
+void shim_serial_input(const std::string& input) {
+
+    serial_input.insert(serial_input.end(), input.begin(), input.end());
+}
@@ -0,0 +1,31 @@
+/**
+* @brief: Host stand-in for AVR program memory access.
+* @file: pgmspace.h
+*
+* The host has a single address space so flash data is ordinary memory.
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _SHIM_PGMSPACE_H_
+#define _SHIM_PGMSPACE_H_
+
+// standard libraries
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define PROGMEM
+#define PGM_P const char*
+#define PSTR(str) (str)
+
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+
+#define memcpy_P memcpy
+#define strlen_P strlen
+#define snprintf_P snprintf
+#define vsnprintf_P vsnprintf
+
+#endif // _SHIM_PGMSPACE_H_
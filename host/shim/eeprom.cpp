@@ -0,0 +1,77 @@
+/**
+* @brief: Contains the host implementation of the EEPROM stand-in.
+* @file: eeprom.cpp
+*
+* @author: jkieltyka15
+*/
+
+// standard libraries
+#include <cstdint>
+#include <cstring>
+
+// local dependencies
+#include "EEPROM.h"
+#include "shim.hpp"
+
+
+EEPROMClass EEPROM;
+
+
+/**
+ * @brief Gets the EEPROM contents of the current thread
+ *
+ * @return First byte of the EEPROM
+ */
+static uint8_t* eeprom_bytes() {
+
+    static thread_local uint8_t bytes[SHIM_EEPROM_SIZE];
+    static thread_local bool is_erased = false;
+
+    if (false == is_erased) {
+        memset(bytes, 0xFF, sizeof(bytes));
+        is_erased = true;
+    }
+
+    return bytes;
+}
+
+
+uint8_t EEPROMClass::read(int address) {
+
+    if ((0 > address) || (SHIM_EEPROM_SIZE <= address)) {
+        return 0xFF;
+    }
+
+    return eeprom_bytes()[address];
+}
+
+
+void EEPROMClass::write(int address, uint8_t value) {
+
+    if ((0 > address) || (SHIM_EEPROM_SIZE <= address)) {
+        return;
+    }
+
+    eeprom_bytes()[address] = value;
+    shim_advance_micros(SHIM_EEPROM_WRITE_US);
+}
+
+
+void EEPROMClass::update(int address, uint8_t value) {
+
+    if (value != this->read(address)) {
+        this->write(address, value);
+    }
+}
+
+
+uint16_t EEPROMClass::length() {
+
+    return SHIM_EEPROM_SIZE;
+}
+
+
+void shim_eeprom_erase() {
+
+    memset(eeprom_bytes(), 0xFF, SHIM_EEPROM_SIZE);
+}
@@ -0,0 +1,13 @@
+/**
+* @brief: Host stand-in for the nRF24L01 library.
+* @file: nRF24L01.h
+*
+* Nothing in this header is used by the firmware directly.
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _SHIM_NRF24L01_H_
+#define _SHIM_NRF24L01_H_
+
+#endif // _SHIM_NRF24L01_H_
@@ -0,0 +1,133 @@
+/**
+* @brief: Contains the host implementation of the RF24 stand-in.
+* @file: rf24.cpp
+*
+* @author: jkieltyka15
+*/
+
+// standard libraries
+#include <cstdint>
+#include <cstring>
+
+// local dependencies
+#include "RF24.h"
+
+
+RF24::RF24(uint16_t ce_pin, uint16_t csn_pin) {}
+
+bool RF24::begin() { return true; }
+void RF24::enableDynamicPayloads() {}
+void RF24::enableAckPayload() {}
+void RF24::enableDynamicAck() {}
+void RF24::setAutoAck(bool enable) {}
+void RF24::setRetries(uint8_t delay, uint8_t count) {}
+void RF24::setAddressWidth(uint8_t width) {}
+void RF24::setPALevel(uint8_t level, bool lna_enable) { this->pa_level = level; }
+uint8_t RF24::getPALevel() { return this->pa_level; }
+bool RF24::setDataRate(rf24_datarate_e speed) { this->data_rate = speed; return true; }
+rf24_datarate_e RF24::getDataRate() { return this->data_rate; }
+void RF24::setChannel(uint8_t channel) { this->channel = channel; }
+uint8_t RF24::getChannel() { return this->channel; }
+void RF24::openReadingPipe(uint8_t pipe, uint64_t address) {}
+void RF24::openWritingPipe(uint64_t address) { this->writing_address = address; }
+void RF24::closeReadingPipe(uint8_t pipe) {}
+void RF24::startListening() { this->is_listening = true; }
+void RF24::stopListening() { this->is_listening = false; }
+bool RF24::writeAckPayload(uint8_t pipe, const void* buffer, uint8_t size) { return true; }
+bool RF24::isAckPayloadAvailable() { return false; }
+bool RF24::testCarrier() { return false; }
+bool RF24::testRPD() { return false; }
+uint8_t RF24::getARC() { return this->arc; }
+
+
+bool RF24::write(const void* buffer, uint8_t size) {
+
+    return this->write(buffer, size, false);
+}
+
+
+bool RF24::write(const void* buffer, uint8_t size, const bool multicast) {
+
+    this->arc = 0;
+
+    if (!this->on_write) {
+        return true;
+    }
+
+    int retries = this->on_write(this->channel, this->writing_address, (const uint8_t*)buffer, size);
+    if (0 > retries) {
+        return false;
+    }
+
+    this->arc = (uint8_t)retries;
+
+    return true;
+}
+
+
+bool RF24::available() {
+
+    return false == this->rx_fifo.empty();
+}
+
+
+bool RF24::available(uint8_t* pipe) {
+
+    if (nullptr != pipe) {
+        *pipe = 1;
+    }
+
+    return this->available();
+}
+
+
+void RF24::read(void* buffer, uint8_t size) {
+
+    if (true == this->rx_fifo.empty()) {
+        return;
+    }
+
+    const std::vector<uint8_t>& payload = this->rx_fifo.front();
+    memcpy(buffer, payload.data(), (size < payload.size()) ? size : payload.size());
+
+    this->rx_fifo.pop_front();
+}
+
+
+uint8_t RF24::getDynamicPayloadSize() {
+
+    return (true == this->rx_fifo.empty()) ? 0 : (uint8_t)this->rx_fifo.front().size();
+}
+
+
+bool RF24::rxFifoFull() {
+
+    return RF24_SHIM_FIFO_DEPTH <= this->rx_fifo.size();
+}
+
+
+uint8_t RF24::flush_rx() {
+
+    this->rx_fifo.clear();
+
+    return 0;
+}
+
+
+uint8_t RF24::flush_tx() {
+
+    return 0;
+}
+
+
+bool RF24::inject(const void* buffer, uint8_t size) {
+
+    if ((true == this->rxFifoFull()) || (RF24_SHIM_PAYLOAD_MAX < size)) {
+        return false;
+    }
+
+    const uint8_t* bytes = (const uint8_t*)buffer;
+    this->rx_fifo.emplace_back(bytes, bytes + size);
+
+    return true;
+}
@@ -0,0 +1,63 @@
+/**
+* @brief: Contains the host side controls of the Arduino stand-ins.
+* @file: shim.hpp
+*
+* All state behind the stand-ins is thread local so independent simulations
+* can run on separate threads.
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _SHIM_HPP_
+#define _SHIM_HPP_
+
+// standard libraries
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <string>
+
+/**
+ * @brief Sets the virtual time of the current thread
+ *
+ * @param time_us: time in microseconds since boot
+ */
+void shim_set_micros(uint64_t time_us);
+
+/**
+ * @brief Advances the virtual time of the current thread
+ *
+ * @param elapsed_us: time in microseconds to advance
+ */
+void shim_advance_micros(uint64_t elapsed_us);
+
+/**
+ * @brief Gets the virtual time of the current thread
+ *
+ * @return Time in microseconds since boot
+ */
+uint64_t shim_get_micros();
+
+/**
+ * @brief Sets where bytes written to Serial go on the current thread
+ *
+ * @param sink: called with every written byte. An empty function discards them
+ */
+void shim_serial_set_sink(std::function<void(uint8_t)> sink);
+
+/**
+ * @brief Queues bytes to be read from Serial on the current thread
+ *
+ * @param input: bytes to queue
+ */
+void shim_serial_input(const std::string& input);
+
+/**
+ * @brief Erases the EEPROM of the current thread
+ *
+ * Simulations call this before booting so state saved by an earlier run
+ * on the same thread is not restored.
+ */
+void shim_eeprom_erase();
+
+#endif // _SHIM_HPP_
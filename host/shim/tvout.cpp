@@ -0,0 +1,92 @@
+/**
+* @brief: Contains the host implementation of the TVout stand-in.
+* @file: tvout.cpp
+*
+* @author: jkieltyka15
+*/
+
+// standard libraries
+#include <cstdint>
+
+// local dependencies
+#include "TVout.h"
+
+
+tvout_state_t& TVout::state() {
+
+    static thread_local tvout_state_t state;
+
+    return state;
+}
+
+
+char TVout::begin(uint8_t mode, uint8_t x, uint8_t y) {
+
+    tvout_state_t& state = TVout::state();
+    state.width = x;
+    state.height = y;
+    state.screen.assign((x / 8) * y, 0);
+
+    return 0;
+}
+
+
+void TVout::clear_screen() {
+
+    this->fill(BLACK);
+}
+
+
+void TVout::fill(uint8_t color) {
+
+    for (uint8_t& byte : TVout::state().screen) {
+        byte = (WHITE == color) ? 0xFF : ((INVERT == color) ? ~byte : 0x00);
+    }
+}
+
+
+void TVout::set_pixel(uint8_t x, uint8_t y, char color) {
+
+    tvout_state_t& state = TVout::state();
+
+    // ignore pixels off the screen
+    if ((x >= state.width) || (y >= state.height)) {
+        return;
+    }
+
+    uint8_t& byte = state.screen[(y * (state.width / 8)) + (x / 8)];
+    uint8_t mask = 0x80 >> (x % 8);
+
+    switch (color) {
+        case WHITE:  byte |= mask;  break;
+        case BLACK:  byte &= ~mask; break;
+        case INVERT: byte ^= mask;  break;
+        default: break;
+    }
+}
+
+
+unsigned char TVout::get_pixel(uint8_t x, uint8_t y) {
+
+    tvout_state_t& state = TVout::state();
+
+    if ((x >= state.width) || (y >= state.height)) {
+        return BLACK;
+    }
+
+    uint8_t byte = state.screen[(y * (state.width / 8)) + (x / 8)];
+
+    return (0 != (byte & (0x80 >> (x % 8)))) ? WHITE : BLACK;
+}
+
+
+unsigned char TVout::hres() {
+
+    return TVout::state().width;
+}
+
+
+unsigned char TVout::vres() {
+
+    return TVout::state().height;
+}
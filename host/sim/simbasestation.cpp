@@ -0,0 +1,147 @@
+/**
+* @brief: Contains the implementation of the SimBaseStation class.
+* @file: simbasestation.cpp
+*
+* @author: jkieltyka15
+*/
+
+// standard libraries
+#include <cstdint>
+#include <memory>
+
+// local libraries
+#include <Telemetry.h>
+
+// local dependencies
+#include "basestation.hpp"
+#include "mainloop.hpp"
+#include "parkingdisplay.hpp"
+#include "simbasestation.hpp"
+#include "simradio.hpp"
+
+
+struct SimBaseStation::impl_t {
+    BaseStation<SimRadio> base_station;
+    telemetry_counters_t counters = {};
+    uint32_t rx_messages = 0;
+
+    explicit impl_t(uint8_t node_id) : base_station(node_id) {}
+};
+
+
+SimBaseStation::SimBaseStation(uint8_t node_id) : impl(new impl_t(node_id)) {}
+
+
+SimBaseStation::~SimBaseStation() {}
+
+
+bool SimBaseStation::init() {
+
+    if (false == this->impl->base_station.init()) {
+        return false;
+    }
+
+    if (false == init_parking_display()) {
+        return false;
+    }
+
+    draw_parking_map();
+
+    // show the spaces as the last boot left them
+    for (uint8_t node_id = 1; node_id <= SENSOR_NODE_NUM; node_id++) {
+        if (false == this->impl->base_station.get_node_status(node_id)) {
+            update_parking_space(node_id, false);
+        }
+    }
+
+    return true;
+}
+
+
+void SimBaseStation::loop() {
+
+    uint16_t rx_messages = this->impl->counters.rx_messages;
+
+    base_station_loop(&this->impl->base_station, &this->impl->counters);
+
+    // widen the 16 bit telemetry counter
+    this->impl->rx_messages += (uint16_t)(this->impl->counters.rx_messages - rx_messages);
+}
+
+
+uint8_t SimBaseStation::get_node_num() {
+
+    return SENSOR_NODE_NUM;
+}
+
+
+bool SimBaseStation::get_node_status(uint8_t node_id) {
+
+    return this->impl->base_station.get_node_status(node_id);
+}
+
+
+uint32_t SimBaseStation::get_rx_messages() {
+
+    return this->impl->rx_messages;
+}
+
+
+uint16_t SimBaseStation::get_latency_max_ms(uint8_t node_id) {
+
+    return this->impl->base_station.get_latency_max_ms(node_id);
+}
+
+
+uint32_t SimBaseStation::get_heard_ms(uint8_t node_id) {
+
+    return this->impl->base_station.get_heard_ms(node_id);
+}
+
+
+uint8_t SimBaseStation::get_route_last(uint8_t node_id, uint8_t* path) {
+
+    return this->impl->base_station.get_route_last(node_id, path);
+}
+
+
+uint16_t SimBaseStation::get_relay_load(uint8_t relay_id) {
+
+    return this->impl->base_station.get_relay_load(relay_id);
+}
+
+
+void SimBaseStation::request_status(uint16_t targets) {
+
+    this->impl->base_station.request_status(targets);
+}
+
+
+bool SimBaseStation::push_config(uint16_t targets, uint8_t setting, uint16_t value) {
+
+    return this->impl->base_station.push_config(targets, setting, value);
+}
+
+
+void SimBaseStation::start_probe_sweep(uint8_t rounds) {
+
+    this->impl->base_station.get_probe_sweep()->start(rounds);
+}
+
+
+bool SimBaseStation::is_probe_sweep_active() {
+
+    return this->impl->base_station.get_probe_sweep()->is_active();
+}
+
+
+uint32_t SimBaseStation::get_link_rtt_us(uint8_t node_id, uint8_t hop_index) {
+
+    return this->impl->base_station.get_probe_sweep()->get_link_rtt_us(node_id, hop_index);
+}
+
+
+uint8_t SimBaseStation::get_link_delivery_pct(uint8_t node_id, uint8_t hop_index) {
+
+    return this->impl->base_station.get_probe_sweep()->get_link_delivery_pct(node_id, hop_index);
+}
@@ -0,0 +1,159 @@
+/**
+* @brief: Contains the prototype of the SimBaseStation class.
+* @file: simbasestation.hpp
+*
+* Runs the base station firmware on a SimRadio from code that cannot include
+* the base station headers, such as simulations that also include the sensor
+* node headers of the same names.
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _SIM_BASE_STATION_HPP_
+#define _SIM_BASE_STATION_HPP_
+
+// standard libraries
+#include <cstdint>
+#include <memory>
+
+// local libraries
+#include <Message.h>
+
+
+class SimBaseStation {
+
+    private:
+
+        // base station, radio and counters of the firmware
+        struct impl_t;
+        std::unique_ptr<impl_t> impl;
+
+
+    public:
+
+        /**
+         * @brief Constructs a SimBaseStation object
+         *
+         * @param node_id: ID of the base station
+         */
+        explicit SimBaseStation(uint8_t node_id);
+        ~SimBaseStation();
+
+        /**
+         * @brief Initializes the base station and its display as setup() does
+         *
+         * @return True on success. Otherwise false
+         */
+        bool init();
+
+        /**
+         * @brief Runs one iteration of the base station main loop
+         */
+        void loop();
+
+        /**
+         * @brief Gets the number of sensor nodes the base station was built for
+         *
+         * @return Number of sensor nodes
+         */
+        uint8_t get_node_num();
+
+        /**
+         * @brief Get the vacancy status of a node
+         *
+         * @param node_id: ID of node to get vacancy status
+         * @return The node's vacancy status
+         */
+        bool get_node_status(uint8_t node_id);
+
+        /**
+         * @brief Gets the number of messages read from the radio
+         *
+         * @return Number of messages
+         */
+        uint32_t get_rx_messages();
+
+        /**
+         * @brief Get the longest sensor to paint latency the firmware recorded for a node
+         *
+         * @param node_id: ID of node
+         * @return Latency in milliseconds, saturating
+         */
+        uint16_t get_latency_max_ms(uint8_t node_id);
+
+        /**
+         * @brief Get the time a node was last heard from
+         *
+         * @param node_id: ID of node
+         * @return Time in milliseconds
+         */
+        uint32_t get_heard_ms(uint8_t node_id);
+
+        /**
+         * @brief Get the path of the last report of a node
+         *
+         * @param node_id: ID of node
+         * @param path: where to store at least PATH_TRACE_MAX relay IDs
+         * @return Number of relays in the path
+         */
+        uint8_t get_route_last(uint8_t node_id, uint8_t* path);
+
+        /**
+         * @brief Get the number of reports a relay carried for every node
+         *
+         * @param relay_id: ID of the relay
+         * @return Number of reports, saturating
+         */
+        uint16_t get_relay_load(uint8_t relay_id);
+
+        /**
+         * @brief Asks nodes to report their status on the next loop
+         *
+         * @param targets: bitmap where bit N is set if node N should report
+         */
+        void request_status(uint16_t targets);
+
+        /**
+         * @brief Adds a timing setting to push to nodes on the next loop
+         *
+         * @param targets: bitmap where bit N is set if node N should apply the setting
+         * @param setting: ID of the setting, one of the CONFIG_ defines
+         * @param value: new value of the setting
+         * @return True if the setting was added. Otherwise false
+         */
+        bool push_config(uint16_t targets, uint8_t setting, uint16_t value);
+
+        /**
+         * @brief Starts a probe sweep of every link of the parking map
+         *
+         * @param rounds: number of probes to send along every route
+         */
+        void start_probe_sweep(uint8_t rounds);
+
+        /**
+         * @brief Determines if a probe sweep is in progress
+         *
+         * @return True if the sweep is in progress. Otherwise false
+         */
+        bool is_probe_sweep_active();
+
+        /**
+         * @brief Gets the round trip time added by a single link
+         *
+         * @param node_id: ID of node at the far end of the link
+         * @param hop_index: index of the next node of the link
+         * @return Round trip time in microseconds, or zero if it is unknown
+         */
+        uint32_t get_link_rtt_us(uint8_t node_id, uint8_t hop_index);
+
+        /**
+         * @brief Gets the share of probes that made it across a single link and back
+         *
+         * @param node_id: ID of node at the far end of the link
+         * @param hop_index: index of the next node of the link
+         * @return Delivery ratio in percent, or zero if it is unknown
+         */
+        uint8_t get_link_delivery_pct(uint8_t node_id, uint8_t hop_index);
+};
+
+#endif // _SIM_BASE_STATION_HPP_
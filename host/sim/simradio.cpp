@@ -0,0 +1,357 @@
+/**
+* @brief: Contains the implementation of the simulated radio and its medium.
+* @file: simradio.cpp
+*
+* @author: jkieltyka15
+*/
+
+// standard libraries
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <random>
+
+// local dependencies
+#include "shim.hpp"
+#include "simradio.hpp"
+
+
+/**
+ * @brief Calculates the time one transmission attempt and its ACK spend on air
+ *
+ * @param size: size of payload
+ * @param data_rate: data rate of the radio
+ * @return Time in microseconds
+ */
+static uint64_t attempt_time_us(uint8_t size, rf24_datarate_e data_rate) {
+
+    // microseconds per byte at each data rate
+    uint64_t byte_us = 8;
+    if (RF24_2MBPS == data_rate) {
+        byte_us = 4;
+    }
+    else if (RF24_250KBPS == data_rate) {
+        byte_us = 32;
+    }
+
+    uint64_t packet_us = (size + SIM_RADIO_OVERHEAD_BYTES) * byte_us;
+    uint64_t ack_us = SIM_RADIO_OVERHEAD_BYTES * byte_us;
+
+    return SIM_RADIO_SETTLE_US + packet_us + SIM_RADIO_SETTLE_US + ack_us;
+}
+
+
+SimMedium& sim_medium() {
+
+    static thread_local SimMedium medium;
+
+    return medium;
+}
+
+
+void SimMedium::reset(uint32_t seed) {
+
+    this->generator.seed(seed);
+    this->loss = 0.0;
+    memset(this->busy_until_us, 0, sizeof(this->busy_until_us));
+
+    this->delivered = 0;
+    this->dropped_full = 0;
+    this->dropped_lost = 0;
+    this->dropped_no_listener = 0;
+}
+
+
+void SimMedium::set_loss(double loss) {
+
+    this->loss = loss;
+}
+
+
+void SimMedium::attach(SimRadio* radio) {
+
+    this->radios.push_back(radio);
+}
+
+
+void SimMedium::detach(SimRadio* radio) {
+
+    this->radios.erase(std::remove(this->radios.begin(), this->radios.end(), radio), this->radios.end());
+}
+
+
+int SimMedium::transmit(SimRadio* sender, const uint8_t* buffer, uint8_t size) {
+
+    // find the radio listening on the sender's channel, writing address and data rate
+    SimRadio* receiver = nullptr;
+    for (SimRadio* radio : this->radios) {
+
+        if ((radio != sender) && (true == radio->is_listening) && (true == radio->is_reading)
+            && (radio->channel == sender->channel) && (radio->reading_address == sender->writing_address)
+            && (radio->data_rate == sender->data_rate)) {
+            receiver = radio;
+            break;
+        }
+    }
+
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    uint64_t attempt_us = attempt_time_us(size, sender->data_rate);
+    uint64_t retry_us = (uint64_t)(sender->retry_delay + 1) * SIM_RADIO_ARD_STEP_US;
+
+    int retries = -1;
+    bool is_lost = false;
+    bool is_full = false;
+
+    for (uint8_t attempt = 0; attempt <= sender->retry_count; attempt++) {
+
+        // wait out the retransmit delay before every retry
+        if (0 < attempt) {
+            shim_advance_micros(retry_us);
+        }
+        shim_advance_micros(attempt_us);
+
+        sender->tx_attempts++;
+        sender->tx_us += attempt_us;
+
+        if (nullptr == receiver) {
+            continue;
+        }
+
+        if (distribution(this->generator) < this->loss) {
+            is_lost = true;
+            continue;
+        }
+
+        // a full receive FIFO discards the payload without an ACK
+        if (SIM_RADIO_FIFO_DEPTH <= receiver->rx_fifo.size()) {
+            is_full = true;
+            continue;
+        }
+
+        receiver->rx_fifo.push_back({shim_get_micros(), receiver->reading_pipe, std::vector<uint8_t>(buffer, buffer + size)});
+
+        // the medium has no path loss, so every payload is strong
+        receiver->is_rpd = true;
+
+        // the ACK carries the receiver's next ACK payload back on pipe 0
+        if ((true == sender->is_ack_payload) && (false == receiver->ack_payloads.empty())) {
+
+            if (SIM_RADIO_FIFO_DEPTH > sender->rx_fifo.size()) {
+                sender->rx_fifo.push_back({shim_get_micros(), 0, receiver->ack_payloads.front()});
+            }
+            receiver->ack_payloads.pop_front();
+        }
+
+        retries = attempt;
+        break;
+    }
+
+    // the channel carries the transmission until the last attempt ends
+    uint64_t& busy_until_us = this->busy_until_us[sender->channel & 0x7F];
+    busy_until_us = std::max(busy_until_us, shim_get_micros());
+
+    if (0 <= retries) {
+        this->delivered++;
+    }
+    else if (nullptr == receiver) {
+        this->dropped_no_listener++;
+    }
+    else if (true == is_full) {
+        this->dropped_full++;
+    }
+    else if (true == is_lost) {
+        this->dropped_lost++;
+    }
+
+    return retries;
+}
+
+
+bool SimMedium::is_busy(uint8_t channel) {
+
+    return shim_get_micros() < this->busy_until_us[channel & 0x7F];
+}
+
+
+uint64_t SimMedium::get_delivered() const {
+
+    return this->delivered;
+}
+
+
+uint64_t SimMedium::get_dropped_full() const {
+
+    return this->dropped_full;
+}
+
+
+uint64_t SimMedium::get_dropped_lost() const {
+
+    return this->dropped_lost;
+}
+
+
+uint64_t SimMedium::get_dropped_no_listener() const {
+
+    return this->dropped_no_listener;
+}
+
+
+SimRadio::SimRadio(uint16_t ce_pin, uint16_t csn_pin) {
+
+    sim_medium().attach(this);
+}
+
+
+SimRadio::~SimRadio() {
+
+    sim_medium().detach(this);
+}
+
+
+bool SimRadio::begin() { return true; }
+void SimRadio::enableDynamicPayloads() {}
+void SimRadio::enableAckPayload() { this->is_ack_payload = true; }
+void SimRadio::enableDynamicAck() {}
+void SimRadio::setAutoAck(bool enable) {}
+void SimRadio::setRetries(uint8_t delay, uint8_t count) { this->retry_delay = delay; this->retry_count = count; }
+void SimRadio::setAddressWidth(uint8_t width) {}
+void SimRadio::setPALevel(uint8_t level, bool lna_enable) { this->pa_level = level; }
+uint8_t SimRadio::getPALevel() { return this->pa_level; }
+bool SimRadio::setDataRate(rf24_datarate_e speed) { this->data_rate = speed; return true; }
+rf24_datarate_e SimRadio::getDataRate() { return this->data_rate; }
+void SimRadio::setChannel(uint8_t channel) { this->channel = channel; }
+uint8_t SimRadio::getChannel() { return this->channel; }
+void SimRadio::openReadingPipe(uint8_t pipe, uint64_t address) { this->reading_address = address; this->reading_pipe = pipe; this->is_reading = true; }
+void SimRadio::openWritingPipe(uint64_t address) { this->writing_address = address; }
+void SimRadio::closeReadingPipe(uint8_t pipe) { this->is_reading = false; }
+void SimRadio::startListening() { this->is_listening = true; }
+bool SimRadio::testCarrier() { return sim_medium().is_busy(this->channel); }
+bool SimRadio::testRPD() { return this->is_rpd; }
+uint8_t SimRadio::getARC() { return this->arc; }
+
+
+void SimRadio::stopListening() {
+
+    // the RF24 driver flushes pending ACK payloads before transmitting
+    if (true == this->is_ack_payload) {
+        this->flush_tx();
+    }
+
+    this->is_listening = false;
+}
+
+
+bool SimRadio::writeAckPayload(uint8_t pipe, const void* buffer, uint8_t size) {
+
+    if ((false == this->is_ack_payload) || (SIM_RADIO_FIFO_DEPTH <= this->ack_payloads.size())) {
+        return false;
+    }
+
+    const uint8_t* bytes = (const uint8_t*)buffer;
+    this->ack_payloads.emplace_back(bytes, bytes + size);
+
+    return true;
+}
+
+
+bool SimRadio::isAckPayloadAvailable() {
+
+    uint8_t pipe = 0;
+
+    return (true == this->available(&pipe)) && (0 == pipe);
+}
+
+
+bool SimRadio::write(const void* buffer, uint8_t size) {
+
+    return this->write(buffer, size, false);
+}
+
+
+bool SimRadio::write(const void* buffer, uint8_t size, const bool multicast) {
+
+    if (SIM_RADIO_PAYLOAD_MAX < size) {
+        return false;
+    }
+
+    int retries = sim_medium().transmit(this, (const uint8_t*)buffer, size);
+
+    // every attempt was used when the payload was not acknowledged
+    this->arc = (0 > retries) ? this->retry_count : (uint8_t)retries;
+
+    return 0 <= retries;
+}
+
+
+bool SimRadio::available() {
+
+    return (false == this->rx_fifo.empty()) && (this->rx_fifo.front().arrival_us <= shim_get_micros());
+}
+
+
+bool SimRadio::available(uint8_t* pipe) {
+
+    if (false == this->available()) {
+        return false;
+    }
+
+    if (nullptr != pipe) {
+        *pipe = this->rx_fifo.front().pipe;
+    }
+
+    return true;
+}
+
+
+void SimRadio::read(void* buffer, uint8_t size) {
+
+    if (false == this->available()) {
+        return;
+    }
+
+    const std::vector<uint8_t>& payload = this->rx_fifo.front().bytes;
+    memcpy(buffer, payload.data(), (size < payload.size()) ? size : payload.size());
+
+    this->rx_fifo.pop_front();
+}
+
+
+uint8_t SimRadio::getDynamicPayloadSize() {
+
+    return (false == this->available()) ? 0 : (uint8_t)this->rx_fifo.front().bytes.size();
+}
+
+
+bool SimRadio::rxFifoFull() {
+
+    return SIM_RADIO_FIFO_DEPTH <= this->rx_fifo.size();
+}
+
+
+uint8_t SimRadio::flush_rx() {
+
+    this->rx_fifo.clear();
+
+    return 0;
+}
+
+
+uint8_t SimRadio::flush_tx() {
+
+    this->ack_payloads.clear();
+
+    return 0;
+}
+
+
+uint64_t SimRadio::get_tx_attempts() const {
+
+    return this->tx_attempts;
+}
+
+
+uint64_t SimRadio::get_tx_us() const {
+
+    return this->tx_us;
+}
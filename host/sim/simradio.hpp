@@ -0,0 +1,225 @@
+/**
+* @brief: Contains the prototypes of the simulated radio and its medium.
+* @file: simradio.hpp
+*
+* SimRadio provides the RF24 member functions the firmware uses, so it can be
+* plugged into SensorNode and BaseStation in place of the hardware driver.
+* Every SimRadio on a thread shares that thread's SimMedium, which delivers
+* written payloads to the radio listening on the same channel, address and
+* data rate, drops attempts with a configurable probability and advances the
+* virtual clock by the time a real NRF24L01 would spend on air and in retries.
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _SIM_RADIO_HPP_
+#define _SIM_RADIO_HPP_
+
+// standard libraries
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <vector>
+
+// local dependencies
+#include "RF24.h"
+
+// number of payloads the NRF24L01 receive FIFO holds
+#define SIM_RADIO_FIFO_DEPTH 3
+
+// largest payload of the NRF24L01
+#define SIM_RADIO_PAYLOAD_MAX 32
+
+// on air overhead of a packet in bytes: preamble, address, control and CRC
+#define SIM_RADIO_OVERHEAD_BYTES 9
+
+// time to switch the radio between receive and transmit in microseconds
+#define SIM_RADIO_SETTLE_US 130
+
+// step of the automatic retransmit delay in microseconds
+#define SIM_RADIO_ARD_STEP_US 250
+
+
+class SimRadio;
+
+
+class SimMedium {
+
+    private:
+
+        std::vector<SimRadio*> radios;      // radios on the medium
+        std::minstd_rand generator;         // decides which attempts are lost
+        double loss = 0.0;                  // probability a single attempt is lost
+        uint64_t busy_until_us[128] = {0};  // end of the last transmission on each channel
+
+        uint64_t delivered = 0;             // payloads placed in a receive FIFO
+        uint64_t dropped_full = 0;          // payloads refused by a full receive FIFO
+        uint64_t dropped_lost = 0;          // payloads lost on every attempt
+        uint64_t dropped_no_listener = 0;   // payloads with no radio listening
+
+
+    public:
+
+        /**
+         * @brief Resets the medium to a lossless idle state
+         *
+         * @param seed: seed of the loss generator
+         */
+        void reset(uint32_t seed);
+
+        /**
+         * @brief Sets the probability that a single transmission attempt is lost
+         *
+         * @param loss: probability between 0 and 1
+         */
+        void set_loss(double loss);
+
+        /**
+         * @brief Adds a radio to the medium
+         *
+         * @param radio: radio to add
+         */
+        void attach(SimRadio* radio);
+
+        /**
+         * @brief Removes a radio from the medium
+         *
+         * @param radio: radio to remove
+         */
+        void detach(SimRadio* radio);
+
+        /**
+         * @brief Transmits a payload and advances the virtual clock by its air time
+         *
+         * @param sender: radio writing the payload
+         * @param buffer: payload
+         * @param size: size of payload
+         * @return Number of retransmissions, or a negative value if the payload was not acknowledged
+         */
+        int transmit(SimRadio* sender, const uint8_t* buffer, uint8_t size);
+
+        /**
+         * @brief Determines if a channel is carrying a transmission
+         *
+         * @param channel: channel to test
+         * @return True if the channel is busy. Otherwise false
+         */
+        bool is_busy(uint8_t channel);
+
+        /**
+         * @brief Gets delivery counters of the medium
+         *
+         * @return Value of the counter
+         */
+        uint64_t get_delivered() const;
+        uint64_t get_dropped_full() const;
+        uint64_t get_dropped_lost() const;
+        uint64_t get_dropped_no_listener() const;
+};
+
+
+/**
+ * @brief Gets the medium shared by every SimRadio on the current thread
+ *
+ * @return Medium of the current thread
+ */
+SimMedium& sim_medium();
+
+
+class SimRadio {
+
+    friend class SimMedium;
+
+    private:
+
+        // payload, the pipe it arrived on and the virtual time its transmission ended
+        struct rx_payload_t {
+            uint64_t arrival_us;
+            uint8_t pipe;
+            std::vector<uint8_t> bytes;
+        };
+
+        // payloads are only visible once they have arrived, so a device
+        // whose loop runs behind the sender cannot read them early
+        std::deque<rx_payload_t> rx_fifo;
+        uint8_t channel = 76;
+        uint8_t pa_level = RF24_PA_MAX;
+        rf24_datarate_e data_rate = RF24_1MBPS;
+        uint64_t reading_address = 0;
+        uint8_t reading_pipe = 1;
+        uint64_t writing_address = 0;
+
+        // payloads sent back with the next ACKs, sharing the TX FIFO like the NRF24L01
+        std::deque<std::vector<uint8_t>> ack_payloads;
+        bool is_ack_payload = false;
+        uint8_t retry_delay = 0;
+        uint8_t retry_count = 0;
+        uint8_t arc = 0;
+        bool is_reading = false;
+        bool is_listening = false;
+        bool is_rpd = false;    // a payload has been received above the power detector's threshold
+
+        uint64_t tx_attempts = 0;   // transmission attempts including retries
+        uint64_t tx_us = 0;         // time spent transmitting and waiting for ACKs
+
+
+    public:
+
+        SimRadio(uint16_t ce_pin, uint16_t csn_pin);
+        ~SimRadio();
+
+        SimRadio(const SimRadio&) = delete;
+        SimRadio& operator=(const SimRadio&) = delete;
+
+        bool begin();
+        void enableDynamicPayloads();
+        void enableAckPayload();
+        void enableDynamicAck();
+        void setAutoAck(bool enable);
+        void setRetries(uint8_t delay, uint8_t count);
+        void setAddressWidth(uint8_t width);
+        void setPALevel(uint8_t level, bool lna_enable = true);
+        uint8_t getPALevel();
+        bool setDataRate(rf24_datarate_e speed);
+        rf24_datarate_e getDataRate();
+        void setChannel(uint8_t channel);
+        uint8_t getChannel();
+
+        void openReadingPipe(uint8_t pipe, uint64_t address);
+        void openWritingPipe(uint64_t address);
+        void closeReadingPipe(uint8_t pipe);
+        void startListening();
+        void stopListening();
+
+        bool write(const void* buffer, uint8_t size);
+        bool write(const void* buffer, uint8_t size, const bool multicast);
+        bool writeAckPayload(uint8_t pipe, const void* buffer, uint8_t size);
+        bool isAckPayloadAvailable();
+
+        bool testCarrier();
+        bool testRPD();
+        bool available();
+        bool available(uint8_t* pipe);
+        void read(void* buffer, uint8_t size);
+        uint8_t getDynamicPayloadSize();
+        uint8_t getARC();
+        bool rxFifoFull();
+        uint8_t flush_rx();
+        uint8_t flush_tx();
+
+        /**
+         * @brief Gets the transmission attempts made by the radio, including retries
+         *
+         * @return Number of attempts
+         */
+        uint64_t get_tx_attempts() const;
+
+        /**
+         * @brief Gets the time the radio spent transmitting and waiting for ACKs
+         *
+         * @return Time in microseconds
+         */
+        uint64_t get_tx_us() const;
+};
+
+#endif // _SIM_RADIO_HPP_
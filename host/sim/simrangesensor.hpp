@@ -0,0 +1,126 @@
+/**
+* @brief: Contains the simulated ToF range sensor.
+* @file: simrangesensor.hpp
+*
+* SimRangeSensor provides the Adafruit_VL6180X member functions the firmware
+* uses, so it can be plugged into SensorNode in place of the hardware driver.
+* Readings are either set directly or played back from a recorded schedule
+* against the virtual clock, and every range read takes as long as a real
+* single shot measurement.
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _SIM_RANGE_SENSOR_HPP_
+#define _SIM_RANGE_SENSOR_HPP_
+
+// standard libraries
+#include <cstdint>
+#include <deque>
+
+// local dependencies
+#include "Adafruit_VL6180X.h"
+#include "shim.hpp"
+
+// time a single shot range measurement takes in microseconds
+#define SIM_RANGE_READ_US 10000
+
+
+class SimRangeSensor {
+
+    private:
+
+        // reading that takes effect at a given time
+        struct reading_t {
+            uint64_t time_us;
+            uint8_t range;
+            uint8_t status;
+        };
+
+        // readings that have not taken effect yet, in time order
+        std::deque<reading_t> schedule;
+
+        uint8_t range = 0;
+        uint8_t range_status = VL6180X_ERROR_NOCONVERGE;
+
+        // range measurements taken
+        uint64_t reads = 0;
+
+        /**
+         * @brief Applies every scheduled reading that is due
+         */
+        void apply_due() {
+            while ((false == this->schedule.empty()) && (this->schedule.front().time_us <= shim_get_micros())) {
+                this->range = this->schedule.front().range;
+                this->range_status = this->schedule.front().status;
+                this->schedule.pop_front();
+            }
+        }
+
+
+    public:
+
+        bool begin() { return true; }
+
+        uint8_t readRange() {
+            shim_advance_micros(SIM_RANGE_READ_US);
+            this->reads++;
+            this->apply_due();
+            return this->range;
+        }
+
+        uint8_t readRangeStatus() {
+            this->apply_due();
+            return this->range_status;
+        }
+
+        /**
+         * @brief Gets the number of range measurements taken
+         *
+         * @return Number of measurements
+         */
+        uint64_t get_reads() const {
+            return this->reads;
+        }
+
+        /**
+         * @brief Sets the result of the next range reads
+         *
+         * @param range: range in millimeters
+         * @param status: VL6180X range status
+         */
+        void set_reading(uint8_t range, uint8_t status) {
+            this->range = range;
+            this->range_status = status;
+        }
+
+        /**
+         * @brief Schedules a reading to take effect at a virtual time
+         *
+         * Readings must be scheduled in time order.
+         *
+         * @param time_us: virtual time in microseconds
+         * @param range: range in millimeters
+         * @param status: VL6180X range status
+         */
+        void schedule_reading(uint64_t time_us, uint8_t range, uint8_t status) {
+            this->schedule.push_back({time_us, range, status});
+        }
+
+        /**
+         * @brief Schedules a car arriving or leaving at a virtual time
+         *
+         * @param time_us: virtual time in microseconds
+         * @param is_vacant: if the space is vacant from then on
+         */
+        void schedule_vacancy(uint64_t time_us, bool is_vacant) {
+            if (true == is_vacant) {
+                this->schedule_reading(time_us, 0, VL6180X_ERROR_NOCONVERGE);
+            }
+            else {
+                this->schedule_reading(time_us, 50, VL6180X_ERROR_NONE);
+            }
+        }
+};
+
+#endif // _SIM_RANGE_SENSOR_HPP_
@@ -0,0 +1,140 @@
+/**
+* @brief: Contains the implementation of the WorkPool class.
+* @file: workpool.cpp
+*
+* @author: jkieltyka15
+*/
+
+// standard libraries
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+// local dependencies
+#include "workpool.hpp"
+
+
+WorkPool::WorkPool(size_t threads) {
+
+    if (0 == threads) {
+        threads = std::thread::hardware_concurrency();
+    }
+    if (0 == threads) {
+        threads = 1;
+    }
+
+    for (size_t i = 0; i < threads; i++) {
+        this->queues.push_back(std::unique_ptr<worker_queue_t>(new worker_queue_t()));
+    }
+
+    for (size_t i = 0; i < threads; i++) {
+        this->workers.emplace_back(&WorkPool::run, this, i);
+    }
+}
+
+
+WorkPool::~WorkPool() {
+
+    this->wait();
+
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->is_stopping = true;
+    }
+    this->work_ready.notify_all();
+
+    for (std::thread& worker : this->workers) {
+        worker.join();
+    }
+}
+
+
+void WorkPool::submit(std::function<void()> task) {
+
+    size_t index = this->next_queue++ % this->queues.size();
+
+    this->unfinished++;
+
+    // count the task before a worker can take it, so queued never drops below zero
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->queued++;
+
+        std::lock_guard<std::mutex> queue_lock(this->queues[index]->mutex);
+        this->queues[index]->tasks.push_back(std::move(task));
+    }
+    this->work_ready.notify_one();
+}
+
+
+void WorkPool::wait() {
+
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->work_done.wait(lock, [this] { return 0 == this->unfinished; });
+}
+
+
+size_t WorkPool::size() const {
+
+    return this->workers.size();
+}
+
+
+bool WorkPool::take(size_t worker, std::function<void()>& task) {
+
+    // newest task of this worker first
+    {
+        worker_queue_t& own = *this->queues[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (false == own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+
+    // oldest task of another worker
+    for (size_t i = 1; i < this->queues.size(); i++) {
+        worker_queue_t& victim = *this->queues[(worker + i) % this->queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (false == victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+void WorkPool::run(size_t worker) {
+
+    while (true) {
+
+        std::function<void()> task;
+        if (true == this->take(worker, task)) {
+
+            this->queued--;
+            task();
+
+            // wake waiters once the last task is done
+            std::lock_guard<std::mutex> lock(this->mutex);
+            if (0 == --this->unfinished) {
+                this->work_done.notify_all();
+            }
+            continue;
+        }
+
+        // sleep until there is something to take
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->work_ready.wait(lock, [this] { return (0 < this->queued) || (true == this->is_stopping); });
+
+        if ((true == this->is_stopping) && (0 == this->queued)) {
+            return;
+        }
+    }
+}
@@ -0,0 +1,104 @@
+/**
+* @brief: Contains the prototype of the WorkPool class.
+* @file: workpool.hpp
+*
+* A fixed set of worker threads with one task deque each. Workers take new
+* tasks from the back of their own deque and steal from the front of the
+* others when it runs dry, so long simulations do not leave cores idle while
+* short ones queue up behind them.
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _WORK_POOL_HPP_
+#define _WORK_POOL_HPP_
+
+// standard libraries
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+class WorkPool {
+
+    private:
+
+        // tasks owned by a single worker
+        struct worker_queue_t {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        std::vector<std::unique_ptr<worker_queue_t>> queues;
+        std::vector<std::thread> workers;
+
+        std::mutex mutex;                   // guards the condition variables
+        std::condition_variable work_ready; // signalled when tasks are submitted or the pool stops
+        std::condition_variable work_done;  // signalled when the last task finishes
+
+        std::atomic<size_t> queued{0};      // tasks waiting in any deque
+        std::atomic<size_t> unfinished{0};  // tasks submitted but not finished
+        std::atomic<size_t> next_queue{0};  // deque the next task is submitted to
+        bool is_stopping = false;
+
+        /**
+         * @brief Takes a task from a worker's own deque or steals one
+         *
+         * @param worker: index of the worker
+         * @param task: task that was taken
+         * @return True if a task was taken. Otherwise false
+         */
+        bool take(size_t worker, std::function<void()>& task);
+
+        /**
+         * @brief Runs tasks until the pool stops
+         *
+         * @param worker: index of the worker
+         */
+        void run(size_t worker);
+
+
+    public:
+
+        /**
+         * @brief Constructs a WorkPool object
+         *
+         * @param threads: number of worker threads. Zero uses every core
+         */
+        explicit WorkPool(size_t threads);
+
+        /**
+         * @brief Waits for all tasks and stops the workers
+         */
+        ~WorkPool();
+
+        WorkPool(const WorkPool&) = delete;
+        WorkPool& operator=(const WorkPool&) = delete;
+
+        /**
+         * @brief Queues a task
+         *
+         * @param task: task to run on a worker
+         */
+        void submit(std::function<void()> task);
+
+        /**
+         * @brief Waits until every submitted task has finished
+         */
+        void wait();
+
+        /**
+         * @brief Gets the number of worker threads
+         *
+         * @return Number of workers
+         */
+        size_t size() const;
+};
+
+#endif // _WORK_POOL_HPP_
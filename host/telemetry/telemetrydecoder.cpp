@@ -0,0 +1,324 @@
+/**
+* @brief: Contains the implementation of the TelemetryDecoder class.
+* @file: telemetrydecoder.cpp
+*
+* @author: jkieltyka15
+*/
+
+// standard libraries
+#include <cstdint>
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <utility>
+
+// local libraries
+#include <Telemetry.h>
+
+// local dependencies
+#include "telemetrydecoder.hpp"
+
+
+TelemetryDecoder::TelemetryDecoder(std::function<void(const telemetry_event_t&)> on_event)
+    : on_event(std::move(on_event)) {}
+
+
+void TelemetryDecoder::feed(const uint8_t* bytes, size_t size) {
+
+    for (size_t i = 0; i < size; i++) {
+
+        // delimiter completes a frame
+        if (COBS_DELIMITER == bytes[i]) {
+            this->decode_pending();
+            this->pending.clear();
+            continue;
+        }
+
+        // discard runs longer than any valid frame, such as text logs
+        if (COBS_ENCODED_MAX(TELEMETRY_FRAME_MAX) <= this->pending.size()) {
+            continue;
+        }
+
+        this->pending.push_back(bytes[i]);
+    }
+}
+
+
+void TelemetryDecoder::decode_pending() {
+
+    // back to back delimiters
+    if (true == this->pending.empty()) {
+        return;
+    }
+
+    TelemetryFrame frame = TelemetryFrame();
+    if (false == frame.decode(this->pending.data(), (uint16_t)this->pending.size())) {
+        this->bad_frames++;
+        return;
+    }
+
+    telemetry_event_t event;
+    if (false == this->parse(frame, event)) {
+        this->bad_frames++;
+        return;
+    }
+
+    // account for frames missing from the sequence
+    if (true == this->is_synced) {
+        this->lost_frames += (uint8_t)(event.seq - this->next_seq);
+    }
+
+    this->is_synced = true;
+    this->next_seq = event.seq + 1;
+    this->frames++;
+
+    if (this->on_event) {
+        this->on_event(event);
+    }
+}
+
+
+bool TelemetryDecoder::parse(TelemetryFrame& frame, telemetry_event_t& event) {
+
+    const uint8_t* payload = frame.get_payload();
+    uint8_t size = frame.get_payload_size();
+
+    event.type = frame.get_type();
+    event.seq = frame.get_seq();
+    event.timestamp_ms = frame.get_timestamp();
+    event.payload.assign(payload, payload + size);
+
+    switch (event.type) {
+
+        case TELEMETRY_BOOT:
+            if (1 > size) {
+                return false;
+            }
+            event.node_num = payload[0];
+            return true;
+
+        case TELEMETRY_STATE_CHANGE:
+            if (2 > size) {
+                return false;
+            }
+            event.node_id = payload[0];
+            event.is_vacant = (0 != payload[1]);
+
+            // older firmware only reports the status
+            event.has_latency = (5 <= size);
+            if (true == event.has_latency) {
+                event.latency_ms = telemetry_read_u16(&payload[2]);
+                event.hops = payload[4];
+            }
+            return true;
+
+        case TELEMETRY_COUNTERS:
+            if (10 > size) {
+                return false;
+            }
+            event.counters.rx_messages = telemetry_read_u16(&payload[0]);
+            event.counters.rx_rejected = telemetry_read_u16(&payload[2]);
+            event.counters.rx_unknown = telemetry_read_u16(&payload[4]);
+            event.counters.state_changes = telemetry_read_u16(&payload[6]);
+            event.counters.frames_dropped = telemetry_read_u16(&payload[8]);
+
+            // older firmware does not track liveness
+            event.has_stale = (12 <= size);
+            if (true == event.has_stale) {
+                event.counters.stale_events = telemetry_read_u16(&payload[10]);
+            }
+            return true;
+
+        case TELEMETRY_SNAPSHOT: {
+            if (2 > size) {
+                return false;
+            }
+            event.node_num = payload[0];
+            event.num_vacant = payload[1];
+
+            // bitmap must cover every node
+            if ((2 + (event.node_num + 7) / 8) > size) {
+                return false;
+            }
+
+            for (uint8_t i = 0; i < event.node_num; i++) {
+                event.vacancy.push_back(0 != (payload[2 + i / 8] & (1 << (i % 8))));
+            }
+
+            // older firmware does not track liveness
+            event.has_stale = ((3 + (event.node_num + 7) / 8) <= size);
+            if (true == event.has_stale) {
+                event.num_stale = payload[2 + (event.node_num + 7) / 8];
+            }
+            return true;
+        }
+
+        case TELEMETRY_NODE_STATS:
+            if (14 > size) {
+                return false;
+            }
+            event.node_id = payload[0];
+            event.stats.tx_attempts = telemetry_read_u16(&payload[1]);
+            event.stats.tx_failures = telemetry_read_u16(&payload[3]);
+            event.stats.arc_total = telemetry_read_u16(&payload[5]);
+            event.stats.carrier_busy = telemetry_read_u16(&payload[7]);
+            event.stats.relayed = telemetry_read_u16(&payload[9]);
+            event.stats.free_ram = telemetry_read_u16(&payload[11]);
+            event.stats.queue_high_water = payload[13];
+            return true;
+
+        case TELEMETRY_CAPTURE:
+            if (4 > size) {
+                return false;
+            }
+            event.capture_us = telemetry_read_u32(&payload[0]);
+            event.capture.assign(payload + 4, payload + size);
+            return true;
+
+        case TELEMETRY_LIVENESS:
+            if (6 > size) {
+                return false;
+            }
+            event.node_id = payload[0];
+            event.is_stale = (0 != payload[1]);
+            event.silent_ms = telemetry_read_u32(&payload[2]);
+            return true;
+
+        // unknown types are still reported with their raw payload
+        default:
+            return true;
+    }
+}
+
+
+uint64_t TelemetryDecoder::get_frames() const {
+
+    return this->frames;
+}
+
+
+uint64_t TelemetryDecoder::get_bad_frames() const {
+
+    return this->bad_frames;
+}
+
+
+uint64_t TelemetryDecoder::get_lost_frames() const {
+
+    return this->lost_frames;
+}
+
+
+/**
+ * @brief Formats bytes as a lower case hex string
+ *
+ * @param bytes: bytes to format
+ * @return Hex representation of the bytes
+ */
+static std::string to_hex(const std::vector<uint8_t>& bytes) {
+
+    static const char hex[] = "0123456789abcdef";
+
+    std::string str;
+    for (uint8_t byte : bytes) {
+        str += hex[byte >> 4];
+        str += hex[byte & 0x0F];
+    }
+
+    return str;
+}
+
+
+const char* telemetry_type_name(uint8_t type) {
+
+    switch (type) {
+        case TELEMETRY_BOOT:         return "boot";
+        case TELEMETRY_STATE_CHANGE: return "state_change";
+        case TELEMETRY_COUNTERS:     return "counters";
+        case TELEMETRY_SNAPSHOT:     return "snapshot";
+        case TELEMETRY_NODE_STATS:   return "node_stats";
+        case TELEMETRY_CAPTURE:      return "capture";
+        default:                     return "unknown";
+    }
+}
+
+
+std::string telemetry_event_to_json(const telemetry_event_t& event) {
+
+    std::ostringstream json;
+
+    json << "{\"type\":\"" << telemetry_type_name(event.type) << "\""
+         << ",\"seq\":" << (unsigned)event.seq
+         << ",\"t_ms\":" << event.timestamp_ms;
+
+    switch (event.type) {
+
+        case TELEMETRY_BOOT:
+            json << ",\"node_num\":" << (unsigned)event.node_num;
+            break;
+
+        case TELEMETRY_STATE_CHANGE:
+            json << ",\"node\":" << (unsigned)event.node_id
+                 << ",\"vacant\":" << (event.is_vacant ? "true" : "false");
+            if (true == event.has_latency) {
+                json << ",\"latency_ms\":" << event.latency_ms
+                     << ",\"hops\":" << (unsigned)event.hops;
+            }
+            break;
+
+        case TELEMETRY_COUNTERS:
+            json << ",\"rx_messages\":" << event.counters.rx_messages
+                 << ",\"rx_rejected\":" << event.counters.rx_rejected
+                 << ",\"rx_unknown\":" << event.counters.rx_unknown
+                 << ",\"state_changes\":" << event.counters.state_changes
+                 << ",\"frames_dropped\":" << event.counters.frames_dropped;
+            if (true == event.has_stale) {
+                json << ",\"stale_events\":" << event.counters.stale_events;
+            }
+            break;
+
+        case TELEMETRY_SNAPSHOT:
+            json << ",\"node_num\":" << (unsigned)event.node_num
+                 << ",\"num_vacant\":" << (unsigned)event.num_vacant
+                 << ",\"vacant\":[";
+            for (size_t i = 0; i < event.vacancy.size(); i++) {
+                json << (i ? "," : "") << (event.vacancy[i] ? "true" : "false");
+            }
+            json << "]";
+            if (true == event.has_stale) {
+                json << ",\"num_stale\":" << (unsigned)event.num_stale;
+            }
+            break;
+
+        case TELEMETRY_NODE_STATS:
+            json << ",\"node\":" << (unsigned)event.node_id
+                 << ",\"tx_attempts\":" << event.stats.tx_attempts
+                 << ",\"tx_failures\":" << event.stats.tx_failures
+                 << ",\"avg_arc\":"
+                 << ((0 == event.stats.tx_attempts) ? 0.0 : (double)event.stats.arc_total / event.stats.tx_attempts)
+                 << ",\"carrier_busy\":" << event.stats.carrier_busy
+                 << ",\"relayed\":" << event.stats.relayed
+                 << ",\"queue_high_water\":" << (unsigned)event.stats.queue_high_water
+                 << ",\"free_ram\":" << event.stats.free_ram;
+            break;
+
+        case TELEMETRY_LIVENESS:
+            json << ",\"node\":" << (unsigned)event.node_id
+                 << ",\"stale\":" << (event.is_stale ? "true" : "false")
+                 << ",\"silent_ms\":" << event.silent_ms;
+            break;
+
+        case TELEMETRY_CAPTURE:
+            json << ",\"t_us\":" << event.capture_us
+                 << ",\"raw\":\"" << to_hex(event.capture) << "\"";
+            break;
+
+        default:
+            json << ",\"raw\":\"" << to_hex(event.payload) << "\"";
+            break;
+    }
+
+    json << "}";
+
+    return json.str();
+}
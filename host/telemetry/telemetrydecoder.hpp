@@ -0,0 +1,150 @@
+/**
+* @brief: Contains the prototype of the TelemetryDecoder class.
+* @file: telemetrydecoder.hpp
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _TELEMETRY_DECODER_HPP_
+#define _TELEMETRY_DECODER_HPP_
+
+// standard libraries
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+// local libraries
+#include <Telemetry.h>
+
+
+// network statistics of a sensor node from a TELEMETRY_NODE_STATS frame
+struct telemetry_node_stats_t {
+    uint16_t tx_attempts = 0;
+    uint16_t tx_failures = 0;
+    uint16_t arc_total = 0;
+    uint16_t carrier_busy = 0;
+    uint16_t relayed = 0;
+    uint16_t free_ram = 0;
+    uint8_t queue_high_water = 0;
+};
+
+
+// structured event decoded from a single telemetry frame
+struct telemetry_event_t {
+
+    uint8_t type = 0;               // type of frame
+    uint8_t seq = 0;                // sequence number of frame
+    uint32_t timestamp_ms = 0;      // base station time the frame was created
+
+    uint8_t node_num = 0;           // TELEMETRY_BOOT and TELEMETRY_SNAPSHOT
+    uint8_t node_id = 0;            // TELEMETRY_STATE_CHANGE, TELEMETRY_NODE_STATS and TELEMETRY_LIVENESS
+    bool is_vacant = false;         // TELEMETRY_STATE_CHANGE
+    bool has_latency = false;       // TELEMETRY_STATE_CHANGE from firmware that reports latency
+    uint16_t latency_ms = 0;        // TELEMETRY_STATE_CHANGE sensor to paint latency
+    uint8_t hops = 0;               // TELEMETRY_STATE_CHANGE relays
+    telemetry_counters_t counters = {}; // TELEMETRY_COUNTERS
+    uint8_t num_vacant = 0;         // TELEMETRY_SNAPSHOT
+    std::vector<bool> vacancy;      // TELEMETRY_SNAPSHOT, index 0 is node 1
+    bool has_stale = false;         // TELEMETRY_SNAPSHOT and TELEMETRY_COUNTERS from firmware that tracks liveness
+    uint8_t num_stale = 0;          // TELEMETRY_SNAPSHOT
+    bool is_stale = false;          // TELEMETRY_LIVENESS
+    uint32_t silent_ms = 0;         // TELEMETRY_LIVENESS time since the node was last heard from
+    telemetry_node_stats_t stats;   // TELEMETRY_NODE_STATS
+    uint32_t capture_us = 0;        // TELEMETRY_CAPTURE receive time
+    std::vector<uint8_t> capture;   // TELEMETRY_CAPTURE raw radio payload
+
+    std::vector<uint8_t> payload;   // raw payload of the frame
+};
+
+
+class TelemetryDecoder {
+
+    private:
+
+        // called for every valid frame
+        std::function<void(const telemetry_event_t&)> on_event;
+
+        // encoded bytes received since the last delimiter
+        std::vector<uint8_t> pending;
+
+        uint64_t frames = 0;        // valid frames decoded
+        uint64_t bad_frames = 0;    // frames that failed COBS or CRC checks
+        uint64_t lost_frames = 0;   // frames missing from the sequence
+
+        bool is_synced = false;     // if a frame has been received to compare sequence numbers
+        uint8_t next_seq = 0;       // expected sequence number of the next frame
+
+        /**
+         * @brief Decodes a complete encoded frame and reports it
+         */
+        void decode_pending();
+
+        /**
+         * @brief Parses the payload of a frame into an event
+         *
+         * @param frame: valid frame
+         * @param event: event to fill
+         * @return True if the payload matched its type. Otherwise false
+         */
+        bool parse(TelemetryFrame& frame, telemetry_event_t& event);
+
+
+    public:
+
+        /**
+         * @brief Constructs a TelemetryDecoder object
+         *
+         * @param on_event: called with each decoded event
+         */
+        explicit TelemetryDecoder(std::function<void(const telemetry_event_t&)> on_event);
+
+        /**
+         * @brief Feeds bytes read from the serial stream to the decoder
+         *
+         * @param bytes: bytes read
+         * @param size: number of bytes
+         */
+        void feed(const uint8_t* bytes, size_t size);
+
+        /**
+         * @brief Gets the number of valid frames decoded
+         *
+         * @return Number of valid frames
+         */
+        uint64_t get_frames() const;
+
+        /**
+         * @brief Gets the number of frames that failed their integrity checks
+         *
+         * @return Number of bad frames
+         */
+        uint64_t get_bad_frames() const;
+
+        /**
+         * @brief Gets the number of frames inferred lost from sequence gaps
+         *
+         * @return Number of lost frames
+         */
+        uint64_t get_lost_frames() const;
+};
+
+
+/**
+ * @brief Gets the name of a frame type
+ *
+ * @param type: type of frame
+ * @return Name of the frame type
+ */
+const char* telemetry_type_name(uint8_t type);
+
+/**
+ * @brief Formats an event as a single line JSON object
+ *
+ * @param event: event to format
+ * @return JSON representation of the event
+ */
+std::string telemetry_event_to_json(const telemetry_event_t& event);
+
+#endif // _TELEMETRY_DECODER_HPP_
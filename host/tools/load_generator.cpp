@@ -0,0 +1,530 @@
+/**
+* @brief: Synthetic load generator for the base station ingest path.
+* @file: load_generator.cpp
+*
+* Usage: load_generator [--process poisson|burst|heartbeat] [--rate N]
+*                       [--nodes N] [--duration S] [--service-us N]
+*                       [--sweep] [--csv FILE] [--seed N]
+*
+* Drives the unmodified base_station_loop() of the firmware on the virtual
+* clock while simulated sensor nodes offer updates at a configurable rate:
+*
+*   poisson    status changes of random nodes as a Poisson process at N/s
+*   burst      shift changes. Every --burst-period seconds all nodes change
+*              status, arriving as a Poisson process at N/s
+*   heartbeat  every node sends a stats heartbeat every nodes/N seconds.
+*              --phase-spread 0 starts them together, 1 spreads them evenly
+*
+* A sender that finds the receive FIFO full retransmits like the NRF24L01,
+* up to --retries times --retry-delay apart, and the update is dropped
+* after that. Host execution is much faster than the ATmega328, so every
+* handled message costs --service-us of virtual time. Calibrate it with the
+* mean message phase printed by the profile build.
+*
+* Collisions and carrier sensing between senders are not modelled.
+*
+* @author: jkieltyka15
+*/
+
+// standard libraries
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+// local libraries
+#include <Message.h>
+#include <Telemetry.h>
+
+// local dependencies
+#include "basestation.hpp"
+#include "mainloop.hpp"
+#include "parkingdisplay.hpp"
+#include "shim.hpp"
+
+// ID of the base station
+#define BASE_STATION_ID 0
+
+// time one attempt and its ACK take on air at 1 Mbps in microseconds
+#define ATTEMPT_US 500
+
+// time in microseconds to keep running after the last arrival so queues drain
+#define DRAIN_US 10000000ULL
+
+
+// arrival processes
+enum process_t {
+    PROCESS_POISSON = 0,
+    PROCESS_BURST,
+    PROCESS_HEARTBEAT
+};
+
+
+// settings of a run
+struct config_t {
+    process_t process = PROCESS_POISSON;
+    double rate = 10.0;             // offered updates per second
+    uint16_t nodes = 10;            // number of sensor nodes
+    double duration_s = 60.0;       // time arrivals are offered for
+    double burst_period_s = 20.0;   // time between shift changes
+    double phase_spread = 1.0;      // spread of heartbeat phases within a period
+    uint32_t service_us = 2000;     // virtual cost of handling a message
+    uint8_t retries = 15;           // MAX_SEND_ATTEMPTS of the senders
+    uint8_t retry_delay = 15;       // FAILED_SEND_DELAY of the senders
+    uint32_t seed = 1;              // seed of the arrival generator
+    double max_drop = 0.001;        // largest drop ratio that is sustainable
+    double max_p99_ms = 1000.0;     // largest p99 queueing delay that is sustainable
+};
+
+
+// message offered by a sensor node
+struct arrival_t {
+    uint64_t time_us;       // time of the first attempt
+    uint8_t node_id;        // node sending the message
+    bool is_stats;          // heartbeat with statistics instead of an update
+    bool is_vacant;         // status carried by the message
+};
+
+
+// message waiting for its next attempt
+struct pending_t {
+    uint64_t next_us;       // time of the next attempt
+    uint64_t arrival_us;    // time of the first attempt
+    uint8_t attempts;       // attempts made so far
+    uint8_t node_id;
+    bool is_stats;
+    bool is_vacant;
+
+    bool operator>(const pending_t& other) const {
+        return this->next_us > other.next_us;
+    }
+};
+
+
+// outcome of a run
+struct result_t {
+    uint64_t offered = 0;           // messages offered by the senders
+    uint64_t handled = 0;           // messages handled by the base station
+    uint64_t dropped = 0;           // messages that ran out of retries
+    uint64_t retransmissions = 0;   // attempts refused by a full FIFO
+    uint64_t stale_spaces = 0;      // spaces showing the wrong status at the end
+    double throughput = 0.0;        // handled messages per second
+    double delay_p50_ms = 0.0;      // queueing delay percentiles
+    double delay_p90_ms = 0.0;
+    double delay_p99_ms = 0.0;
+    double delay_max_ms = 0.0;
+};
+
+
+/**
+ * @brief Generates the messages offered by the sensor nodes
+ *
+ * @param config: settings of the run
+ * @param truth: final status of every node, index 0 is node 1
+ * @return Messages in time order
+ */
+static std::vector<arrival_t> generate_arrivals(const config_t& config, std::vector<bool>& truth) {
+
+    std::mt19937_64 generator(config.seed);
+    std::uniform_int_distribution<uint16_t> pick_node(1, config.nodes);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::exponential_distribution<double> gap_s(config.rate);
+
+    std::vector<arrival_t> arrivals;
+    truth.assign(config.nodes, true);
+
+    const uint64_t duration_us = (uint64_t)(config.duration_s * 1e6);
+
+    switch (config.process) {
+
+        case PROCESS_POISSON: {
+            for (double t = gap_s(generator); t < config.duration_s; t += gap_s(generator)) {
+                uint8_t node_id = (uint8_t)pick_node(generator);
+                truth[node_id - 1] = !truth[node_id - 1];
+                arrivals.push_back({(uint64_t)(t * 1e6), node_id, false, truth[node_id - 1]});
+            }
+            break;
+        }
+
+        case PROCESS_BURST: {
+            for (double start = 0.0; start < config.duration_s; start += config.burst_period_s) {
+
+                // every node changes once in a random order
+                std::vector<uint8_t> order(config.nodes);
+                for (uint16_t i = 0; i < config.nodes; i++) {
+                    order[i] = (uint8_t)(i + 1);
+                }
+                std::shuffle(order.begin(), order.end(), generator);
+
+                double t = start;
+                for (uint8_t node_id : order) {
+                    t += gap_s(generator);
+                    truth[node_id - 1] = !truth[node_id - 1];
+                    arrivals.push_back({(uint64_t)(t * 1e6), node_id, false, truth[node_id - 1]});
+                }
+            }
+            break;
+        }
+
+        case PROCESS_HEARTBEAT: {
+            double period_s = config.nodes / config.rate;
+            for (uint16_t node = 1; node <= config.nodes; node++) {
+                double phase_s = uniform(generator) * period_s * config.phase_spread;
+                for (double t = phase_s; t < config.duration_s; t += period_s) {
+                    arrivals.push_back({(uint64_t)(t * 1e6), (uint8_t)node, true, true});
+                }
+            }
+            break;
+        }
+    }
+
+    std::stable_sort(arrivals.begin(), arrivals.end(),
+        [](const arrival_t& a, const arrival_t& b) { return a.time_us < b.time_us; });
+
+    // bursts can run past the end of the run
+    while ((false == arrivals.empty()) && (duration_us < arrivals.back().time_us)) {
+        arrivals.pop_back();
+    }
+
+    // recompute the final status from what was actually offered
+    truth.assign(config.nodes, true);
+    for (const arrival_t& arrival : arrivals) {
+        if (false == arrival.is_stats) {
+            truth[arrival.node_id - 1] = arrival.is_vacant;
+        }
+    }
+
+    return arrivals;
+}
+
+
+/**
+ * @brief Gets a percentile of sorted samples
+ *
+ * @param sorted: samples in ascending order
+ * @param percentile: percentile between 0 and 100
+ * @return Value of the percentile
+ */
+static double percentile(const std::vector<double>& sorted, double percentile) {
+
+    if (true == sorted.empty()) {
+        return 0.0;
+    }
+
+    size_t index = (size_t)((percentile / 100.0) * (sorted.size() - 1) + 0.5);
+    return sorted[index];
+}
+
+
+/**
+ * @brief Runs the base station loop against the offered load
+ *
+ * @param config: settings of the run
+ * @return Outcome of the run
+ */
+static result_t run(const config_t& config) {
+
+    std::vector<bool> truth;
+    std::vector<arrival_t> arrivals = generate_arrivals(config, truth);
+
+    shim_set_micros(0);
+    shim_eeprom_erase();
+
+    BaseStation<RF24> base_station = BaseStation<RF24>(BASE_STATION_ID);
+    (void) base_station.init();
+    (void) init_parking_display();
+    draw_parking_map();
+
+    RF24& radio = base_station.get_radio();
+    telemetry_counters_t counters = {};
+
+    std::priority_queue<pending_t, std::vector<pending_t>, std::greater<pending_t>> pending;
+    std::deque<uint64_t> fifo_arrivals;     // first attempt time of each payload in the FIFO
+    std::vector<double> delays_ms;
+    size_t next_arrival = 0;
+
+    result_t result;
+    result.offered = arrivals.size();
+
+    const uint64_t retry_us = (uint64_t)(config.retry_delay + 1) * 250 + ATTEMPT_US;
+    const uint64_t end_us = (uint64_t)(config.duration_s * 1e6) + DRAIN_US;
+
+    // makes every attempt up to a time against the current FIFO
+    auto attempt_until = [&](uint64_t time_us) {
+
+        while (true) {
+
+            // new messages join the senders waiting to retry
+            while ((next_arrival < arrivals.size()) && (arrivals[next_arrival].time_us <= time_us)) {
+                const arrival_t& arrival = arrivals[next_arrival++];
+                pending.push({arrival.time_us, arrival.time_us, 0,
+                    arrival.node_id, arrival.is_stats, arrival.is_vacant});
+            }
+
+            if ((true == pending.empty()) || (time_us < pending.top().next_us)) {
+                return;
+            }
+
+            pending_t tx = pending.top();
+            pending.pop();
+
+            uint8_t buffer[MSG_BUFFER_SIZE];
+            uint8_t size;
+            if (true == tx.is_stats) {
+                node_stats_t stats = {};
+                StatsMessage msg = StatsMessage(BASE_STATION_ID, tx.node_id, tx.node_id, tx.is_vacant, &stats);
+                memcpy(buffer, &msg, sizeof(msg));
+                size = sizeof(msg);
+            }
+            else {
+                UpdateMessage msg = UpdateMessage(BASE_STATION_ID, tx.node_id, tx.node_id, tx.is_vacant);
+                memcpy(buffer, &msg, sizeof(msg));
+                size = sizeof(msg);
+            }
+
+            if (true == radio.inject(buffer, size)) {
+                fifo_arrivals.push_back(tx.arrival_us);
+                continue;
+            }
+
+            // the FIFO is full so the sender retries or gives up
+            result.retransmissions++;
+            tx.attempts++;
+            if (config.retries < tx.attempts) {
+                result.dropped++;
+                continue;
+            }
+
+            tx.next_us += retry_us;
+            pending.push(tx);
+        }
+    };
+
+    while (shim_get_micros() < end_us) {
+
+        uint64_t start_us = shim_get_micros();
+        attempt_until(start_us);
+
+        // stop once everything offered has been handled
+        if ((next_arrival == arrivals.size()) && (true == pending.empty()) && (true == fifo_arrivals.empty())
+            && ((uint64_t)(config.duration_s * 1e6) <= start_us)) {
+            break;
+        }
+
+        uint16_t rx_messages = counters.rx_messages;
+        base_station_loop(&base_station, &counters);
+
+        // a message was read at the start of the iteration
+        if (rx_messages != counters.rx_messages) {
+            delays_ms.push_back((start_us - fifo_arrivals.front()) / 1000.0);
+            fifo_arrivals.pop_front();
+            result.handled++;
+            shim_advance_micros(config.service_us);
+        }
+
+        attempt_until(shim_get_micros());
+    }
+
+    // senders still waiting at the end count as dropped
+    result.dropped += pending.size() + (arrivals.size() - next_arrival);
+
+    for (uint16_t node_id = 1; node_id <= config.nodes; node_id++) {
+        if (base_station.get_node_status((uint8_t)node_id) != truth[node_id - 1]) {
+            result.stale_spaces++;
+        }
+    }
+
+    std::sort(delays_ms.begin(), delays_ms.end());
+    result.throughput = result.handled / config.duration_s;
+    result.delay_p50_ms = percentile(delays_ms, 50);
+    result.delay_p90_ms = percentile(delays_ms, 90);
+    result.delay_p99_ms = percentile(delays_ms, 99);
+    result.delay_max_ms = (true == delays_ms.empty()) ? 0.0 : delays_ms.back();
+
+    return result;
+}
+
+
+/**
+ * @brief Determines if a run kept up with its offered load
+ *
+ * @param config: settings of the run
+ * @param result: outcome of the run
+ * @return True if the load was sustained. Otherwise false
+ */
+static bool is_sustained(const config_t& config, const result_t& result) {
+
+    double drop_ratio = (0 == result.offered) ? 0.0 : (double)result.dropped / result.offered;
+
+    return (drop_ratio <= config.max_drop) && (result.delay_p99_ms <= config.max_p99_ms);
+}
+
+
+/**
+ * @brief Prints the outcome of a run as a CSV row
+ *
+ * @param out: stream to print to
+ * @param config: settings of the run
+ * @param result: outcome of the run
+ */
+static void print_row(std::ostream& out, const config_t& config, const result_t& result) {
+
+    out << config.rate << "," << result.offered << "," << result.handled << ","
+        << result.dropped << "," << result.retransmissions << "," << result.stale_spaces << ","
+        << result.throughput << "," << result.delay_p50_ms << "," << result.delay_p90_ms << ","
+        << result.delay_p99_ms << "," << result.delay_max_ms << ","
+        << (is_sustained(config, result) ? 1 : 0) << std::endl;
+}
+
+
+int main(int argc, char** argv) {
+
+    config_t config;
+    bool is_sweep = false;
+    std::string csv_path;
+
+    // parse arguments
+    for (int i = 1; i < argc; i++) {
+
+        std::string arg = argv[i];
+        bool has_value = (i + 1 < argc);
+
+        if (("--process" == arg) && has_value) {
+            std::string process = argv[++i];
+            if ("poisson" == process) {
+                config.process = PROCESS_POISSON;
+            }
+            else if ("burst" == process) {
+                config.process = PROCESS_BURST;
+            }
+            else if ("heartbeat" == process) {
+                config.process = PROCESS_HEARTBEAT;
+            }
+            else {
+                std::cerr << "unknown process " << process << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+        else if (("--rate" == arg) && has_value) {
+            config.rate = strtod(argv[++i], nullptr);
+        }
+        else if (("--nodes" == arg) && has_value) {
+            config.nodes = (uint16_t)strtoul(argv[++i], nullptr, 10);
+        }
+        else if (("--duration" == arg) && has_value) {
+            config.duration_s = strtod(argv[++i], nullptr);
+        }
+        else if (("--burst-period" == arg) && has_value) {
+            config.burst_period_s = strtod(argv[++i], nullptr);
+        }
+        else if (("--phase-spread" == arg) && has_value) {
+            config.phase_spread = strtod(argv[++i], nullptr);
+        }
+        else if (("--service-us" == arg) && has_value) {
+            config.service_us = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        }
+        else if (("--retries" == arg) && has_value) {
+            config.retries = (uint8_t)strtoul(argv[++i], nullptr, 10);
+        }
+        else if (("--retry-delay" == arg) && has_value) {
+            config.retry_delay = (uint8_t)strtoul(argv[++i], nullptr, 10);
+        }
+        else if (("--seed" == arg) && has_value) {
+            config.seed = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        }
+        else if (("--max-drop" == arg) && has_value) {
+            config.max_drop = strtod(argv[++i], nullptr);
+        }
+        else if (("--max-p99-ms" == arg) && has_value) {
+            config.max_p99_ms = strtod(argv[++i], nullptr);
+        }
+        else if (("--csv" == arg) && has_value) {
+            csv_path = argv[++i];
+        }
+        else if ("--sweep" == arg) {
+            is_sweep = true;
+        }
+        else {
+            std::cerr << "usage: " << argv[0] << " [--process poisson|burst|heartbeat] [--rate N]"
+                      << " [--nodes N] [--duration S] [--burst-period S] [--phase-spread F]"
+                      << " [--service-us N] [--retries N] [--retry-delay N] [--seed N]"
+                      << " [--max-drop F] [--max-p99-ms N] [--sweep] [--csv FILE]" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    if ((0 == config.nodes) || (SENSOR_NODE_NUM < config.nodes) || (0.0 >= config.rate) || (0.0 >= config.duration_s)) {
+        std::cerr << "nodes must be 1 to " << SENSOR_NODE_NUM << ", rate and duration must be positive" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::ofstream csv;
+    if (false == csv_path.empty()) {
+        csv.open(csv_path);
+        if (false == csv.is_open()) {
+            std::cerr << "failed to open " << csv_path << ": " << strerror(errno) << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    const char* header = "rate,offered,handled,dropped,retransmissions,stale_spaces,"
+                         "throughput,delay_p50_ms,delay_p90_ms,delay_p99_ms,delay_max_ms,sustained";
+    std::cout << header << std::endl;
+    if (true == csv.is_open()) {
+        csv << header << std::endl;
+    }
+
+    auto report = [&](const config_t& run_config, const result_t& result) {
+        print_row(std::cout, run_config, result);
+        if (true == csv.is_open()) {
+            print_row(csv, run_config, result);
+        }
+    };
+
+    if (false == is_sweep) {
+        report(config, run(config));
+        return EXIT_SUCCESS;
+    }
+
+    // double the rate until it is no longer sustained
+    config_t probe = config;
+    double sustained_rate = 0.0;
+    double failed_rate = 0.0;
+
+    for (probe.rate = config.rate; probe.rate < 1e6; probe.rate *= 2) {
+        result_t result = run(probe);
+        report(probe, result);
+        if (false == is_sustained(probe, result)) {
+            failed_rate = probe.rate;
+            break;
+        }
+        sustained_rate = probe.rate;
+    }
+
+    // narrow down the boundary
+    for (int i = 0; (i < 8) && (0.0 < failed_rate); i++) {
+        probe.rate = (0.0 == sustained_rate) ? failed_rate / 2 : (sustained_rate + failed_rate) / 2;
+        result_t result = run(probe);
+        report(probe, result);
+        if (true == is_sustained(probe, result)) {
+            sustained_rate = probe.rate;
+        }
+        else {
+            failed_rate = probe.rate;
+        }
+    }
+
+    std::cerr << "sustainable rate: " << sustained_rate << " updates/s" << std::endl;
+
+    return EXIT_SUCCESS;
+}
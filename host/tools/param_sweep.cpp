@@ -0,0 +1,519 @@
+/**
+* @brief: Sweeps sensor node timing settings over simulated parking lots.
+* @file: param_sweep.cpp
+*
+* Usage: param_sweep [--max-send-attempts LIST] [--failed-send-delay LIST]
+*                    [--busy-delay-min LIST] [--busy-delay-max LIST]
+*                    [--heartbeat-loops LIST] [--loop-delay-min LIST]
+*                    [--loop-delay-max LIST] [--lot-sizes LIST] [--rates LIST]
+*                    [--loss P] [--seeds N] [--duration S] [--threads N]
+*                    [--out FILE]
+*
+* Every combination of the comma separated lists is run as an independent
+* simulated lot: the unmodified sensor_node_loop() and base_station_loop()
+* of the firmware on SimRadio and SimRangeSensor, with each device keeping
+* its own place on the virtual clock. Cars arrive and leave as a Poisson
+* process at the given rate across the lot. Simulations run in parallel on a
+* work stealing pool and one CSV row is written per simulation with:
+*
+*   latency     time from a car arriving or leaving to the base station showing it,
+*               next to the longest latency the firmware measured itself
+*   throughput  messages per second read by the base station
+*   energy      radio and range sensor energy per node per hour, from typical
+*               datasheet currents at 3.3 V
+*
+* Lot sizes take nodes in order of their distance from the base station on
+* the static parking map, so every node in a smaller lot still has a route.
+*
+* @author: jkieltyka15
+*/
+
+// standard libraries
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// local libraries
+#include <Message.h>
+
+// local dependencies
+#include "mainloop.hpp"
+#include "nodetiming.hpp"
+#include "sensornode.hpp"
+#include "shim.hpp"
+#include "simbasestation.hpp"
+#include "simradio.hpp"
+#include "simrangesensor.hpp"
+#include "workpool.hpp"
+
+#define SUPPLY_V 3.3        // supply voltage of a sensor node
+#define RADIO_RX_MA 13.5    // NRF24L01 current while listening
+#define RADIO_TX_MA 11.3    // NRF24L01 current while transmitting at 0 dBm
+#define TOF_READ_MA 1.7     // VL6180X current while ranging
+
+// largest retry count and retry delay of the NRF24L01 auto retransmit
+#define RADIO_RETRIES_MAX 15
+
+// sensor nodes of the static parking map ordered by hops to the base station
+static const uint8_t route_order[] = { 1, 4, 2, 3, 5, 7, 6, 8, 10, 9 };
+
+// largest lot the static parking map supports
+#define LOT_SIZE_MAX (sizeof(route_order) / sizeof(route_order[0]))
+
+
+typedef SensorNode<SimRadio, SimRangeSensor> SimSensorNode;
+
+
+// settings of a single simulation
+struct sweep_point_t {
+    node_timing_t timing;
+    uint8_t lot_size;
+    double rate;            // cars arriving or leaving per second across the lot
+    double loss;            // probability a single transmission attempt is lost
+    uint32_t seed;
+};
+
+
+// outcome of a single simulation
+struct sweep_result_t {
+    uint64_t changes = 0;       // cars arriving or leaving
+    uint64_t delivered = 0;     // changes shown by the base station
+    uint64_t superseded = 0;    // changes replaced by a newer one before being shown
+    uint64_t undelivered = 0;   // changes not shown by the end of the run
+    double latency_p50_ms = 0.0;
+    double latency_p90_ms = 0.0;
+    double latency_p99_ms = 0.0;
+    double latency_max_ms = 0.0;
+    double fw_latency_max_ms = 0.0;     // longest latency the base station firmware recorded itself
+    double rx_per_s = 0.0;              // messages read by the base station per second
+    double tx_attempts_per_node = 0.0;  // radio attempts including retries
+    double energy_mj_per_node_hour = 0.0;
+    double tx_air_ms_per_node_hour = 0.0;
+};
+
+
+// change of a parking space
+struct change_t {
+    uint64_t time_us;
+    uint8_t index;      // index of the node in the lot
+    bool is_vacant;
+};
+
+
+/**
+ * @brief Gets a percentile of sorted samples
+ *
+ * @param sorted: samples in ascending order
+ * @param percentile: percentile between 0 and 100
+ * @return Value of the percentile
+ */
+static double percentile(const std::vector<double>& sorted, double percentile) {
+
+    if (true == sorted.empty()) {
+        return 0.0;
+    }
+
+    size_t index = (size_t)((percentile / 100.0) * (sorted.size() - 1) + 0.5);
+    return sorted[index];
+}
+
+
+/**
+ * @brief Runs one simulated lot
+ *
+ * @param point: settings of the simulation
+ * @param duration_s: virtual time to simulate in seconds
+ * @return Outcome of the simulation
+ */
+static sweep_result_t run_point(const sweep_point_t& point, double duration_s) {
+
+    shim_set_micros(0);
+    shim_eeprom_erase();
+    randomSeed(point.seed);
+    sim_medium().reset(point.seed);
+    sim_medium().set_loss(point.loss);
+
+    SimBaseStation base_station = SimBaseStation(0);
+    (void) base_station.init();
+
+    std::vector<std::unique_ptr<SimSensorNode>> nodes;
+    for (uint8_t i = 0; i < point.lot_size; i++) {
+        nodes.emplace_back(new SimSensorNode(route_order[i]));
+        nodes.back()->set_timing(&point.timing);
+        (void) nodes.back()->init();
+    }
+
+    const uint64_t end_us = (uint64_t)(duration_s * 1e6);
+
+    // cars arriving and leaving across the lot
+    std::mt19937_64 generator(point.seed);
+    std::exponential_distribution<double> gap_s(point.rate);
+    std::uniform_int_distribution<int> pick(0, point.lot_size - 1);
+    std::vector<bool> is_vacant(point.lot_size, true);
+    std::vector<change_t> changes;
+
+    for (double t = gap_s(generator); t < duration_s; t += gap_s(generator)) {
+        uint8_t index = (uint8_t)pick(generator);
+        is_vacant[index] = !is_vacant[index];
+        changes.push_back({(uint64_t)(t * 1e6), index, is_vacant[index]});
+        nodes[index]->get_sensor().schedule_vacancy(changes.back().time_us, is_vacant[index]);
+    }
+
+    // time each device is next ready to run, the base station is last
+    std::vector<uint64_t> ready_us(point.lot_size + 1, 0);
+    std::vector<uint8_t> loops(point.lot_size, 0);
+
+    // newest change of each node that is not shown yet
+    std::vector<bool> is_pending(point.lot_size, false);
+    std::vector<change_t> pending(point.lot_size);
+    size_t next_change = 0;
+
+    sweep_result_t result;
+    result.changes = changes.size();
+    std::vector<double> latencies_ms;
+
+    while (true) {
+
+        // run the device that is furthest behind
+        size_t device = std::min_element(ready_us.begin(), ready_us.end()) - ready_us.begin();
+        uint64_t now_us = ready_us[device];
+        if (end_us <= now_us) {
+            break;
+        }
+
+        // changes that have happened by now
+        while ((next_change < changes.size()) && (changes[next_change].time_us <= now_us)) {
+
+            const change_t& change = changes[next_change++];
+            uint8_t node_id = route_order[change.index];
+
+            if (true == is_pending[change.index]) {
+                result.superseded++;
+            }
+
+            // the base station already shows it if a change was undone before being sent
+            is_pending[change.index] = (base_station.get_node_status(node_id) != change.is_vacant);
+            if (false == is_pending[change.index]) {
+                result.superseded++;
+            }
+            pending[change.index] = change;
+        }
+
+        shim_set_micros(now_us);
+
+        if (point.lot_size == device) {
+
+            base_station.loop();
+
+            for (uint8_t i = 0; i < point.lot_size; i++) {
+                if ((true == is_pending[i]) && (base_station.get_node_status(route_order[i]) == pending[i].is_vacant)) {
+                    latencies_ms.push_back((shim_get_micros() - pending[i].time_us) / 1000.0);
+                    result.delivered++;
+                    is_pending[i] = false;
+                }
+            }
+        }
+        else {
+            sensor_node_loop(nodes[device].get(), &loops[device]);
+        }
+
+        ready_us[device] = shim_get_micros();
+    }
+
+    for (uint8_t i = 0; i < point.lot_size; i++) {
+        if (true == is_pending[i]) {
+            result.undelivered++;
+        }
+    }
+
+    // changes after the last device ran were never seen
+    result.undelivered += changes.size() - next_change;
+
+    std::sort(latencies_ms.begin(), latencies_ms.end());
+    result.latency_p50_ms = percentile(latencies_ms, 50);
+    result.latency_p90_ms = percentile(latencies_ms, 90);
+    result.latency_p99_ms = percentile(latencies_ms, 99);
+    result.latency_max_ms = (true == latencies_ms.empty()) ? 0.0 : latencies_ms.back();
+    result.rx_per_s = base_station.get_rx_messages() / duration_s;
+
+    for (uint8_t i = 0; i < point.lot_size; i++) {
+        result.fw_latency_max_ms = std::max(result.fw_latency_max_ms, (double)base_station.get_latency_max_ms(route_order[i]));
+    }
+
+    // energy of the radio and range sensor of every node
+    double energy_mj = 0.0;
+    double tx_s = 0.0;
+    uint64_t tx_attempts = 0;
+    for (std::unique_ptr<SimSensorNode>& node : nodes) {
+
+        double node_tx_s = node->get_radio().get_tx_us() / 1e6;
+        double read_s = node->get_sensor().get_reads() * (SIM_RANGE_READ_US / 1e6);
+
+        energy_mj += SUPPLY_V * ((RADIO_RX_MA * (duration_s - node_tx_s)) + (RADIO_TX_MA * node_tx_s) + (TOF_READ_MA * read_s));
+        tx_s += node_tx_s;
+        tx_attempts += node->get_radio().get_tx_attempts();
+    }
+
+    double hours = duration_s / 3600.0;
+    result.tx_attempts_per_node = (double)tx_attempts / point.lot_size;
+    result.energy_mj_per_node_hour = energy_mj / point.lot_size / hours;
+    result.tx_air_ms_per_node_hour = (tx_s * 1000.0) / point.lot_size / hours;
+
+    return result;
+}
+
+
+/**
+ * @brief Parses a comma separated list of numbers within a range
+ *
+ * @param option: name of the option the list was given to
+ * @param str: list to parse
+ * @param min: smallest value allowed
+ * @param max: largest value allowed
+ * @param values: numbers in the list
+ * @return true if the list is not empty and every number is in range, false otherwise
+ */
+static bool parse_list(const std::string& option, const std::string& str, double min, double max, std::vector<double>* values) {
+
+    std::stringstream stream(str);
+    std::string item;
+
+    values->clear();
+    while (std::getline(stream, item, ',')) {
+
+        if (true == item.empty()) {
+            continue;
+        }
+
+        char* end = nullptr;
+        double value = strtod(item.c_str(), &end);
+        if (('\0' != *end) || (min > value) || (max < value)) {
+            std::cerr << option << " values must be " << min << " to " << max << ", got " << item << std::endl;
+            return false;
+        }
+
+        values->push_back(value);
+    }
+
+    if (true == values->empty()) {
+        std::cerr << option << " needs at least one value" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+int main(int argc, char** argv) {
+
+    node_timing_t defaults;
+
+    std::vector<double> max_send_attempts = { (double)defaults.max_send_attempts };
+    std::vector<double> failed_send_delay = { (double)defaults.failed_send_delay };
+    std::vector<double> busy_delay_min = { (double)defaults.channel_busy_delay_min_ms };
+    std::vector<double> busy_delay_max = { (double)defaults.channel_busy_delay_max_ms };
+    std::vector<double> heartbeat_loops = { (double)defaults.loops_before_heartbeat };
+    std::vector<double> loop_delay_min = { (double)defaults.main_loop_delay_min_ms };
+    std::vector<double> loop_delay_max = { (double)defaults.main_loop_delay_max_ms };
+    std::vector<double> lot_sizes = { (double)LOT_SIZE_MAX };
+    std::vector<double> rates = { 0.1 };
+    double loss = 0.0;
+    uint32_t seeds = 1;
+    double duration_s = 600.0;
+    size_t threads = 0;
+    std::string out_path;
+
+    // parse arguments
+    for (int i = 1; i < argc; i++) {
+
+        std::string arg = argv[i];
+        bool has_value = (i + 1 < argc);
+
+        if (("--max-send-attempts" == arg) && has_value) {
+            if (false == parse_list(arg, argv[++i], 0, RADIO_RETRIES_MAX, &max_send_attempts)) {
+                return EXIT_FAILURE;
+            }
+        }
+        else if (("--failed-send-delay" == arg) && has_value) {
+            if (false == parse_list(arg, argv[++i], 0, RADIO_RETRIES_MAX, &failed_send_delay)) {
+                return EXIT_FAILURE;
+            }
+        }
+        else if (("--busy-delay-min" == arg) && has_value) {
+            if (false == parse_list(arg, argv[++i], 0, UINT16_MAX, &busy_delay_min)) {
+                return EXIT_FAILURE;
+            }
+        }
+        else if (("--busy-delay-max" == arg) && has_value) {
+            if (false == parse_list(arg, argv[++i], 0, UINT16_MAX, &busy_delay_max)) {
+                return EXIT_FAILURE;
+            }
+        }
+        else if (("--heartbeat-loops" == arg) && has_value) {
+            if (false == parse_list(arg, argv[++i], 1, UINT8_MAX, &heartbeat_loops)) {
+                return EXIT_FAILURE;
+            }
+        }
+        else if (("--loop-delay-min" == arg) && has_value) {
+            if (false == parse_list(arg, argv[++i], 0, UINT16_MAX, &loop_delay_min)) {
+                return EXIT_FAILURE;
+            }
+        }
+        else if (("--loop-delay-max" == arg) && has_value) {
+            if (false == parse_list(arg, argv[++i], 0, UINT16_MAX, &loop_delay_max)) {
+                return EXIT_FAILURE;
+            }
+        }
+        else if (("--lot-sizes" == arg) && has_value) {
+            if (false == parse_list(arg, argv[++i], 1, LOT_SIZE_MAX, &lot_sizes)) {
+                return EXIT_FAILURE;
+            }
+        }
+        else if (("--rates" == arg) && has_value) {
+            if (false == parse_list(arg, argv[++i], 0, HUGE_VAL, &rates)) {
+                return EXIT_FAILURE;
+            }
+        }
+        else if (("--loss" == arg) && has_value) {
+            loss = strtod(argv[++i], nullptr);
+        }
+        else if (("--seeds" == arg) && has_value) {
+            seeds = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        }
+        else if (("--duration" == arg) && has_value) {
+            duration_s = strtod(argv[++i], nullptr);
+        }
+        else if (("--threads" == arg) && has_value) {
+            threads = (size_t)strtoul(argv[++i], nullptr, 10);
+        }
+        else if (("--out" == arg) && has_value) {
+            out_path = argv[++i];
+        }
+        else {
+            std::cerr << "usage: " << argv[0] << " [--max-send-attempts LIST] [--failed-send-delay LIST]"
+                      << " [--busy-delay-min LIST] [--busy-delay-max LIST] [--heartbeat-loops LIST]"
+                      << " [--loop-delay-min LIST] [--loop-delay-max LIST] [--lot-sizes LIST]"
+                      << " [--rates LIST] [--loss P] [--seeds N] [--duration S] [--threads N]"
+                      << " [--out FILE]" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    if ((0.0 >= *std::min_element(rates.begin(), rates.end())) || (0.0 > loss) || (1.0 < loss)
+        || (0.0 >= duration_s) || (0 == seeds)) {
+        std::cerr << "rates and duration must be positive, loss must be 0 to 1 and seeds at least 1" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // build the grid, skipping delay ranges that are empty
+    std::vector<sweep_point_t> points;
+    size_t skipped = 0;
+    for (double attempts : max_send_attempts)
+    for (double send_delay : failed_send_delay)
+    for (double busy_min : busy_delay_min)
+    for (double busy_max : busy_delay_max)
+    for (double heartbeat : heartbeat_loops)
+    for (double loop_min : loop_delay_min)
+    for (double loop_max : loop_delay_max)
+    for (double lot_size : lot_sizes)
+    for (double rate : rates)
+    for (uint32_t seed = 1; seed <= seeds; seed++) {
+
+        if ((busy_max <= busy_min) || (loop_max <= loop_min)) {
+            skipped++;
+            continue;
+        }
+
+        sweep_point_t point;
+        point.timing.max_send_attempts = (uint8_t)attempts;
+        point.timing.failed_send_delay = (uint8_t)send_delay;
+        point.timing.channel_busy_delay_min_ms = (uint16_t)busy_min;
+        point.timing.channel_busy_delay_max_ms = (uint16_t)busy_max;
+        point.timing.loops_before_heartbeat = (uint8_t)heartbeat;
+        point.timing.main_loop_delay_min_ms = (uint16_t)loop_min;
+        point.timing.main_loop_delay_max_ms = (uint16_t)loop_max;
+        point.lot_size = (uint8_t)lot_size;
+        point.rate = rate;
+        point.loss = loss;
+        point.seed = seed;
+        points.push_back(point);
+    }
+
+    if (0 < skipped) {
+        std::cerr << "skipped " << skipped << " simulations with a minimum delay not below its maximum" << std::endl;
+    }
+
+    if (true == points.empty()) {
+        std::cerr << "no valid settings to sweep" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::ofstream file;
+    if (false == out_path.empty()) {
+        file.open(out_path);
+        if (false == file.is_open()) {
+            std::cerr << "failed to open " << out_path << ": " << strerror(errno) << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    std::ostream& out = (true == file.is_open()) ? file : std::cout;
+
+    // run every simulation on the pool
+    std::vector<sweep_result_t> results(points.size());
+    std::atomic<size_t> finished{0};
+    {
+        WorkPool pool = WorkPool(threads);
+        std::cerr << points.size() << " simulations on " << pool.size() << " threads" << std::endl;
+
+        for (size_t i = 0; i < points.size(); i++) {
+            pool.submit([&, i] {
+                results[i] = run_point(points[i], duration_s);
+                size_t done = ++finished;
+                if (0 == done % 10) {
+                    fprintf(stderr, "\r%zu/%zu", done, points.size());
+                }
+            });
+        }
+
+        pool.wait();
+        fprintf(stderr, "\r%zu/%zu\n", points.size(), points.size());
+    }
+
+    out << "lot_size,rate,loss,seed,max_send_attempts,failed_send_delay,channel_busy_delay_min_ms,"
+        << "channel_busy_delay_max_ms,loops_before_heartbeat,main_loop_delay_min_ms,main_loop_delay_max_ms,"
+        << "changes,delivered,superseded,undelivered,latency_p50_ms,latency_p90_ms,latency_p99_ms,"
+        << "latency_max_ms,fw_latency_max_ms,rx_per_s,tx_attempts_per_node,energy_mj_per_node_hour,tx_air_ms_per_node_hour"
+        << std::endl;
+
+    for (size_t i = 0; i < points.size(); i++) {
+
+        const sweep_point_t& point = points[i];
+        const sweep_result_t& result = results[i];
+
+        out << (unsigned)point.lot_size << "," << point.rate << "," << point.loss << "," << point.seed << ","
+            << (unsigned)point.timing.max_send_attempts << "," << (unsigned)point.timing.failed_send_delay << ","
+            << point.timing.channel_busy_delay_min_ms << "," << point.timing.channel_busy_delay_max_ms << ","
+            << (unsigned)point.timing.loops_before_heartbeat << ","
+            << point.timing.main_loop_delay_min_ms << "," << point.timing.main_loop_delay_max_ms << ","
+            << result.changes << "," << result.delivered << "," << result.superseded << ","
+            << result.undelivered << "," << result.latency_p50_ms << "," << result.latency_p90_ms << ","
+            << result.latency_p99_ms << "," << result.latency_max_ms << "," << result.fw_latency_max_ms << ","
+            << result.rx_per_s << ","
+            << result.tx_attempts_per_node << "," << result.energy_mj_per_node_hour << ","
+            << result.tx_air_ms_per_node_hour << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
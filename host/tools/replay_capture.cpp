@@ -0,0 +1,257 @@
+/**
+* @brief: Replays captured radio traffic through the base station message handling.
+* @file: replay_capture.cpp
+*
+* Usage: replay_capture FILE [--speed FACTOR] [--csv FILE]
+*
+* Reads a telemetry stream recorded from the nanoatmega328new_capture build,
+* and feeds every captured payload to the same handle_message() the firmware
+* runs, on a host build of the base station. The virtual clock is set to the
+* capture time of each payload so time dependent logic sees the original
+* timing. A speed of 0 replays as fast as possible, 1 in real time and N
+* N times faster than real time.
+*
+* The processing time of every payload is measured and summarized together
+* with the final state of the lot and the message counters.
+*
+* @author: jkieltyka15
+*/
+
+// standard libraries
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+// local libraries
+#include <Message.h>
+#include <Telemetry.h>
+
+// local dependencies
+#include "basestationstate.hpp"
+#include "messagehandler.hpp"
+#include "parkingdisplay.hpp"
+#include "shim.hpp"
+#include "telemetrydecoder.hpp"
+
+// ID of the base station
+#define BASE_STATION_ID 0
+
+
+// payload captured by the base station
+struct capture_t {
+    uint64_t time_us;               // receive time with micros() wraps removed
+    std::vector<uint8_t> payload;   // raw radio payload
+};
+
+
+/**
+ * @brief Reads every captured payload from a telemetry stream file
+ *
+ * @param path: path of the file
+ * @param captures: captured payloads in the order they were received
+ * @return True if the file could be read. Otherwise false
+ */
+static bool read_captures(const std::string& path, std::vector<capture_t>& captures) {
+
+    std::ifstream file(path, std::ios::binary);
+    if (false == file.is_open()) {
+        return false;
+    }
+
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    uint64_t wraps = 0;
+    uint32_t last_us = 0;
+
+    TelemetryDecoder decoder([&](const telemetry_event_t& event) {
+
+        if (TELEMETRY_CAPTURE != event.type) {
+            return;
+        }
+
+        // micros() wraps roughly every 71 minutes
+        if ((false == captures.empty()) && (event.capture_us < last_us)) {
+            wraps++;
+        }
+        last_us = event.capture_us;
+
+        captures.push_back({(wraps << 32) | event.capture_us, event.capture});
+    });
+
+    decoder.feed(bytes.data(), bytes.size());
+
+    std::cerr << "frames: " << decoder.get_frames()
+              << " bad: " << decoder.get_bad_frames()
+              << " lost: " << decoder.get_lost_frames() << std::endl;
+
+    return true;
+}
+
+
+/**
+ * @brief Gets a percentile of sorted samples
+ *
+ * @param sorted: samples in ascending order
+ * @param percentile: percentile between 0 and 100
+ * @return Value of the percentile
+ */
+static double percentile(const std::vector<double>& sorted, double percentile) {
+
+    if (true == sorted.empty()) {
+        return 0.0;
+    }
+
+    size_t index = (size_t)((percentile / 100.0) * (sorted.size() - 1) + 0.5);
+    return sorted[index];
+}
+
+
+int main(int argc, char** argv) {
+
+    std::string path;
+    std::string csv_path;
+    double speed = 0.0;
+
+    // parse arguments
+    for (int i = 1; i < argc; i++) {
+
+        if ((0 == strcmp(argv[i], "--speed")) && (i + 1 < argc)) {
+            speed = strtod(argv[++i], nullptr);
+        }
+
+        else if ((0 == strcmp(argv[i], "--csv")) && (i + 1 < argc)) {
+            csv_path = argv[++i];
+        }
+
+        else if ((0 == strcmp(argv[i], "--help")) || (0 == strcmp(argv[i], "-h"))) {
+            path.clear();
+            break;
+        }
+
+        else {
+            path = argv[i];
+        }
+    }
+
+    if ((true == path.empty()) || (0.0 > speed)) {
+        std::cerr << "usage: " << argv[0] << " FILE [--speed FACTOR] [--csv FILE]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::vector<capture_t> captures;
+    if (false == read_captures(path, captures)) {
+        std::cerr << "failed to open " << path << ": " << strerror(errno) << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (true == captures.empty()) {
+        std::cerr << "no captured payloads in " << path << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::ofstream csv;
+    if (false == csv_path.empty()) {
+        csv.open(csv_path);
+        if (false == csv.is_open()) {
+            std::cerr << "failed to open " << csv_path << ": " << strerror(errno) << std::endl;
+            return EXIT_FAILURE;
+        }
+        csv << "index,t_us,size,type,tx_id,process_ns" << std::endl;
+    }
+
+    // bring up the base station as setup() does, without the radio
+    BaseStationState base_station = BaseStationState(BASE_STATION_ID);
+    (void) base_station.init();
+    (void) init_parking_display();
+    draw_parking_map();
+
+    telemetry_counters_t counters = {};
+    std::vector<double> process_ns;
+    process_ns.reserve(captures.size());
+
+    const uint64_t first_us = captures.front().time_us;
+    const auto replay_start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < captures.size(); i++) {
+
+        const capture_t& capture = captures[i];
+        uint64_t offset_us = capture.time_us - first_us;
+
+        // pace the replay against the wall clock
+        if (0.0 < speed) {
+            std::this_thread::sleep_until(replay_start + std::chrono::microseconds((uint64_t)(offset_us / speed)));
+        }
+
+        shim_set_micros(capture.time_us);
+
+        // the radio always hands the firmware a zero padded buffer
+        uint8_t buffer[MSG_BUFFER_SIZE] = {0};
+        memcpy(buffer, capture.payload.data(), std::min(capture.payload.size(), sizeof(buffer)));
+
+        auto start = std::chrono::steady_clock::now();
+        handle_message(&base_station, buffer, &counters);
+        auto stop = std::chrono::steady_clock::now();
+
+        double elapsed_ns = std::chrono::duration<double, std::nano>(stop - start).count();
+        process_ns.push_back(elapsed_ns);
+
+        if (true == csv.is_open()) {
+            Message msg = Message();
+            memcpy(&msg, buffer, sizeof(msg));
+
+            csv << i << "," << offset_us << "," << capture.payload.size() << ","
+                << (unsigned)msg.get_type() << "," << (unsigned)msg.get_tx_id() << ","
+                << (uint64_t)elapsed_ns << std::endl;
+        }
+    }
+
+    // processing time summary
+    std::vector<double> sorted = process_ns;
+    std::sort(sorted.begin(), sorted.end());
+
+    double total_ns = 0.0;
+    for (double ns : sorted) {
+        total_ns += ns;
+    }
+
+    printf("payloads:     %zu over %.3f s of capture\n", captures.size(),
+        (captures.back().time_us - first_us) / 1e6);
+    printf("process (ns): mean %.0f p50 %.0f p90 %.0f p99 %.0f max %.0f\n",
+        total_ns / sorted.size(), percentile(sorted, 50), percentile(sorted, 90),
+        percentile(sorted, 99), sorted.back());
+
+    // counters accumulated by the message handler
+    printf("counters:     rx %u rejected %u unknown %u state_changes %u\n",
+        counters.rx_messages, counters.rx_rejected, counters.rx_unknown, counters.state_changes);
+
+    // final state of the lot
+    printf("lot:          %u of %u vacant\n", base_station.num_vacant(), SENSOR_NODE_NUM);
+    for (uint8_t node_id = 1; node_id <= SENSOR_NODE_NUM; node_id++) {
+
+        bool is_vacant = base_station.get_node_status(node_id);
+
+        printf("  node %3u %s", node_id, is_vacant ? "vacant  " : "occupied");
+
+        // statistics are only meaningful once the node has reported them
+        const node_stats_t* stats = base_station.get_node_stats(node_id);
+        if ((NULL != stats) && (0 < base_station.get_node_stats_reports(node_id))) {
+            printf(" reports %u tx %u failed %u relayed %u",
+                base_station.get_node_stats_reports(node_id), stats->tx_attempts,
+                stats->tx_failures, stats->relayed);
+        }
+
+        printf("\n");
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,127 @@
+/**
+* @brief: Decodes the base station telemetry stream into JSON lines.
+* @file: telemetry_decode.cpp
+*
+* Usage: telemetry_decode [DEVICE|FILE|-] [--baud RATE]
+*
+* Reads a serial device, a captured file or standard input and prints one
+* JSON object per telemetry frame. A summary of valid, corrupt and lost
+* frames is written to standard error at the end of the stream.
+*
+* @author: jkieltyka15
+*/
+
+// standard libraries
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+// local dependencies
+#include "telemetrydecoder.hpp"
+
+
+// baud rate of the base station telemetry build
+#define DEFAULT_BAUD 115200
+
+
+/**
+ * @brief Configures a serial device for raw binary reads
+ *
+ * @param fd: file descriptor of the device
+ * @param baud: baud rate of the device
+ * @return True on success. Otherwise false
+ */
+static bool configure_serial(int fd, long baud) {
+
+    speed_t speed;
+    switch (baud) {
+        case 9600:   speed = B9600;   break;
+        case 57600:  speed = B57600;  break;
+        case 115200: speed = B115200; break;
+        case 230400: speed = B230400; break;
+        case 500000: speed = B500000; break;
+        case 1000000: speed = B1000000; break;
+        default: return false;
+    }
+
+    struct termios tty;
+    if (0 != tcgetattr(fd, &tty)) {
+        return false;
+    }
+
+    cfmakeraw(&tty);
+    cfsetispeed(&tty, speed);
+    cfsetospeed(&tty, speed);
+
+    return 0 == tcsetattr(fd, TCSANOW, &tty);
+}
+
+
+int main(int argc, char** argv) {
+
+    std::string path = "-";
+    long baud = DEFAULT_BAUD;
+
+    // parse arguments
+    for (int i = 1; i < argc; i++) {
+
+        if ((0 == strcmp(argv[i], "--baud")) && (i + 1 < argc)) {
+            baud = strtol(argv[++i], nullptr, 10);
+        }
+
+        else if ((0 == strcmp(argv[i], "--help")) || (0 == strcmp(argv[i], "-h"))) {
+            std::cerr << "usage: " << argv[0] << " [DEVICE|FILE|-] [--baud RATE]" << std::endl;
+            return EXIT_SUCCESS;
+        }
+
+        else {
+            path = argv[i];
+        }
+    }
+
+    // open input
+    int fd = STDIN_FILENO;
+    if ("-" != path) {
+
+        fd = open(path.c_str(), O_RDONLY | O_NOCTTY);
+        if (0 > fd) {
+            std::cerr << "failed to open " << path << ": " << strerror(errno) << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    // serial devices need to be switched to raw mode at the right speed
+    if ((1 == isatty(fd)) && (false == configure_serial(fd, baud))) {
+        std::cerr << "failed to configure " << path << " at " << baud << " baud" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    TelemetryDecoder decoder = TelemetryDecoder([](const telemetry_event_t& event) {
+        std::cout << telemetry_event_to_json(event) << "\n";
+        std::cout.flush();
+    });
+
+    // decode until the end of the stream
+    uint8_t buffer[256];
+    ssize_t size = 0;
+    while (0 < (size = read(fd, buffer, sizeof(buffer)))) {
+        decoder.feed(buffer, (size_t)size);
+    }
+
+    std::cerr << "frames: " << decoder.get_frames()
+              << " bad: " << decoder.get_bad_frames()
+              << " lost: " << decoder.get_lost_frames() << std::endl;
+
+    if (STDIN_FILENO != fd) {
+        close(fd);
+    }
+
+    return EXIT_SUCCESS;
+}
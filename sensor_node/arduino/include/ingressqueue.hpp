@@ -0,0 +1,133 @@
+/**
+* @brief: Contains the prototype of the IngressQueue class.
+* @file: ingressqueue.hpp
+*
+* Status reports waiting to be sent towards the base station, both the
+* node's own and those relayed for other nodes. Status changes always
+* leave before heartbeats. Each origin holds at most one entry: a newer
+* report replaces an older one, and a heartbeat behind a status change
+* from the same node is dropped since the change already carries its
+* status. Heartbeats from new origins are dropped once the queue is deep.
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _INGRESS_QUEUE_HPP_
+#define _INGRESS_QUEUE_HPP_
+
+// standard libraries
+#include <Arduino.h>
+
+// local libraries
+#include <Message.h>
+
+#define INGRESS_QUEUE_SIZE 4        // most reports waiting to be sent
+#define INGRESS_QUEUE_DROP_DEPTH 2  // depth from which heartbeats of new origins are dropped
+
+// results of adding a report to the queue
+#define INGRESS_QUEUED 0        // report was added as a new entry
+#define INGRESS_COALESCED 1     // report was merged with a waiting report from the same node
+#define INGRESS_DROPPED 2       // report was dropped
+
+
+// status report waiting to be sent
+struct ingress_entry_t {
+    uint32_t queued_ms;                     // time the report was queued
+    uint8_t size;                           // size of the report in bytes
+    uint8_t buffer[sizeof(StatsMessage)];   // UpdateMessage or StatsMessage
+};
+
+
+class IngressQueue {
+
+    private:
+
+        // reports in the order they were queued
+        ingress_entry_t entries[INGRESS_QUEUE_SIZE];
+        uint8_t num_entries = 0;
+
+        /**
+         * @brief Gets the report held by an entry
+         * 
+         * @param index: index of the entry
+         * @return Report of the entry
+         */
+        UpdateMessage* get_report(uint8_t index);
+
+        /**
+         * @brief Finds the most urgent report
+         * 
+         * @return Index of the entry. Zero if the queue is empty
+         */
+        uint8_t find_next();
+
+        /**
+         * @brief Removes an entry and closes the gap
+         * 
+         * @param index: index of the entry
+         */
+        void remove(uint8_t index);
+
+        /**
+         * @brief Copies a report into an entry
+         * 
+         * @param index: index of the entry
+         * @param msg: report to copy
+         * @param size: size of the report in bytes
+         * @param now_ms: current time in milliseconds
+         */
+        void store(uint8_t index, UpdateMessage* msg, uint8_t size, uint32_t now_ms);
+
+
+    public:
+
+        /**
+         * @brief Adds a report to the queue
+         * 
+         * @param msg: UpdateMessage or StatsMessage to add
+         * @param size: size of the report in bytes
+         * @param now_ms: current time in milliseconds
+         * @return INGRESS_QUEUED, INGRESS_COALESCED or INGRESS_DROPPED
+         */
+        uint8_t push(UpdateMessage* msg, uint8_t size, uint32_t now_ms);
+
+        /**
+         * @brief Removes the most urgent report
+         * 
+         * Status changes come first and reports of the same priority
+         * leave in the order they were queued.
+         * 
+         * @param buffer: buffer of at least sizeof(StatsMessage) to hold the report
+         * @param queued_ms: time the report was queued
+         * @return Size of the report in bytes. Zero if the queue is empty
+         */
+        uint8_t pop(uint8_t* buffer, uint32_t* queued_ms);
+
+        /**
+         * @brief Gets the most urgent report without removing it
+         * 
+         * @return Report that pop() would remove, or NULL if the queue is empty
+         */
+        UpdateMessage* peek();
+
+        /**
+         * @brief Gets the number of reports waiting
+         * 
+         * @return Number of reports
+         */
+        uint8_t get_depth();
+
+        /**
+         * @brief Determines if another report may have nowhere to go
+         * 
+         * @return True if the queue is full. Otherwise false
+         */
+        bool is_full();
+
+        /**
+         * @brief Drops every waiting report
+         */
+        void clear();
+};
+
+#endif // _INGRESS_QUEUE_HPP_
@@ -0,0 +1,80 @@
+/**
+* @brief: Contains the prototype of the LinkPower class.
+* @file: linkpower.hpp
+*
+* Finds the lowest PA level that still gets status reports acknowledged by
+* each next hop. A link starts at full power and steps down a level after a
+* run of writes with few retransmissions. A failed write or one that needed
+* many retransmissions steps it back up, and the level found too weak is not
+* tried again until it has been held off for a while, so the level follows
+* the lot as cars and neighbours come and go.
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _LINK_POWER_HPP_
+#define _LINK_POWER_HPP_
+
+// standard libraries
+#include <Arduino.h>
+#include <RF24.h>
+
+#define LINK_POWER_LINKS_MAX 4          // most links whose level is kept
+#define LINK_POWER_ARC_GOOD 1           // most retransmissions of a write counted towards stepping down
+#define LINK_POWER_ARC_WEAK 3           // fewest retransmissions of a write that steps the level up
+#define LINK_POWER_STEP_WRITES 16       // good writes in a row before the next lower level is tried
+#define LINK_POWER_HOLD_MS 300000UL     // time a level found too weak is held off in milliseconds
+
+
+// PA level of the link to a next hop
+struct link_power_t {
+    uint8_t id;             // node ID of the receiver
+    uint8_t level;          // PA level writes to the receiver are sent at
+    uint8_t floor;          // lowest level that may be tried
+    uint8_t good_writes;    // writes in a row at the level with few retransmissions
+    uint32_t floor_ms;      // time the floor was raised
+    uint32_t used_ms;       // time of the last write to the receiver
+};
+
+
+class LinkPower {
+
+    private:
+
+        // links written to most recently
+        link_power_t links[LINK_POWER_LINKS_MAX] = {};
+        uint8_t num_links = 0;
+
+        /**
+         * @brief Finds the link to a receiver
+         *
+         * @param rx_id: ID of the receiver
+         * @return Index of the link, or -1 if there is none
+         */
+        int8_t find(uint8_t rx_id);
+
+
+    public:
+
+        /**
+         * @brief Gets the PA level to write to a receiver at
+         *
+         * @param rx_id: ID of the receiver
+         * @return PA level, RF24_PA_MAX for a receiver not written to yet
+         */
+        uint8_t get_level(uint8_t rx_id);
+
+        /**
+         * @brief Updates the level of the link to a receiver from a status report written to it
+         *
+         * The least recently used link is replaced when the table is full.
+         *
+         * @param rx_id: ID of node the report was written to
+         * @param is_sent: if the write was acknowledged
+         * @param arc: retransmissions of the write
+         * @param now_ms: current time in milliseconds
+         */
+        void record_tx(uint8_t rx_id, bool is_sent, uint8_t arc, uint32_t now_ms);
+};
+
+#endif // _LINK_POWER_HPP_
@@ -0,0 +1,404 @@
+/**
+* @brief: Contains one iteration of the sensor node main loop.
+* @file: mainloop.hpp
+*
+* The loop is kept apart from main.cpp so host tools can drive the exact
+* firmware loop against simulated devices and a virtual clock.
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _MAIN_LOOP_HPP_
+#define _MAIN_LOOP_HPP_
+
+// standard libraries
+#include <Arduino.h>
+
+// local libraries
+#include <Log.h>
+#include <Message.h>
+#include <parkingmap.hpp>
+
+// local dependencies
+#include "sensornode.hpp"
+#include "profiling.hpp"
+
+// size of message buffer
+#define MSG_BUFFER_SIZE 32
+
+
+/**
+ * @brief Runs one iteration of the sensor node main loop
+ * 
+ * Queues an update if the parking space status has changed or a heartbeat
+ * is due. Sending any report counts as a heartbeat since it marks the node
+ * alive, so only a node silent for the whole window sends one. Otherwise
+ * handles a received message, queueing it if it is a status report to
+ * relay, or waits if there is nothing to do. The most
+ * urgent queued report is then sent, status changes before heartbeats,
+ * followed by any statuses held for a rebooted base station. Last, the
+ * node switches the rate it listens at if the reports it heard call for it.
+ * 
+ * @param node: sensor node to run
+ * @param loops_since_last_transmission: loop iterations since the last message was transmitted
+ */
+template <class Radio, class RangeSensor>
+void sensor_node_loop(SensorNode<Radio, RangeSensor>* node, uint8_t* loops_since_last_transmission) {
+
+    // track iterations since last transmission
+    (*loops_since_last_transmission)++;
+
+    // determine if parking space status has changed or time for heartbeat
+    bool is_status_changed = node->is_sensor_status_changed();
+    bool is_heartbeat = (false == is_status_changed)
+        && (node->get_timing()->loops_before_heartbeat <= *loops_since_last_transmission);
+
+    // heartbeats wait for a saturated relay to recover, for up to twice as long
+    if ((true == is_heartbeat) && (UINT8_MAX > *loops_since_last_transmission)
+        && ((2 * (uint16_t)node->get_timing()->loops_before_heartbeat) > *loops_since_last_transmission)
+        && (true == node->is_next_hop_saturated())) {
+
+        PROFILE_COUNT(COUNTER_HEARTBEAT_DEFERRED, 1);
+        is_heartbeat = false;
+    }
+
+    if ((true == is_status_changed) || (true == is_heartbeat)) {
+
+        // heartbeats carry network statistics along with the status
+        if (INGRESS_DROPPED == node->queue_status(is_heartbeat)) {
+            WARN("Own status report dropped");
+        }
+
+        // reset heartbeat iteration counter
+        *loops_since_last_transmission = 0;
+    }
+
+    // check if a message has been received while there is room to queue it
+    else if((false == node->is_queue_full()) && (true == node->is_message())) {
+
+        uint8_t buffer[MSG_BUFFER_SIZE];
+        memset(buffer, 0, sizeof(buffer));
+
+        if (false == node->read_message((uint8_t**)(&buffer), (uint8_t)sizeof(buffer))) {
+            ERROR("Failed to read message");
+        }
+
+        else {
+            // convert buffer to Message
+            Message msg = Message();
+            memcpy(&msg, buffer, sizeof(msg));
+
+            // verify message is for node
+            if (node->get_id() != msg.get_rx_id()) {
+                WARN("Message intended for Node %u not Node %u", msg.get_rx_id(), node->get_id());
+            }
+
+            // react accordingly based on message type
+            else {
+
+                uint8_t type = msg.get_type();
+                switch(type) {
+
+                    case MESSAGE_UPDATE: {
+
+                        INFO("Received UPDATE message from Node %u", msg.get_tx_id());
+                        
+                        // convert buffer to UpdateMessage
+                        UpdateMessage update_msg = UpdateMessage();
+                        memcpy(&update_msg, buffer, sizeof(update_msg));
+
+                        // heartbeats repeating a delivered status only mark their nodes alive
+                        if (true == node->absorb_report(&update_msg)) {
+                            INFO("Heartbeat from Node %u absorbed", update_msg.get_node_id());
+                            break;
+                        }
+
+                        // drop reports caught in a loop of stale routes
+                        if (ROUTE_HOPS_MAX <= update_msg.get_hops()) {
+                            WARN("Update message from Node %u dropped after %u hops", update_msg.get_node_id(), update_msg.get_hops());
+                            break;
+                        }
+
+                        // carry the age and path over and add the time spent at this node
+                        UpdateMessage new_msg = UpdateMessage(0, node->get_id(), update_msg.get_node_id(), update_msg.get_is_vacant());
+                        new_msg.set_age(update_msg.get_age_ms(), update_msg.get_hops() + 1);
+                        new_msg.trace_relay(&update_msg, node->get_id());
+                        new_msg.set_priority(update_msg.get_priority());
+                        new_msg.add_age(millis() - node->get_rx_since_ms());
+
+                        // forward the message once it is the most urgent
+                        if (INGRESS_DROPPED == node->queue_report(&new_msg, sizeof(new_msg))) {
+                            WARN("Update message from Node %u dropped", update_msg.get_node_id());
+                        }
+
+                        break;
+                    }
+
+                    case MESSAGE_STATS: {
+
+                        INFO("Received STATS message from Node %u", msg.get_tx_id());
+
+                        // convert buffer to StatsMessage
+                        StatsMessage stats_msg = StatsMessage();
+                        memcpy(&stats_msg, buffer, sizeof(stats_msg));
+
+                        // statistics always go on to the base station
+                        (void) node->absorb_report(&stats_msg);
+
+                        // drop reports caught in a loop of stale routes
+                        if (ROUTE_HOPS_MAX <= stats_msg.get_hops()) {
+                            WARN("Stats message from Node %u dropped after %u hops", stats_msg.get_node_id(), stats_msg.get_hops());
+                            break;
+                        }
+
+                        // carry the age and path over and add the time spent at this node
+                        node_stats_t stats;
+                        stats_msg.get_stats(&stats);
+                        StatsMessage new_msg = StatsMessage(0, node->get_id(), stats_msg.get_node_id(), stats_msg.get_is_vacant(), &stats);
+                        new_msg.set_age(stats_msg.get_age_ms(), stats_msg.get_hops() + 1);
+                        new_msg.trace_relay(&stats_msg, node->get_id());
+                        new_msg.set_priority(stats_msg.get_priority());
+                        new_msg.add_age(millis() - node->get_rx_since_ms());
+
+                        // forward the message once it is the most urgent
+                        if (INGRESS_DROPPED == node->queue_report(&new_msg, sizeof(new_msg))) {
+                            INFO("Stats message from Node %u dropped", stats_msg.get_node_id());
+                        }
+
+                        break;
+                    }
+
+                    case MESSAGE_STATUS_REQUEST: {
+
+                        INFO("Received STATUS_REQUEST message from Node %u", msg.get_tx_id());
+
+                        // convert buffer to StatusRequestMessage
+                        StatusRequestMessage request_msg = StatusRequestMessage();
+                        memcpy(&request_msg, buffer, sizeof(request_msg));
+
+                        // answer with the current status ahead of any heartbeat
+                        if ((true == request_msg.is_target(node->get_id())) && (INGRESS_DROPPED == node->queue_status(false))) {
+                            WARN("Requested status report dropped");
+                        }
+
+                        // pass the request on towards the other targets
+                        if (false == node->forward_request(&request_msg, sizeof(request_msg))) {
+                            ERROR("Failed to forward status request %u", request_msg.get_seq());
+                        }
+
+                        break;
+                    }
+
+                    case MESSAGE_CONFIG: {
+
+                        INFO("Received CONFIG message from Node %u", msg.get_tx_id());
+
+                        // convert buffer to ConfigMessage
+                        ConfigMessage config_msg = ConfigMessage();
+                        memcpy(&config_msg, buffer, sizeof(config_msg));
+
+                        // the status report tells the base station the settings arrived
+                        if (true == config_msg.is_target(node->get_id())) {
+
+                            if (false == node->apply_config(&config_msg)) {
+                                WARN("Rejected settings of config %u", config_msg.get_seq());
+                            }
+
+                            else if (INGRESS_DROPPED == node->queue_status(false)) {
+                                WARN("Config acknowledgement dropped");
+                            }
+                        }
+
+                        // pass the settings on towards the other targets
+                        if (false == node->forward_request(&config_msg, sizeof(config_msg))) {
+                            ERROR("Failed to forward config %u", config_msg.get_seq());
+                        }
+
+                        break;
+                    }
+
+                    case MESSAGE_PING: {
+
+                        INFO("Received PING message from Node %u", msg.get_tx_id());
+
+                        // convert buffer to PingMessage
+                        PingMessage ping_msg = PingMessage();
+                        memcpy(&ping_msg, buffer, sizeof(ping_msg));
+
+                        uint8_t hop = ping_msg.get_hop();
+                        const uint8_t* route = ping_msg.get_route();
+
+                        // last node of the route answers back towards the base station
+                        bool is_end = (ping_msg.get_route_len() <= hop);
+                        uint8_t rx_id = (true == is_end) ? msg.get_tx_id() : route[hop];
+                        uint8_t new_type = (true == is_end) ? MESSAGE_PONG : MESSAGE_PING;
+                        uint8_t new_hop = (true == is_end) ? hop - 1 : hop + 1;
+
+                        // create new message to send
+                        PingMessage new_msg = PingMessage(rx_id, node->get_id(), new_type, ping_msg.get_seq(),
+                            route, ping_msg.get_route_len(), new_hop, ping_msg.get_send_us(), ping_msg.get_arc());
+
+                        // probes do not carry status so the heartbeat is left running
+                        if (false == node->transmit_ping(&new_msg)) {
+                            ERROR("Failed to transmit probe message to Node %u", rx_id);
+                        }
+
+                        break;
+                    }
+
+                    case MESSAGE_PONG: {
+
+                        INFO("Received PONG message from Node %u", msg.get_tx_id());
+
+                        // convert buffer to PingMessage
+                        PingMessage pong_msg = PingMessage();
+                        memcpy(&pong_msg, buffer, sizeof(pong_msg));
+
+                        uint8_t hop = pong_msg.get_hop();
+                        const uint8_t* route = pong_msg.get_route();
+
+                        // previous node of the route or the base station
+                        uint8_t rx_id = (1 >= hop) ? BASE_STATION_ID : route[hop - 2];
+
+                        // add the retransmissions this node needed to forward the PING
+                        uint8_t arc = pong_msg.get_arc() + node->get_probe_arc(pong_msg.get_seq());
+
+                        // create new message to forward
+                        PingMessage new_msg = PingMessage(rx_id, node->get_id(), MESSAGE_PONG, pong_msg.get_seq(),
+                            route, pong_msg.get_route_len(), hop - 1, pong_msg.get_send_us(), arc);
+
+                        // probes do not carry status so the heartbeat is left running
+                        if (false == node->transmit_ping(&new_msg)) {
+                            ERROR("Failed to transmit probe message to Node %u", rx_id);
+                        }
+
+                        break;
+                    }
+
+                    case MESSAGE_SYNC: {
+
+                        INFO("Received SYNC message from Node %u", msg.get_tx_id());
+
+                        // convert buffer to SyncMessage
+                        SyncMessage sync_msg = SyncMessage();
+                        memcpy(&sync_msg, buffer, sizeof(sync_msg));
+
+                        // each round is passed on once down the flooding tree
+                        if (true == node->handle_sync(&sync_msg)) {
+
+                            uint8_t children[TREE_CHILDREN_MAX];
+                            uint8_t num_children = get_tree_children(node->get_id(), children, sizeof(children));
+
+                            for (uint8_t i = 0; i < num_children; i++) {
+
+                                SyncMessage new_msg = SyncMessage(children[i], node->get_id(), sync_msg.get_epoch(), sync_msg.get_seq(), sync_msg.get_hops() + 1);
+
+                                if (false == node->transmit_sync(&new_msg)) {
+                                    ERROR("Failed to transmit sync message to Node %u", children[i]);
+                                }
+                            }
+                        }
+
+                        break;
+                    }
+
+                    case MESSAGE_RESYNC: {
+
+                        INFO("Received RESYNC message from Node %u", msg.get_tx_id());
+
+                        // convert buffer to ResyncMessage
+                        ResyncMessage resync_msg = ResyncMessage();
+                        memcpy(&resync_msg, buffer, sizeof(resync_msg));
+
+                        // held until this node's own reply slot
+                        node->handle_resync(&resync_msg);
+
+                        break;
+                    }
+
+                    case MESSAGE_BEACON: {
+
+                        INFO("Received BEACON message from Node %u", msg.get_tx_id());
+
+                        // convert buffer to BeaconMessage
+                        BeaconMessage beacon_msg = BeaconMessage();
+                        memcpy(&beacon_msg, buffer, sizeof(beacon_msg));
+
+                        // each round is passed on once to every node in range with this node's route
+                        RouteTable* routes = node->get_routes();
+                        bool is_new_round = node->handle_beacon(&beacon_msg);
+                        int16_t parent = routes->get_parent(millis());
+
+                        if ((true == is_new_round) && (0 <= parent)) {
+
+                            uint8_t hops = routes->get_hops(millis());
+                            uint16_t cost = routes->get_cost(millis());
+
+                            for (uint8_t rx_id = 1; rx_id <= MAP_NODE_MAX; rx_id++) {
+
+                                if ((node->get_id() == rx_id) || (beacon_msg.get_tx_id() == rx_id)) {
+                                    continue;
+                                }
+
+                                BeaconMessage new_msg = BeaconMessage(rx_id, node->get_id(), beacon_msg.get_seq(), hops, cost, (uint8_t)parent);
+                                (void) node->transmit_beacon(&new_msg);
+                            }
+                        }
+
+                        break;
+                    }
+
+                    default:
+                        WARN("Unknown message type received");
+                        break;
+                }
+            }
+        }
+    }
+
+    // nothing to do
+    else if (true == node->is_queue_empty()) {
+        PROFILE_START(delay_start_us);
+        node->idle(random(node->get_timing()->main_loop_delay_min_ms, node->get_timing()->main_loop_delay_max_ms));
+        PROFILE_STOP(PHASE_LOOP_DELAY, delay_start_us);
+    }
+
+    // send the most urgent waiting status report
+    if (false == node->is_queue_empty()) {
+
+        // determine recepient, other than the node the report came from
+        int16_t rx_id = node->get_next_ingress_node(node->get_queued_sender());
+
+        // no recepient available
+        if (0 > rx_id) {
+            WARN("Nobody to send update to");
+            node->clear_queue();
+        }
+
+        else if (false == node->transmit_queued((uint8_t)rx_id)) {
+            ERROR("Failed to transmit update message to Node %d", rx_id);
+        }
+
+        else {
+            INFO("update message sent to Node %d", rx_id);
+        }
+
+        // reset heartbeat iteration counter
+        *loops_since_last_transmission = 0;
+    }
+
+    // send the statuses held for a rebooted base station once their slot has come
+    if (true == node->is_resync_due()) {
+
+        int16_t rx_id = node->get_next_ingress_node(-1);
+
+        if ((0 <= rx_id) && (false == node->transmit_resync((uint8_t)rx_id))) {
+            ERROR("Failed to transmit resync message to Node %d", rx_id);
+        }
+    }
+
+    // senders find the new rate the next time they write to this node
+    (void) node->adapt_data_rate();
+}
+
+#endif // _MAIN_LOOP_HPP_
@@ -0,0 +1,73 @@
+/**
+* @brief: Contains the prototypes for the sensor node config block.
+* @file: nodeconfig.hpp
+*
+* The node ID and timing settings of a sensor node live in EEPROM, so one
+* firmware build serves every node and settings changed by a CONFIG message
+* survive a restart. The defines in main.cpp and nodetiming.hpp are only
+* used until a config block has been saved.
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _NODE_CONFIG_HPP_
+#define _NODE_CONFIG_HPP_
+
+// standard libraries
+#include <Arduino.h>
+
+// local dependencies
+#include "nodetiming.hpp"
+
+#define NODE_CONFIG_ADDR 0          // EEPROM address of the config block
+#define NODE_CONFIG_MAGIC 0x5A      // marks a config block that has been written
+
+#define RADIO_RETRIES_MAX 15        // largest retry count and delay the radio supports
+
+
+// config block of a sensor node as stored in EEPROM
+struct node_config_t {
+    uint8_t magic;          // NODE_CONFIG_MAGIC
+    uint8_t node_id;        // unique ID of the node
+    node_timing_t timing;   // timing settings of the node
+    uint8_t checksum;       // CRC-8 of every byte before it
+};
+
+
+/**
+ * @brief Reads the config block from EEPROM
+ *
+ * @param config: where to store the config block
+ * @return True if a valid config block was found. Otherwise false
+ */
+bool load_node_config(node_config_t* config);
+
+/**
+ * @brief Writes the config block to EEPROM
+ *
+ * Only bytes that changed are written, so saving the same settings again
+ * costs no EEPROM wear.
+ *
+ * @param config: config block to save. Its magic and checksum are filled in
+ */
+void save_node_config(node_config_t* config);
+
+/**
+ * @brief Changes one timing setting
+ *
+ * @param timing: timing settings to change
+ * @param setting: ID of the setting, one of the CONFIG_ defines of ConfigMessage
+ * @param value: new value of the setting
+ * @return True if the setting is known and the value fits it. Otherwise false
+ */
+bool set_timing_setting(node_timing_t* timing, uint8_t setting, uint16_t value);
+
+/**
+ * @brief Determines if timing settings can be used together
+ *
+ * @param timing: timing settings to check
+ * @return True if the radio supports them and every minimum is within its maximum. Otherwise false
+ */
+bool is_timing_valid(const node_timing_t* timing);
+
+#endif // _NODE_CONFIG_HPP_
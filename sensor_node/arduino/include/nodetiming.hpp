@@ -0,0 +1,49 @@
+/**
+* @brief: Contains the timing settings of the sensor node.
+* @file: nodetiming.hpp
+*
+* The defines are the defaults used by the firmware. They are held in a
+* struct at runtime so host tools can sweep them without rebuilding.
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _NODE_TIMING_HPP_
+#define _NODE_TIMING_HPP_
+
+// standard libraries
+#include <Arduino.h>
+
+#define MAX_SEND_ATTEMPTS 15    // maximum number of attempts to send a message
+#define FAILED_SEND_DELAY 15    // minimum delay between sending message attempts
+
+// number of attempts to wait for the channel to be open if it is busy
+#define CHANNEL_CHECKS_MAX  10
+
+// minimum time to wait if the channel is busy before sending in milliseconds
+#define CHANNEL_BUSY_DELAY_MIN_MS 25
+
+// maximum time to wait if the channel is busy before sending in milliseconds
+#define CHANNEL_BUSY_DELAY_MAX_MS 100
+
+#define MAIN_LOOP_DELAY_MIN_MS 75   // minimum delay in main loop in milliseconds
+#define MAIN_LOOP_DELAY_MAX_MS 150  // maximum delay in main loop in milliseconds
+
+// number of loop iterations without transmitting a message
+// before sending out a heartbeat
+#define LOOPS_BEFORE_HEARTBEAT 25
+
+
+// timing settings of a sensor node
+struct node_timing_t {
+    uint8_t max_send_attempts = MAX_SEND_ATTEMPTS;
+    uint8_t failed_send_delay = FAILED_SEND_DELAY;
+    uint8_t channel_checks_max = CHANNEL_CHECKS_MAX;
+    uint16_t channel_busy_delay_min_ms = CHANNEL_BUSY_DELAY_MIN_MS;
+    uint16_t channel_busy_delay_max_ms = CHANNEL_BUSY_DELAY_MAX_MS;
+    uint16_t main_loop_delay_min_ms = MAIN_LOOP_DELAY_MIN_MS;
+    uint16_t main_loop_delay_max_ms = MAIN_LOOP_DELAY_MAX_MS;
+    uint8_t loops_before_heartbeat = LOOPS_BEFORE_HEARTBEAT;
+};
+
+#endif // _NODE_TIMING_HPP_
@@ -0,0 +1,80 @@
+/**
+* @brief: Contains the prototypes for profiling the sensor node hot path
+* @file: profiling.hpp
+*
+* Profiling is only compiled in when PROFILE_ENABLED is defined. Otherwise
+* the macros expand to nothing and no storage is reserved.
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _PROFILING_HPP_
+#define _PROFILING_HPP_
+
+// standard libraries
+#include <Arduino.h>
+
+// phases of the main loop that are timed
+enum profile_phase_id_t {
+    PHASE_TOF_READ = 0,     // ToF range read in is_sensor_status_changed
+    PHASE_CARRIER_SENSE,    // waiting for the receiver's channel to be open
+    PHASE_RADIO_WRITE,      // blocking radio write including retries
+    PHASE_LOOP_DELAY,       // random delay when there is nothing to do
+    PHASE_NUM
+};
+
+// events that are counted
+enum profile_counter_id_t {
+    COUNTER_CARRIER_BUSY = 0,   // channel found busy before sending
+    COUNTER_ARC_RETRIES,        // automatic retransmissions of sent messages
+    COUNTER_WRITE_FAILED,       // messages not acknowledged by the receiver
+    COUNTER_RX_FIFO_FULL,       // receive FIFO found full when reading
+    COUNTER_FORWARDED,          // messages relayed for other nodes
+    COUNTER_HEARTBEAT_DEFERRED, // loops a heartbeat waited for a saturated relay
+    COUNTER_REPORTS_MERGED,     // status reports merged with a waiting one or dropped
+    COUNTER_HEARTBEAT_ABSORBED, // relayed heartbeats folded into the alive bitmap
+    COUNTER_NUM
+};
+
+
+#ifdef PROFILE_ENABLED
+
+/**
+ * @brief Records the duration of a phase
+ *
+ * @param phase: phase that was timed
+ * @param elapsed_us: duration in microseconds
+ */
+void profile_record(profile_phase_id_t phase, uint32_t elapsed_us);
+
+/**
+ * @brief Adds to a counter
+ *
+ * @param counter: counter to add to
+ * @param amount: amount to add
+ */
+void profile_count(profile_counter_id_t counter, uint16_t amount);
+
+/**
+ * @brief Clears all phases and counters
+ */
+void profile_reset();
+
+/**
+ * @brief Prints all phases and counters to the serial port
+ */
+void profile_dump();
+
+#define PROFILE_START(start_us)         uint32_t start_us = micros()
+#define PROFILE_STOP(phase, start_us)   profile_record(phase, micros() - start_us)
+#define PROFILE_COUNT(counter, amount)  profile_count(counter, amount)
+
+#else
+
+#define PROFILE_START(start_us)         do {} while (0)
+#define PROFILE_STOP(phase, start_us)   do {} while (0)
+#define PROFILE_COUNT(counter, amount)  do {} while (0)
+
+#endif // PROFILE_ENABLED
+
+#endif // _PROFILING_HPP_
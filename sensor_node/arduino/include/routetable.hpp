@@ -0,0 +1,138 @@
+/**
+* @brief: Contains the prototype of the RouteTable class.
+* @file: routetable.hpp
+*
+* Learns the routing gradient from the beacons the base station floods.
+* Each beacon advertises the sender's cost to reach the base station. The
+* table adds the cost of the link to the sender, measured from the
+* retransmissions of this node's own status reports, and the cheapest
+* fresh parent is used to forward ingress messages. Without one the
+* static parking map is used instead.
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _ROUTE_TABLE_HPP_
+#define _ROUTE_TABLE_HPP_
+
+// standard libraries
+#include <Arduino.h>
+
+// local libraries
+#include <Message.h>
+
+#define ROUTE_PARENTS_MAX 4         // most parents a node keeps
+#define ROUTE_COST_SCALE 8          // cost of one transmission
+#define ROUTE_FAIL_ATTEMPTS 16      // transmissions a failed write is counted as
+#define ROUTE_HOPS_MAX 8            // parents further from the base station are ignored, as are reports relayed this often
+#define ROUTE_STALE_MS 100000UL     // time after which a parent that is not heard from is dropped
+
+
+// candidate node to forward ingress messages to
+struct route_parent_t {
+    uint8_t id;             // node ID of the parent
+    uint8_t hops;           // hops from the parent to the base station
+    uint16_t cost;          // cost the parent advertised
+    uint16_t link_cost;     // average cost of the link to the parent
+    uint32_t heard_ms;      // time the parent's beacon was last received
+};
+
+
+class RouteTable {
+
+    private:
+
+        // candidate parents
+        route_parent_t parents[ROUTE_PARENTS_MAX] = {};
+        uint8_t num_parents = 0;
+
+        // most recent beacon round
+        uint8_t seq = 0;
+        bool is_seq_set = false;
+
+        /**
+         * @brief Finds the cheapest parent that has been heard from recently
+         * 
+         * @param now_ms: current time in milliseconds
+         * @param exclude_id: ID of a node that may not be picked, or -1
+         * @return Index of the parent, or -1 if there is none
+         */
+        int8_t find_best(uint32_t now_ms, int16_t exclude_id);
+
+        /**
+         * @brief Finds the parent a newly heard node should replace in a full table
+         * 
+         * @param cost: cost the new node advertised
+         * @param now_ms: current time in milliseconds
+         * @return Index of the parent, or -1 if the new node is not worth keeping
+         */
+        int8_t find_replaceable(uint16_t cost, uint32_t now_ms);
+
+        /**
+         * @brief Gets the total cost of reaching the base station through a parent
+         * 
+         * @param parent: parent to evaluate
+         * @return Cost, saturating
+         */
+        uint16_t get_total_cost(const route_parent_t* parent);
+
+
+    public:
+
+        /**
+         * @brief Adds the route advertised by a beacon
+         * 
+         * Beacons from nodes that forward through this node are ignored so
+         * two nodes never pick each other.
+         * 
+         * @param node_id: ID of this node
+         * @param msg: beacon most recently read
+         * @param now_ms: current time in milliseconds
+         * @return True if the beacon round is new and should be passed on. Otherwise false
+         */
+        bool handle_beacon(uint8_t node_id, BeaconMessage* msg, uint32_t now_ms);
+
+        /**
+         * @brief Updates the cost of the link to a parent from a status report written to it
+         * 
+         * @param rx_id: ID of node the report was written to
+         * @param is_sent: if the write was acknowledged
+         * @param arc: retransmissions of the write
+         */
+        void record_tx(uint8_t rx_id, bool is_sent, uint8_t arc);
+
+        /**
+         * @brief Gets the node to forward ingress messages to
+         * 
+         * @param now_ms: current time in milliseconds
+         * @return Node ID of the parent, or -1 if there is no route
+         */
+        int16_t get_parent(uint32_t now_ms);
+
+        /**
+         * @brief Gets the next cheapest node to forward ingress messages to
+         * 
+         * @param now_ms: current time in milliseconds
+         * @param parent_id: ID of the parent to find an alternative to
+         * @return Node ID of the alternate parent, or -1 if there is none
+         */
+        int16_t get_alternate(uint32_t now_ms, uint8_t parent_id);
+
+        /**
+         * @brief Gets the hops from this node to the base station
+         * 
+         * @param now_ms: current time in milliseconds
+         * @return Number of hops, or zero if there is no route
+         */
+        uint8_t get_hops(uint32_t now_ms);
+
+        /**
+         * @brief Gets the cost of this node's route to the base station
+         * 
+         * @param now_ms: current time in milliseconds
+         * @return Cost, or 0xFFFF if there is no route
+         */
+        uint16_t get_cost(uint32_t now_ms);
+};
+
+#endif // _ROUTE_TABLE_HPP_
@@ -2,6 +2,12 @@
 * @brief: Contains the prototype of the SensorNode class.
 * @file: sensornode.hpp
 *
+* The radio and range sensor are template parameters rather than virtual
+* interfaces, so the firmware build binds straight to RF24 and
+* Adafruit_VL6180X with no vtables or indirect calls. Host builds can plug in
+* simulated or recorded devices that provide the same member functions.
+* The definitions live in sensornode_impl.hpp.
+*
 * @author: jkieltyka15
 */
 
@@ -16,7 +22,18 @@
 #include <RF24.h>
 
 // local libraries
+#include <egresstable.hpp>
+#include <Link.h>
 #include <Message.h>
+#include <parkingmap.hpp>
+
+// local dependencies
+#include "ingressqueue.hpp"
+#include "linkpower.hpp"
+#include "nodeconfig.hpp"
+#include "nodetiming.hpp"
+#include "routetable.hpp"
+#include "timesync.hpp"
 
 
 #define RF24_CE_PIN 7   // NRF24L01 CE pin assignment
@@ -25,6 +42,9 @@
 // width in bytes of the radio's address
 #define RF24_ADDRESS_WIDTH 4 
 
+// every this many heartbeats one carries network statistics to the base station
+#define HEARTBEATS_PER_STATS 8
+
 
 // different states of the ToF sensor
 enum tof_sensor_status_t {
@@ -34,6 +54,13 @@ enum tof_sensor_status_t {
 };
 
 
+/**
+ * @brief Parking sensor node
+ *
+ * @tparam Radio: NRF24L01 driver with the RF24 member functions used by the node
+ * @tparam RangeSensor: ToF driver with the Adafruit_VL6180X member functions used by the node
+ */
+template <class Radio, class RangeSensor>
 class SensorNode {
 
     private:
@@ -45,13 +72,97 @@ class SensorNode {
         tof_sensor_status_t sensor_status = NOT_INITIALIZED;
 
         // VL6180X ToF sensor
-        Adafruit_VL6180X sensor = Adafruit_VL6180X();
+        RangeSensor sensor = RangeSensor();
 
         // NRF24L01 transciever radio
-        RF24 radio = RF24(RF24_CE_PIN, RF24_CSN_PIN);
+        Radio radio = Radio(RF24_CE_PIN, RF24_CSN_PIN);
         uint32_t radio_address = 0;
         uint8_t radio_channel = 0;
 
+        // network health statistics reported with heartbeats
+        node_stats_t stats = {};
+
+        // timing settings of the node
+        node_timing_t timing;
+
+        // retransmissions of the most recent radio write
+        uint8_t last_arc = 0;
+
+        // if the write in progress is made without retransmissions
+        bool is_tx_once = false;
+
+        // time the sensor status last changed in milliseconds
+        uint32_t status_changed_ms = 0;
+
+        // time the receive FIFO was last found empty in milliseconds
+        uint32_t rx_idle_ms = 0;
+
+        // time the receive FIFO was first found holding the next message
+        uint32_t rx_seen_ms = 0;
+        bool is_rx_seen = false;
+
+        // window the most recently read message arrived in
+        uint32_t rx_since_ms = 0;
+        uint32_t rx_until_ms = 0;
+
+        // estimate of network time
+        TimeSync time_sync;
+
+        // boot of the base station most recently synced with
+        uint8_t epoch = 0;
+
+        // statuses to report to the rebooted base station and the slot to report them in
+        uint16_t resync_reported = 0;
+        uint16_t resync_vacant = 0;
+        uint32_t resync_due_ms = 0;
+
+        // parents learned from beacons
+        RouteTable routes;
+
+        // PA level of the link to each next hop
+        LinkPower link_power;
+
+        // data rate this node listens at and the rate of each node it writes to
+        LinkRate link_rate;
+
+        // status reports waiting to be sent towards the base station
+        IngressQueue ingress_queue;
+
+        // next nodes towards the nodes reporting through this node
+        EgressTable egress;
+
+        // nodes heard from since this node last reported, bit N for node N
+        uint16_t alive_pending = 0;
+
+        // vacancy status of each origin last delivered to the next hop
+        uint16_t sent_known = 0;
+        uint16_t sent_vacant = 0;
+
+        // heartbeats since the last one that carried network statistics
+        uint8_t heartbeats_since_stats = 0;
+
+        // how well this node keeps up with the messages it relays
+        CongestionMeter congestion;
+
+        // congestion levels advertised by the nodes this node sends to
+        uint8_t relay_level[MAP_NODE_MAX + 1] = {0};
+        uint32_t relay_heard_ms[MAP_NODE_MAX + 1] = {0};
+
+        // sequence number and retransmissions of the most recently forwarded PING
+        uint8_t probe_seq = 0;
+        uint8_t probe_arc = 0;
+
+        // if init() has configured the radio
+        bool is_initialized = false;
+
+        /**
+         * @brief Gets the bit of a node in an alive bitmap
+         * 
+         * @param node_id: ID of the node
+         * @return Bit of the node, or 0 if the node ID does not fit
+         */
+        uint16_t get_alive_bit(uint8_t node_id);
+
         /**
          * @brief Calculates a given sensor node's radio address based on the node ID
          * 
@@ -68,6 +179,48 @@ class SensorNode {
          */
         uint8_t calculate_radio_channel(uint8_t node_id);
 
+        /**
+         * @brief Transmit a message of any type to sensor node or base station.
+         * 
+         * Update and stats messages have the time spent waiting for a clear
+         * channel added to their age.
+         * 
+         * @param msg: Message to be transmitted
+         * @param size: Size of the message in bytes
+         * @return True if successfully sent. Otherwise false
+         */
+        bool transmit_message(Message* msg, uint8_t size);
+
+        /**
+         * @brief Loads this node's congestion level as the payload of its next ACK
+         * 
+         * Any older payload is discarded so the level is always current.
+         */
+        void arm_ack_payload();
+
+        /**
+         * @brief Reads the ACK payloads at the front of the receive FIFO
+         * 
+         * Each payload holds the congestion level of a node this node sent to.
+         */
+        void read_ack_payloads();
+
+        /**
+         * @brief Transmit a message without automatic retransmissions.
+         * 
+         * @param msg: Message to be transmitted
+         * @param size: Size of the message in bytes
+         * @return True if successfully sent. Otherwise false
+         */
+        bool transmit_once(Message* msg, uint8_t size);
+
+        /**
+         * @brief Calculates the amount of free RAM
+         * 
+         * @return Number of bytes between the heap and the stack
+         */
+        uint16_t calculate_free_ram();
+
 
     public:
 
@@ -120,13 +273,293 @@ class SensorNode {
          */
         bool transmit_update(uint8_t rx_node_id);
 
+        /**
+         * @brief Transmit a heartbeat with network statistics to sensor node or base station.
+         * 
+         * @param msg: Stats message to be transmitted
+         * @return True if successfully sent. Otherwise false
+         */
+        bool transmit_stats(StatsMessage* msg);
+
+        /**
+         * @brief Transmit a heartbeat with network statistics to sensor node or base station.
+         * 
+         * @param rx_node_id: ID of receiving node
+         * @return True if successfully sent. Otherwise false
+         */
+        bool transmit_stats(uint8_t rx_node_id);
+
+        /**
+         * @brief Queues a status report to be sent towards the base station
+         * 
+         * @param msg: UpdateMessage or StatsMessage, addressed when it is sent
+         * @param size: size of the report in bytes
+         * @return INGRESS_QUEUED, INGRESS_COALESCED or INGRESS_DROPPED
+         */
+        uint8_t queue_report(UpdateMessage* msg, uint8_t size);
+
+        /**
+         * @brief Queues a report of this node's own status
+         * 
+         * One in every HEARTBEATS_PER_STATS heartbeats carries network statistics.
+         * 
+         * @param is_heartbeat: if the report is a heartbeat
+         * @return INGRESS_QUEUED, INGRESS_COALESCED or INGRESS_DROPPED
+         */
+        uint8_t queue_status(bool is_heartbeat);
+
+        /**
+         * @brief Takes in the liveness carried by a received status report
+         * 
+         * The sender, the origin and every node the report marks alive are
+         * marked alive in the next report this node sends, and the sender is
+         * learned as the next egress node towards each of them. A plain heartbeat
+         * repeating the status this node last delivered for its origin has
+         * nothing else to tell the base station.
+         * 
+         * @param msg: received UpdateMessage or StatsMessage
+         * @return True if the report need not be forwarded. Otherwise false
+         */
+        bool absorb_report(UpdateMessage* msg);
+
+        /**
+         * @brief Transmit the most urgent queued status report.
+         * 
+         * The report marks this node and every node heard from since the
+         * last report alive. Heartbeats are written with half the
+         * retransmissions of status changes so they hold the channel for
+         * less time under load.
+         * 
+         * @param rx_node_id: ID of receiving node
+         * @return True if successfully sent. Otherwise false
+         */
+        bool transmit_queued(uint8_t rx_node_id);
+
+        /**
+         * @brief Determines if there are no status reports waiting
+         * 
+         * @return True if the queue is empty. Otherwise false
+         */
+        bool is_queue_empty();
+
+        /**
+         * @brief Determines if there is no room for another status report
+         * 
+         * @return True if the queue is full. Otherwise false
+         */
+        bool is_queue_full();
+
+        /**
+         * @brief Drops every waiting status report
+         */
+        void clear_queue();
+
+        /**
+         * @brief Passes a status request on towards its targets other than this node.
+         * 
+         * The targets are split between the next egress nodes so each copy
+         * only names the targets reached through its receiver. A learned
+         * next node that does not answer is forgotten, so the parking map
+         * is used for its targets next time. Requests of derived types are
+         * passed on whole.
+         * 
+         * @param msg: Status request most recently read
+         * @param size: size of the request in bytes
+         * @return True if every copy was sent. Otherwise false
+         */
+        bool forward_request(StatusRequestMessage* msg, uint8_t size);
+
+        /**
+         * @brief Applies and saves the timing settings of a config message
+         * 
+         * Settings are only applied if all of them are valid together, so a
+         * bad message leaves the node as it was.
+         * 
+         * @param msg: Config message most recently read
+         * @return True if the settings were applied. Otherwise false
+         */
+        bool apply_config(ConfigMessage* msg);
+
+        /**
+         * @brief Transmit a link probe to sensor node or base station.
+         * 
+         * The retransmissions needed by a forwarded PING are kept until
+         * its PONG passes back through the node.
+         * 
+         * @param msg: PING or PONG message to be transmitted
+         * @return True if successfully sent. Otherwise false
+         */
+        bool transmit_ping(PingMessage* msg);
+
+        /**
+         * @brief Gets the retransmissions needed to forward a PING
+         * 
+         * @param seq: sequence number of the probe
+         * @return Number of retransmissions, or zero if the PING was not the last one forwarded
+         */
+        uint8_t get_probe_arc(uint8_t seq);
+
+        /**
+         * @brief Transmit network time to a sensor node.
+         * 
+         * The message is stamped just before it is written and sent without
+         * automatic retransmissions, so a late copy never carries a stale time.
+         * 
+         * @param msg: Sync message to be transmitted
+         * @return True if successfully sent. Otherwise false
+         */
+        bool transmit_sync(SyncMessage* msg);
+
+        /**
+         * @brief Adds the network time of a received sync message to the estimate
+         * 
+         * A new epoch means the base station rebooted, so the estimate
+         * starts over and this node's status is held for a resync report.
+         * 
+         * @param msg: Sync message most recently read
+         * @return True if the sync round is new and should be passed on. Otherwise false
+         */
+        bool handle_sync(SyncMessage* msg);
+
+        /**
+         * @brief Merges a resync report from below into this node's own
+         * 
+         * Reports for an older epoch are dropped.
+         * 
+         * @param msg: Resync message most recently read
+         */
+        void handle_resync(ResyncMessage* msg);
+
+        /**
+         * @brief Determines if held resync statuses should be sent now
+         * 
+         * @return True if there are statuses to send and their slot has come. Otherwise false
+         */
+        bool is_resync_due();
+
+        /**
+         * @brief Transmit the held resync statuses to sensor node or base station.
+         * 
+         * Statuses merged after a successful send are sent again on the next loop.
+         * 
+         * @param rx_node_id: ID of receiving node
+         * @return True if successfully sent. Otherwise false
+         */
+        bool transmit_resync(uint8_t rx_node_id);
+
+        /**
+         * @brief Gets the current network time
+         * 
+         * @param network_ms: network time in milliseconds
+         * @param error_ms: most the network time may be off in milliseconds
+         * @return True if the node has been synchronized. Otherwise false
+         */
+        bool get_network_ms(uint32_t* network_ms, uint16_t* error_ms);
+
+        /**
+         * @brief Transmit the routing gradient to a sensor node.
+         * 
+         * Sent without automatic retransmissions since beacons go to every
+         * node ID and most are not in range.
+         * 
+         * @param msg: Beacon message to be transmitted
+         * @return True if successfully sent. Otherwise false
+         */
+        bool transmit_beacon(BeaconMessage* msg);
+
+        /**
+         * @brief Adds the route advertised by a received beacon
+         * 
+         * @param msg: Beacon message most recently read
+         * @return True if the beacon round is new and should be passed on. Otherwise false
+         */
+        bool handle_beacon(BeaconMessage* msg);
+
+        /**
+         * @brief Gets the parents learned from beacons
+         * 
+         * @return Route table of the node
+         */
+        RouteTable* get_routes();
+
+        /**
+         * @brief Gets the PA levels of the links to the next hops
+         * 
+         * @return Link power table of the node
+         */
+        LinkPower* get_link_power();
+
+        /**
+         * @brief Gets the data rates of this node and the nodes it writes to
+         * 
+         * @return Link rate table of the node
+         */
+        LinkRate* get_link_rate();
+
+        /**
+         * @brief Switches the rate this node listens at once the reports heard call for it
+         * 
+         * @return True if the rate changed. Otherwise false
+         */
+        bool adapt_data_rate();
+
+        /**
+         * @brief Gets the next node ID for forwarding an ingress message
+         * 
+         * Uses the cheapest parent learned from beacons, or the parking map
+         * if no parent has been heard from recently. A saturated relay is
+         * avoided when another one is available. A learned parent that is
+         * the excluded node is passed over, so a relayed report is never
+         * sent straight back to the node it came from.
+         * 
+         * @param exclude_id: ID of node a report to send came from, or -1
+         * @return Next node ID on success. Otherwise -1
+         */
+        int16_t get_next_ingress_node(int16_t exclude_id);
+
+        /**
+         * @brief Gets the node the most urgent waiting report came from
+         * 
+         * Read from the path trace of the report.
+         * 
+         * @return ID of the node, or -1 for this node's own report or a sender not recorded
+         */
+        int16_t get_queued_sender();
+
+        /**
+         * @brief Determines if a node recently advertised that it is saturated
+         * 
+         * @param node_id: ID of node
+         * @return True if the node is saturated. Otherwise false
+         */
+        bool is_relay_saturated(int16_t node_id);
+
+        /**
+         * @brief Determines if ingress messages can only go to a saturated relay
+         * 
+         * @return True if the next node is saturated. Otherwise false
+         */
+        bool is_next_hop_saturated();
+
         /**
          * @brief Determine if there is a message available to read
          * 
+         * Also notes when messages arrive so their waiting time can be bounded.
+         * 
          * @return True if a message is available. Otherwise false
          */
         bool is_message();
 
+        /**
+         * @brief Waits while checking for messages every millisecond
+         * 
+         * Messages are left in the receive FIFO but their arrival is timed
+         * to within a millisecond.
+         * 
+         * @param wait_ms: time to wait in milliseconds
+         */
+        void idle(uint32_t wait_ms);
+
         /**
          * @brief Gets a message from the message queue
          * 
@@ -136,12 +569,72 @@ class SensorNode {
          */
         bool read_message(uint8_t** buffer, uint8_t size);
 
+        /**
+         * @brief Gets the time since which the most recently read message may have been waiting
+         * 
+         * The message arrived after the receive FIFO was last found empty,
+         * so time counted from then is an upper bound on how long it waited.
+         * 
+         * @return Time in milliseconds
+         */
+        uint32_t get_rx_since_ms();
+
+        /**
+         * @brief Gets the time by which the most recently read message had arrived
+         * 
+         * @return Time in milliseconds
+         */
+        uint32_t get_rx_until_ms();
+
         /**
          * @brief Get the ID of the node
          * 
          * @return ID of the node
          */
         uint8_t get_id();
+
+        /**
+         * @brief Sets the ID of the node, for example from its config block
+         * 
+         * @param node_id: unique ID of the node
+         * @note must be called before init() since the ID picks the radio address and channel
+         */
+        void set_id(uint8_t node_id);
+
+        /**
+         * @brief Gets the timing settings of the node
+         * 
+         * @return Timing settings of the node
+         */
+        const node_timing_t* get_timing();
+
+        /**
+         * @brief Sets the timing settings of the node
+         * 
+         * @param timing: new timing settings
+         */
+        void set_timing(const node_timing_t* timing);
+
+        /**
+         * @brief Gets the radio of the node
+         * 
+         * Lets host builds wire a simulated radio to the rest of a simulation.
+         * 
+         * @return Radio of the node
+         */
+        Radio& get_radio();
+
+        /**
+         * @brief Gets the ToF sensor of the node
+         * 
+         * Lets host builds script the readings of a simulated sensor.
+         * 
+         * @return ToF sensor of the node
+         */
+        RangeSensor& get_sensor();
 };
 
+// template definitions
+#include "sensornode_impl.hpp"
+
 #endif /* _SENSOR_NODE_HPP_ */
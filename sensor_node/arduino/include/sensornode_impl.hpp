@@ -0,0 +1,1087 @@
+/**
+* @brief: Contains the implementation of the SensorNode class template.
+* @file: sensornode_impl.hpp
+*
+* Only included by sensornode.hpp.
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _SENSOR_NODE_IMPL_HPP_
+#define _SENSOR_NODE_IMPL_HPP_
+
+// standard libraries
+#include <Arduino.h>
+#include <stdlib.h>
+
+// local libraries
+#include <Log.h>
+#include <Message.h>
+
+// local dependencies
+#include "nodetiming.hpp"
+#include "profiling.hpp"
+
+
+// base station's node ID
+#define BASE_STATION_ID 0
+
+// special base station address since 0x00000000 is not a valid address
+#define BASE_STATION_ADDRESS 0xBAD1DEA5
+
+#define RF24_CHANNEL_SPACING 5  // number of channels between a valid node channel
+#define RF24_READING_PIPE 1     // reading pipe for the NRF24L01
+#define RF24_RX_FIFO_DEPTH 3    // number of messages the NRF24L01 can hold
+#define RF24_PAYLOAD_MAX 32     // largest payload the NRF24L01 can send
+
+
+template <class Radio, class RangeSensor>
+SensorNode<Radio, RangeSensor>::SensorNode(uint8_t node_id) {
+
+    this->node_id = node_id;
+
+    this->radio_address = this->calculate_radio_address(node_id);
+    this->radio_channel = this->calculate_radio_channel(node_id);
+}
+
+
+template <class Radio, class RangeSensor>
+uint16_t SensorNode<Radio, RangeSensor>::get_alive_bit(uint8_t node_id) {
+
+    if ((0 == node_id) || (ALIVE_NODE_MAX < node_id)) {
+        return 0;
+    }
+
+    return (uint16_t)(1U << node_id);
+}
+
+
+template <class Radio, class RangeSensor>
+uint32_t SensorNode<Radio, RangeSensor>::calculate_radio_address(uint8_t node_id) {
+
+    // base station has special non-calculated address
+    if (BASE_STATION_ID == node_id) {
+        return BASE_STATION_ADDRESS;
+    }
+
+    // generate address as byte array
+    const byte address_bytes[RF24_ADDRESS_WIDTH] = { node_id, node_id, node_id, node_id };
+
+    // convert byte array to 32 bit integer
+    uint32_t address = 0;
+    memcpy(&address, address_bytes, sizeof(address));
+    
+    return address; 
+}
+
+
+template <class Radio, class RangeSensor>
+uint8_t SensorNode<Radio, RangeSensor>::calculate_radio_channel(uint8_t node_id) {
+
+    return node_id * RF24_CHANNEL_SPACING;
+}
+
+
+template <class Radio, class RangeSensor>
+bool SensorNode<Radio, RangeSensor>::init() {
+
+    // start ToF sensor
+    if (false == sensor.begin()) {
+
+        ERROR("Failed to start ToF sensor");
+        return false;
+    }
+
+    // start radio
+    if (false == radio.begin()) {
+
+        ERROR("Failed to start radio");
+        return false;
+    }
+
+    // configure radio
+    radio.enableDynamicPayloads();
+    radio.enableAckPayload();
+    radio.setAutoAck(true);
+    radio.setRetries(this->timing.failed_send_delay, this->timing.max_send_attempts);
+    radio.setAddressWidth(RF24_ADDRESS_WIDTH);
+    radio.setPALevel(RF24_PA_MAX);
+    radio.setDataRate(LinkRate::get_rate(this->link_rate.get_rx_index()));
+    radio.setChannel(this->radio_channel);
+    radio.openReadingPipe(RF24_READING_PIPE, this->radio_address);
+
+    // start listening on radio
+    radio.startListening();
+    this->rx_idle_ms = millis();
+    this->arm_ack_payload();
+
+    this->is_initialized = true;
+
+    return true;
+}
+
+
+template <class Radio, class RangeSensor>
+tof_sensor_status_t SensorNode<Radio, RangeSensor>::get_sensor_status() {
+
+    return this->sensor_status;
+}
+
+
+template <class Radio, class RangeSensor>
+bool SensorNode<Radio, RangeSensor>::is_sensor_status_changed() {
+
+    // get range from sensor
+    uint32_t read_ms = millis();
+    PROFILE_START(read_start_us);
+    (void) this->sensor.readRange();
+    uint8_t status = this->sensor.readRangeStatus();
+    PROFILE_STOP(PHASE_TOF_READ, read_start_us);
+
+    // sensor read occupied
+    if (VL6180X_ERROR_NONE == status) {
+
+        // status of parking spot did not change
+        if (OCCUPIED == this->sensor_status) {
+            return false;
+        }
+
+        // status of parking space changed
+        INFO("parking space is now occupied");
+        this->sensor_status = OCCUPIED;
+    }
+
+    // sensor read vacant
+    else if (VL6180X_ERROR_NOCONVERGE == status) {
+        
+        // status of parking spot did not change
+        if (VACANT == this->sensor_status) {
+            return false;
+        }
+
+        // status of parking space changed
+        INFO("parking space is now vacant");
+        this->sensor_status = VACANT;
+    }
+
+    // sensor error occured
+    else {
+        WARN("ToF sensor read error");
+        return false;
+    }
+
+    this->status_changed_ms = read_ms;
+
+    return true;
+}
+
+
+template <class Radio, class RangeSensor>
+bool SensorNode<Radio, RangeSensor>::transmit_message(Message* msg, uint8_t size) {
+
+    // message cannot fit in a single payload
+    if (RF24_PAYLOAD_MAX < size) {
+        return false;
+    }
+
+    this->stats.tx_attempts++;
+    uint32_t start_ms = millis();
+
+    // calculate receiver node's radio configuration
+    uint8_t rx_id = msg->get_rx_id();
+    uint32_t rx_address = this->calculate_radio_address(rx_id);
+    uint8_t rx_channel = this->calculate_radio_channel(rx_id);
+
+    // switch to receiver node's channel
+    this->radio.setChannel(rx_channel);
+
+    // wait for there to be no traffic on receiver's channel or timeout occurs
+    PROFILE_START(sense_start_us);
+    bool is_channel_open = false;
+    for (uint8_t i = 0; i < this->timing.channel_checks_max; i++) {
+
+        // check if channel is open
+        is_channel_open = (false == this->radio.testCarrier());
+
+        // channel is open
+        if (true == is_channel_open) {
+            break;
+        }
+
+        PROFILE_COUNT(COUNTER_CARRIER_BUSY, 1);
+        this->stats.carrier_busy++;
+
+        // delay a random amount of time to avoid collisions
+        uint32_t channel_delay = random(this->timing.channel_busy_delay_min_ms, this->timing.channel_busy_delay_max_ms);
+        INFO("Channel %u is busy. Waiting %lu ms", rx_channel, (unsigned long)channel_delay);
+        delay(channel_delay);
+    }
+
+    PROFILE_STOP(PHASE_CARRIER_SENSE, sense_start_us);
+
+    // do not send message since channel has too much traffic
+    if (false == is_channel_open) {
+
+        // switch back to this node's radio configuration
+        this->radio.setChannel(this->radio_channel);
+        radio.openReadingPipe(RF24_READING_PIPE, this->radio_address);
+
+        this->stats.tx_failures++;
+        return false;
+    }
+
+    // stop listening
+    this->radio.stopListening();
+    this->radio.closeReadingPipe(RF24_READING_PIPE);
+
+    // create pipe to receiver node at the lowest level it reliably hears
+    // and the rate it was last reached at
+    radio.openWritingPipe(rx_address);
+    this->radio.setPALevel(this->link_power.get_level(rx_id));
+
+    uint8_t rate_index = this->link_rate.get_tx_index(rx_id);
+    this->radio.setDataRate(LinkRate::get_rate(rate_index));
+
+    // status reports keep aging while the channel is busy
+    if ((MESSAGE_UPDATE == msg->get_type()) || (MESSAGE_STATS == msg->get_type())) {
+        ((UpdateMessage*)msg)->add_age(millis() - start_ms);
+    }
+
+    // network time is stamped as late as possible
+    else if (MESSAGE_SYNC == msg->get_type()) {
+        uint32_t now_ms = millis();
+        ((SyncMessage*)msg)->stamp(this->time_sync.get_network_ms(now_ms), this->time_sync.get_error_ms(now_ms));
+    }
+
+    // create a copy of the message to send
+    uint8_t buffer[RF24_PAYLOAD_MAX];
+    memcpy(buffer, msg, size);
+
+    // attempt to transmit message
+    PROFILE_START(write_start_us);
+    bool is_sent = this->radio.write(&buffer, size);
+    PROFILE_STOP(PHASE_RADIO_WRITE, write_start_us);
+
+    uint8_t arc = this->radio.getARC();
+
+    // receiver may have changed rate, so every other rate is tried once.
+    // A write that finds it measures the link at its new rate
+    if ((false == is_sent) && ((false == this->is_tx_once) || (true == this->link_rate.is_reached(rx_id)))) {
+
+        this->radio.setRetries(this->timing.failed_send_delay, 0);
+
+        int8_t fallback = this->link_rate.get_fallback_index(rate_index, 0);
+        for (uint8_t attempt = 1; (false == is_sent) && (0 <= fallback); attempt++) {
+
+            this->radio.setDataRate(LinkRate::get_rate(fallback));
+            is_sent = this->radio.write(&buffer, size);
+
+            if (true == is_sent) {
+                rate_index = fallback;
+                arc = this->radio.getARC();
+            }
+
+            fallback = this->link_rate.get_fallback_index(rate_index, attempt);
+        }
+
+        this->radio.setRetries(this->timing.failed_send_delay, this->timing.max_send_attempts);
+    }
+
+    if (true == is_sent) {
+        this->link_rate.record_tx(rx_id, rate_index);
+    }
+
+    PROFILE_COUNT(COUNTER_ARC_RETRIES, arc);
+    this->stats.arc_total += arc;
+    this->last_arc = arc;
+
+    if (false == is_sent) {
+        PROFILE_COUNT(COUNTER_WRITE_FAILED, 1);
+        this->stats.tx_failures++;
+    }
+
+    // status reports measure the link to the node they are routed through
+    // and how well this node keeps up with them
+    if ((MESSAGE_UPDATE == msg->get_type()) || (MESSAGE_STATS == msg->get_type())) {
+        this->routes.record_tx(rx_id, is_sent, arc);
+        this->link_power.record_tx(rx_id, is_sent, arc, millis());
+        this->congestion.record_tx(is_sent, arc);
+    }
+
+    // the receiver's ACK may have carried its congestion level
+    this->read_ack_payloads();
+
+    // switch back to this node's radio configuration. ACKs go out at full
+    // power since the sender picked its level without knowing this node's
+    this->radio.setPALevel(RF24_PA_MAX);
+    this->radio.setDataRate(LinkRate::get_rate(this->link_rate.get_rx_index()));
+    this->radio.setChannel(this->radio_channel);
+    radio.openReadingPipe(RF24_READING_PIPE, this->radio_address);
+
+    // start listening again. Switching to transmit discarded the ACK payload
+    this->radio.startListening();
+    this->arm_ack_payload();
+
+    return is_sent;
+}
+
+
+template <class Radio, class RangeSensor>
+bool SensorNode<Radio, RangeSensor>::transmit_update(UpdateMessage* msg) {
+
+    // attempt to transmit message
+    bool is_sent = this->transmit_message(msg, sizeof(*msg));
+
+    // track messages relayed for other nodes
+    if ((true == is_sent) && (this->node_id != msg->get_node_id())) {
+        this->stats.relayed++;
+    }
+
+    return is_sent;
+}
+
+
+template <class Radio, class RangeSensor>
+bool SensorNode<Radio, RangeSensor>::transmit_update(uint8_t rx_node_id) {
+
+    // create update message
+    bool is_vacant = (this->sensor_status == VACANT);
+    UpdateMessage msg = UpdateMessage(rx_node_id, this->node_id, this->node_id, is_vacant);
+    msg.add_age(millis() - this->status_changed_ms);
+
+    // attempt to transmit message
+    return this->transmit_update(&msg);
+}
+
+
+template <class Radio, class RangeSensor>
+bool SensorNode<Radio, RangeSensor>::transmit_stats(StatsMessage* msg) {
+
+    // attempt to transmit message
+    bool is_sent = this->transmit_message(msg, sizeof(*msg));
+
+    // track messages relayed for other nodes
+    if ((true == is_sent) && (this->node_id != msg->get_node_id())) {
+        this->stats.relayed++;
+    }
+
+    return is_sent;
+}
+
+
+template <class Radio, class RangeSensor>
+bool SensorNode<Radio, RangeSensor>::transmit_stats(uint8_t rx_node_id) {
+
+    this->stats.free_ram = this->calculate_free_ram();
+
+    // create stats message
+    bool is_vacant = (this->sensor_status == VACANT);
+    StatsMessage msg = StatsMessage(rx_node_id, this->node_id, this->node_id, is_vacant, &this->stats);
+    msg.add_age(millis() - this->status_changed_ms);
+
+    // attempt to transmit message
+    return this->transmit_stats(&msg);
+}
+
+
+template <class Radio, class RangeSensor>
+uint8_t SensorNode<Radio, RangeSensor>::queue_report(UpdateMessage* msg, uint8_t size) {
+
+    uint8_t result = this->ingress_queue.push(msg, size, millis());
+
+    if (INGRESS_QUEUED != result) {
+        PROFILE_COUNT(COUNTER_REPORTS_MERGED, 1);
+    }
+
+    // track the deepest the queue has been
+    if (this->ingress_queue.get_depth() > this->stats.queue_high_water) {
+        this->stats.queue_high_water = this->ingress_queue.get_depth();
+    }
+
+    return result;
+}
+
+
+template <class Radio, class RangeSensor>
+uint8_t SensorNode<Radio, RangeSensor>::queue_status(bool is_heartbeat) {
+
+    bool is_vacant = (this->sensor_status == VACANT);
+
+    // some heartbeats carry network statistics along with the status
+    if (true == is_heartbeat) {
+
+        this->heartbeats_since_stats++;
+
+        if (HEARTBEATS_PER_STATS <= this->heartbeats_since_stats) {
+
+            this->heartbeats_since_stats = 0;
+            this->stats.free_ram = this->calculate_free_ram();
+
+            StatsMessage msg = StatsMessage(0, this->node_id, this->node_id, is_vacant, &this->stats);
+            msg.add_age(millis() - this->status_changed_ms);
+
+            return this->queue_report(&msg, sizeof(msg));
+        }
+    }
+
+    UpdateMessage msg = UpdateMessage(0, this->node_id, this->node_id, is_vacant);
+    msg.add_age(millis() - this->status_changed_ms);
+
+    if (true == is_heartbeat) {
+        msg.set_priority(PRIORITY_HEARTBEAT);
+    }
+
+    return this->queue_report(&msg, sizeof(msg));
+}
+
+
+template <class Radio, class RangeSensor>
+bool SensorNode<Radio, RangeSensor>::absorb_report(UpdateMessage* msg) {
+
+    uint16_t origin_bit = this->get_alive_bit(msg->get_node_id());
+
+    this->alive_pending |= msg->get_alive() | origin_bit | this->get_alive_bit(msg->get_tx_id());
+
+    // requests reach these nodes the way their reports came
+    this->egress.learn(msg->get_node_id(), msg->get_tx_id());
+    for (uint8_t alive_id = 1; alive_id <= MAP_NODE_MAX; alive_id++) {
+        if (true == msg->is_alive(alive_id)) {
+            this->egress.learn(alive_id, msg->get_tx_id());
+        }
+    }
+
+    // only plain heartbeats can be absorbed
+    if ((MESSAGE_UPDATE != msg->get_type()) || (PRIORITY_HEARTBEAT != msg->get_priority())) {
+        return false;
+    }
+
+    // the status must already have been delivered by this node
+    bool is_vacant_sent = (0 != (this->sent_vacant & origin_bit));
+    if ((0 == origin_bit) || (0 == (this->sent_known & origin_bit)) || (msg->get_is_vacant() != is_vacant_sent)) {
+        return false;
+    }
+
+    PROFILE_COUNT(COUNTER_HEARTBEAT_ABSORBED, 1);
+    return true;
+}
+
+
+template <class Radio, class RangeSensor>
+bool SensorNode<Radio, RangeSensor>::transmit_queued(uint8_t rx_node_id) {
+
+    uint8_t buffer[sizeof(StatsMessage)];
+    uint32_t queued_ms = 0;
+
+    if (0 == this->ingress_queue.pop(buffer, &queued_ms)) {
+        return false;
+    }
+
+    // address the report, add the time it waited and mark the nodes heard from alive
+    UpdateMessage* msg = (UpdateMessage*)buffer;
+    msg->set_rx_id(rx_node_id);
+    msg->add_age(millis() - queued_ms);
+    msg->add_alive(this->alive_pending | this->get_alive_bit(this->node_id));
+
+    bool is_heartbeat = (PRIORITY_HEARTBEAT == msg->get_priority());
+    if (true == is_heartbeat) {
+        this->radio.setRetries(this->timing.failed_send_delay, this->timing.max_send_attempts / 2);
+    }
+
+    bool is_sent = (MESSAGE_STATS == msg->get_type())
+        ? this->transmit_stats((StatsMessage*)msg)
+        : this->transmit_update(msg);
+
+    if (true == is_heartbeat) {
+        this->radio.setRetries(this->timing.failed_send_delay, this->timing.max_send_attempts);
+    }
+
+    if (true == is_sent) {
+
+        // the next hop now carries the liveness and the origin's status
+        uint16_t origin_bit = this->get_alive_bit(msg->get_node_id());
+        this->alive_pending = 0;
+        this->sent_known |= origin_bit;
+        this->sent_vacant = (true == msg->get_is_vacant())
+            ? (this->sent_vacant | origin_bit)
+            : (this->sent_vacant & ~origin_bit);
+
+        if (this->node_id != msg->get_node_id()) {
+            PROFILE_COUNT(COUNTER_FORWARDED, 1);
+        }
+    }
+
+    return is_sent;
+}
+
+
+template <class Radio, class RangeSensor>
+bool SensorNode<Radio, RangeSensor>::is_queue_empty() {
+
+    return 0 == this->ingress_queue.get_depth();
+}
+
+
+template <class Radio, class RangeSensor>
+bool SensorNode<Radio, RangeSensor>::is_queue_full() {
+
+    return this->ingress_queue.is_full();
+}
+
+
+template <class Radio, class RangeSensor>
+void SensorNode<Radio, RangeSensor>::clear_queue() {
+
+    this->ingress_queue.clear();
+}
+
+
+template <class Radio, class RangeSensor>
+bool SensorNode<Radio, RangeSensor>::forward_request(StatusRequestMessage* msg, uint8_t size) {
+
+    // drop copies caught in a loop of stale routes
+    if (REQUEST_HOPS_MAX <= msg->get_hops()) {
+        return false;
+    }
+
+    uint16_t targets = msg->get_targets() & ~this->get_alive_bit(this->node_id);
+    uint8_t hops = msg->get_hops() + 1;
+    bool is_all_sent = true;
+
+    int16_t next_id = -1;
+    uint16_t group = this->egress.take_group(this->node_id, &targets, &next_id);
+
+    while (0 != group) {
+
+        // no route to the targets of the group
+        if (0 > next_id) {
+            is_all_sent = false;
+        }
+
+        else {
+
+            // the same copy is readdressed for each next node
+            msg->readdress((uint8_t)next_id, this->node_id, hops, group);
+
+            if (false == this->transmit_message(msg, size)) {
+
+                is_all_sent = false;
+
+                for (uint8_t target_id = 1; target_id <= MAP_NODE_MAX; target_id++) {
+                    if (0 != (group & this->get_alive_bit(target_id))) {
+                        this->egress.forget(target_id);
+                    }
+                }
+            }
+        }
+
+        group = this->egress.take_group(this->node_id, &targets, &next_id);
+    }
+
+    return is_all_sent;
+}
+
+
+template <class Radio, class RangeSensor>
+bool SensorNode<Radio, RangeSensor>::apply_config(ConfigMessage* msg) {
+
+    node_timing_t timing = this->timing;
+
+    for (uint8_t i = 0; i < msg->get_num_settings(); i++) {
+
+        uint8_t setting = 0;
+        uint16_t value = 0;
+
+        if ((false == msg->get_setting(i, &setting, &value)) || (false == set_timing_setting(&timing, setting, value))) {
+            return false;
+        }
+    }
+
+    if (false == is_timing_valid(&timing)) {
+        return false;
+    }
+
+    this->set_timing(&timing);
+
+    // keep the settings across a restart
+    node_config_t config;
+    config.node_id = this->node_id;
+    config.timing = timing;
+    save_node_config(&config);
+
+    return true;
+}
+
+
+template <class Radio, class RangeSensor>
+bool SensorNode<Radio, RangeSensor>::transmit_ping(PingMessage* msg) {
+
+    // attempt to transmit message
+    bool is_sent = this->transmit_message(msg, sizeof(*msg));
+
+    // remember what the PING cost until its PONG comes back
+    if ((true == is_sent) && (MESSAGE_PING == msg->get_type())) {
+        this->probe_seq = msg->get_seq();
+        this->probe_arc = this->last_arc;
+    }
+
+    return is_sent;
+}
+
+
+template <class Radio, class RangeSensor>
+uint8_t SensorNode<Radio, RangeSensor>::get_probe_arc(uint8_t seq) {
+
+    return (seq == this->probe_seq) ? this->probe_arc : 0;
+}
+
+
+template <class Radio, class RangeSensor>
+void SensorNode<Radio, RangeSensor>::arm_ack_payload() {
+
+    congestion_ack_t ack = {this->node_id, this->congestion.get_level()};
+
+    this->radio.flush_tx();
+    this->radio.writeAckPayload(RF24_READING_PIPE, &ack, sizeof(ack));
+}
+
+
+template <class Radio, class RangeSensor>
+void SensorNode<Radio, RangeSensor>::read_ack_payloads() {
+
+    // ACK payloads arrive on the writing pipe
+    uint8_t pipe = 0;
+    while ((true == this->radio.available(&pipe)) && (0 == pipe)) {
+
+        congestion_ack_t ack = {0, 0};
+        uint8_t size = this->radio.getDynamicPayloadSize();
+        this->radio.read(&ack, (size < sizeof(ack)) ? size : sizeof(ack));
+
+        if ((sizeof(ack) == size) && (MAP_NODE_MAX >= ack.node_id)) {
+            this->relay_level[ack.node_id] = ack.level;
+            this->relay_heard_ms[ack.node_id] = millis();
+        }
+    }
+}
+
+
+template <class Radio, class RangeSensor>
+bool SensorNode<Radio, RangeSensor>::transmit_once(Message* msg, uint8_t size) {
+
+    this->radio.setRetries(this->timing.failed_send_delay, 0);
+    this->is_tx_once = true;
+
+    bool is_sent = this->transmit_message(msg, size);
+
+    this->is_tx_once = false;
+    this->radio.setRetries(this->timing.failed_send_delay, this->timing.max_send_attempts);
+
+    return is_sent;
+}
+
+
+template <class Radio, class RangeSensor>
+bool SensorNode<Radio, RangeSensor>::transmit_sync(SyncMessage* msg) {
+
+    // a retransmission would arrive later than the stamped time
+    return this->transmit_once(msg, sizeof(*msg));
+}
+
+
+template <class Radio, class RangeSensor>
+bool SensorNode<Radio, RangeSensor>::handle_sync(SyncMessage* msg) {
+
+    // the base station rebooted so its clock and view of the lot start over
+    if (this->epoch != msg->get_epoch()) {
+
+        this->epoch = msg->get_epoch();
+        this->time_sync.reset();
+
+        // deeper nodes reply first, spread out by node ID within their slot
+        uint8_t depth = msg->get_hops() + 1;
+        uint8_t slot = (RESYNC_DEPTH_MAX < depth) ? 0 : RESYNC_DEPTH_MAX - depth;
+        uint32_t offset_ms = ((uint32_t)this->node_id * (RESYNC_SLOT_MS / 2)) / (MAP_NODE_MAX + 1);
+
+        this->resync_reported = this->get_alive_bit(this->node_id);
+        this->resync_due_ms = millis() + ((uint32_t)slot * RESYNC_SLOT_MS) + offset_ms;
+    }
+
+    // only the first copy of each round is used
+    if (false == this->time_sync.is_new_round(msg->get_seq(), msg->get_hops())) {
+        return false;
+    }
+
+    // message arrived somewhere in the window so take the middle
+    uint32_t window_ms = this->rx_until_ms - this->rx_since_ms;
+    uint32_t arrival_ms = this->rx_since_ms + (window_ms / 2);
+
+    uint32_t error_ms = (uint32_t)msg->get_error_ms() + ((window_ms + 1) / 2);
+    this->time_sync.add_point(arrival_ms, msg->get_network_ms(), (0xFFFF < error_ms) ? 0xFFFF : (uint16_t)error_ms);
+
+    return true;
+}
+
+
+template <class Radio, class RangeSensor>
+void SensorNode<Radio, RangeSensor>::handle_resync(ResyncMessage* msg) {
+
+    // answers a base station that has since rebooted again
+    if ((0 == this->epoch) || (this->epoch != msg->get_epoch())) {
+        return;
+    }
+
+    // newer reports of a node replace what is held for it
+    uint16_t reported = msg->get_reported();
+    this->resync_vacant = (this->resync_vacant & ~reported) | msg->get_vacant();
+    this->resync_reported |= reported;
+
+    // requests reach these nodes the way their statuses came
+    for (uint8_t target_id = 1; target_id <= MAP_NODE_MAX; target_id++) {
+        if (0 != (reported & this->get_alive_bit(target_id))) {
+            this->egress.learn(target_id, msg->get_tx_id());
+        }
+    }
+}
+
+
+template <class Radio, class RangeSensor>
+bool SensorNode<Radio, RangeSensor>::is_resync_due() {
+
+    return (0 != this->resync_reported) && (0 <= (int32_t)(millis() - this->resync_due_ms));
+}
+
+
+template <class Radio, class RangeSensor>
+bool SensorNode<Radio, RangeSensor>::transmit_resync(uint8_t rx_node_id) {
+
+    // this node's own status is read when it is sent so it is never stale
+    uint16_t own_bit = this->get_alive_bit(this->node_id);
+    if (0 != (this->resync_reported & own_bit)) {
+        this->resync_vacant = (VACANT == this->sensor_status)
+            ? (this->resync_vacant | own_bit)
+            : (this->resync_vacant & ~own_bit);
+    }
+
+    ResyncMessage msg = ResyncMessage(rx_node_id, this->node_id, this->epoch, this->resync_reported, this->resync_vacant);
+
+    if (false == this->transmit_message(&msg, sizeof(msg))) {
+        return false;
+    }
+
+    this->resync_reported = 0;
+    this->resync_vacant = 0;
+
+    return true;
+}
+
+
+template <class Radio, class RangeSensor>
+bool SensorNode<Radio, RangeSensor>::get_network_ms(uint32_t* network_ms, uint16_t* error_ms) {
+
+    uint32_t now_ms = millis();
+
+    *network_ms = this->time_sync.get_network_ms(now_ms);
+    *error_ms = this->time_sync.get_error_ms(now_ms);
+
+    return this->time_sync.is_synced();
+}
+
+
+template <class Radio, class RangeSensor>
+bool SensorNode<Radio, RangeSensor>::transmit_beacon(BeaconMessage* msg) {
+
+    // most receivers are out of range so failed writes are kept short
+    return this->transmit_once(msg, sizeof(*msg));
+}
+
+
+template <class Radio, class RangeSensor>
+bool SensorNode<Radio, RangeSensor>::handle_beacon(BeaconMessage* msg) {
+
+    return this->routes.handle_beacon(this->node_id, msg, millis());
+}
+
+
+template <class Radio, class RangeSensor>
+RouteTable* SensorNode<Radio, RangeSensor>::get_routes() {
+
+    return &this->routes;
+}
+
+
+template <class Radio, class RangeSensor>
+LinkPower* SensorNode<Radio, RangeSensor>::get_link_power() {
+
+    return &this->link_power;
+}
+
+
+template <class Radio, class RangeSensor>
+LinkRate* SensorNode<Radio, RangeSensor>::get_link_rate() {
+
+    return &this->link_rate;
+}
+
+
+template <class Radio, class RangeSensor>
+bool SensorNode<Radio, RangeSensor>::adapt_data_rate() {
+
+    if (false == this->link_rate.update(millis())) {
+        return false;
+    }
+
+    uint8_t rate_index = this->link_rate.get_rx_index();
+    INFO("Listening at data rate %u", rate_index);
+
+    // switching to transmit discards the ACK payload
+    this->radio.stopListening();
+    this->radio.setDataRate(LinkRate::get_rate(rate_index));
+    this->radio.startListening();
+    this->arm_ack_payload();
+
+    return true;
+}
+
+
+template <class Radio, class RangeSensor>
+int16_t SensorNode<Radio, RangeSensor>::get_next_ingress_node(int16_t exclude_id) {
+
+    // learned gradient first, never back to where the report came from
+    int16_t parent = this->routes.get_parent(millis());
+    if ((0 <= parent) && (exclude_id == parent)) {
+        parent = this->routes.get_alternate(millis(), parent);
+    }
+
+    // shifting to the next cheapest parent when saturated
+    if (0 <= parent) {
+
+        int16_t alternate = this->routes.get_alternate(millis(), parent);
+        if ((true == this->is_relay_saturated(parent)) && (0 <= alternate) && (exclude_id != alternate)
+            && (false == this->is_relay_saturated(alternate))) {
+            return alternate;
+        }
+
+        return parent;
+    }
+
+    // parking map when no parent is known, shifting to the other hop when saturated
+    int16_t next = ::get_next_ingress_node(this->node_id);
+    if (true == this->is_relay_saturated(next)) {
+
+        uint8_t hops[INGRESS_HOPS_MAX];
+        uint8_t num_hops = get_ingress_hops(this->node_id, hops);
+
+        for (uint8_t i = 0; i < num_hops; i++) {
+            if (false == this->is_relay_saturated(hops[i])) {
+                return hops[i];
+            }
+        }
+    }
+
+    return next;
+}
+
+
+template <class Radio, class RangeSensor>
+int16_t SensorNode<Radio, RangeSensor>::get_queued_sender() {
+
+    UpdateMessage* msg = this->ingress_queue.peek();
+    if ((NULL == msg) || (this->node_id == msg->get_node_id())) {
+        return -1;
+    }
+
+    // this node is the last relay in the trace, so the sender is the one before it
+    uint8_t hops = msg->get_hops();
+    if (2 > hops) {
+        return msg->get_node_id();
+    }
+
+    uint8_t sender_id = msg->get_relay(hops - 2);
+
+    return (PATH_RELAY_UNKNOWN == sender_id) ? -1 : sender_id;
+}
+
+
+template <class Radio, class RangeSensor>
+bool SensorNode<Radio, RangeSensor>::is_relay_saturated(int16_t node_id) {
+
+    if ((0 > node_id) || (MAP_NODE_MAX < node_id)) {
+        return false;
+    }
+
+    return (CONGESTION_SATURATED <= this->relay_level[node_id])
+        && (CONGESTION_HOLD_MS > millis() - this->relay_heard_ms[node_id]);
+}
+
+
+template <class Radio, class RangeSensor>
+bool SensorNode<Radio, RangeSensor>::is_next_hop_saturated() {
+
+    return this->is_relay_saturated(this->get_next_ingress_node(this->get_queued_sender()));
+}
+
+
+template <class Radio, class RangeSensor>
+bool SensorNode<Radio, RangeSensor>::is_message() {
+
+    this->read_ack_payloads();
+
+    if (false == this->radio.available()) {
+        this->rx_idle_ms = millis();
+        this->is_rx_seen = false;
+        return false;
+    }
+
+    // first time the next message is seen
+    if (false == this->is_rx_seen) {
+        this->rx_seen_ms = millis();
+        this->is_rx_seen = true;
+    }
+
+    return true;
+}
+
+
+template <class Radio, class RangeSensor>
+void SensorNode<Radio, RangeSensor>::idle(uint32_t wait_ms) {
+
+    uint32_t start_ms = millis();
+
+    while (wait_ms > millis() - start_ms) {
+        (void) this->is_message();
+        delay(1);
+    }
+}
+
+
+template <class Radio, class RangeSensor>
+bool SensorNode<Radio, RangeSensor>::read_message(uint8_t** buffer, uint8_t len) {
+
+    this->read_ack_payloads();
+
+    if (false == this->radio.available()) {
+        return false;
+    }
+
+    // a full FIFO means the sender's next message will not be acknowledged
+    bool is_fifo_full = this->radio.rxFifoFull();
+    if (true == is_fifo_full) {
+        PROFILE_COUNT(COUNTER_RX_FIFO_FULL, 1);
+
+        if (RF24_RX_FIFO_DEPTH > this->stats.queue_high_water) {
+            this->stats.queue_high_water = RF24_RX_FIFO_DEPTH;
+        }
+    }
+
+    // at least this message is waiting
+    else if (0 == this->stats.queue_high_water) {
+        this->stats.queue_high_water = 1;
+    }
+
+    // only read the bytes that were sent
+    uint8_t size = this->radio.getDynamicPayloadSize();
+    this->radio.read(buffer, (size < len) ? size : len);
+
+    // status reports show whether their senders could be heard at a faster rate
+    Message msg = Message();
+    memcpy(&msg, (const uint8_t*)buffer, sizeof(msg));
+    if ((MESSAGE_UPDATE == msg.get_type()) || (MESSAGE_STATS == msg.get_type())) {
+        this->link_rate.record_rx(msg.get_tx_id(), this->radio.testRPD());
+    }
+
+    // message arrived after the FIFO was last empty and before it was first seen
+    this->rx_since_ms = this->rx_idle_ms;
+    this->rx_until_ms = (true == this->is_rx_seen) ? this->rx_seen_ms : millis();
+
+    // the next message is only known to be waiting once it is seen
+    this->is_rx_seen = false;
+
+    // advertise how far behind this node is in the next ACK
+    this->congestion.record_rx(is_fifo_full, this->radio.available());
+    this->arm_ack_payload();
+
+    return true;
+}
+
+
+template <class Radio, class RangeSensor>
+uint32_t SensorNode<Radio, RangeSensor>::get_rx_since_ms() {
+
+    return this->rx_since_ms;
+}
+
+
+template <class Radio, class RangeSensor>
+uint32_t SensorNode<Radio, RangeSensor>::get_rx_until_ms() {
+
+    return this->rx_until_ms;
+}
+
+
+template <class Radio, class RangeSensor>
+uint8_t SensorNode<Radio, RangeSensor>::get_id() {
+
+    return this->node_id;
+}
+
+
+template <class Radio, class RangeSensor>
+void SensorNode<Radio, RangeSensor>::set_id(uint8_t node_id) {
+
+    this->node_id = node_id;
+
+    this->radio_address = this->calculate_radio_address(node_id);
+    this->radio_channel = this->calculate_radio_channel(node_id);
+}
+
+
+template <class Radio, class RangeSensor>
+const node_timing_t* SensorNode<Radio, RangeSensor>::get_timing() {
+
+    return &this->timing;
+}
+
+
+template <class Radio, class RangeSensor>
+void SensorNode<Radio, RangeSensor>::set_timing(const node_timing_t* timing) {
+
+    this->timing = *timing;
+
+    // retries live in the radio so apply them once it is running
+    if (true == this->is_initialized) {
+        this->radio.setRetries(this->timing.failed_send_delay, this->timing.max_send_attempts);
+    }
+}
+
+
+template <class Radio, class RangeSensor>
+Radio& SensorNode<Radio, RangeSensor>::get_radio() {
+
+    return this->radio;
+}
+
+
+template <class Radio, class RangeSensor>
+RangeSensor& SensorNode<Radio, RangeSensor>::get_sensor() {
+
+    return this->sensor;
+}
+
+
+template <class Radio, class RangeSensor>
+uint16_t SensorNode<Radio, RangeSensor>::calculate_free_ram() {
+
+#ifdef __AVR__
+    extern char __heap_start;
+    extern char* __brkval;
+
+    // stack grows down towards the top of the heap
+    char stack_top;
+    char* heap_top = (0 == __brkval) ? &__heap_start : __brkval;
+
+    return (uint16_t)(&stack_top - heap_top);
+#else
+    return 0;
+#endif
+}
+
+#endif /* _SENSOR_NODE_IMPL_HPP_ */
@@ -0,0 +1,124 @@
+/**
+* @brief: Contains the prototype of the TimeSync class.
+* @file: timesync.hpp
+*
+* Estimates network time from the sync points a node receives, in the
+* spirit of FTSP. Each point pairs the local millis() at which a sync
+* message arrived with the network time it carried. A least squares line
+* through the most recent points gives the local clock's offset and skew,
+* so network time can be read between sync rounds. The error bound adds
+* up the sender's bound, how precisely the arrival was timed and how far
+* the fitted skew could be off.
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _TIME_SYNC_HPP_
+#define _TIME_SYNC_HPP_
+
+// standard libraries
+#include <Arduino.h>
+
+#define SYNC_TABLE_SIZE 8       // number of sync points the estimate is fitted to
+#define SYNC_CLOCK_PPM 5000     // skew of an uncorrected ceramic resonator clock
+#define SYNC_DRIFT_PPM 100      // change of skew between sync rounds
+#define SYNC_RESET_MS 1000      // a point this far from the estimate starts over
+
+
+// local time a sync message arrived and the network time it carried
+struct sync_point_t {
+    uint32_t local_ms;      // local time of arrival
+    int32_t offset_ms;      // network time minus local time
+    uint16_t error_ms;      // most offset_ms may be off
+};
+
+
+class TimeSync {
+
+    private:
+
+        // most recent sync points, oldest overwritten first
+        sync_point_t points[SYNC_TABLE_SIZE] = {};
+        uint8_t num_points = 0;
+        uint8_t next_point = 0;
+
+        // fitted line through the sync points
+        uint32_t local_avg_ms = 0;
+        int32_t offset_avg_ms = 0;
+        float skew = 0.0f;
+
+        // largest error of the sync points and how far off that can tilt the line
+        uint16_t error_max_ms = 0;
+        float skew_error = 0.0f;
+
+        // most recent sync round and hops from the base station
+        uint8_t seq = 0;
+        uint8_t hops = 0;
+
+        /**
+         * @brief Fits the line through the sync points
+         */
+        void fit();
+
+
+    public:
+
+        /**
+         * @brief Forgets every sync point and round
+         * 
+         * Used when the base station reboots, since its clock starts over.
+         */
+        void reset();
+
+        /**
+         * @brief Determines if a sync round has not been seen yet
+         * 
+         * Remembers the round so each one is only handled once.
+         * 
+         * @param seq: sequence number of the round
+         * @param hops: hops from the base station to the sender
+         * @return True if the round is new. Otherwise false
+         */
+        bool is_new_round(uint8_t seq, uint8_t hops);
+
+        /**
+         * @brief Adds a sync point and fits the estimate again
+         * 
+         * @param local_ms: local time the sync message arrived
+         * @param network_ms: network time the sync message carried
+         * @param error_ms: most the network time and arrival time together may be off
+         */
+        void add_point(uint32_t local_ms, uint32_t network_ms, uint16_t error_ms);
+
+        /**
+         * @brief Determines if there is an estimate of network time
+         * 
+         * @return True if at least one sync point was received. Otherwise false
+         */
+        bool is_synced();
+
+        /**
+         * @brief Converts a local time to network time
+         * 
+         * @param local_ms: local time in milliseconds
+         * @return Network time in milliseconds
+         */
+        uint32_t get_network_ms(uint32_t local_ms);
+
+        /**
+         * @brief Gets the most a network time read now may be off
+         * 
+         * @param local_ms: local time in milliseconds
+         * @return Error bound in milliseconds, saturating
+         */
+        uint16_t get_error_ms(uint32_t local_ms);
+
+        /**
+         * @brief Gets the hops from the base station of the node the estimate came from
+         * 
+         * @return Number of hops
+         */
+        uint8_t get_hops();
+};
+
+#endif // _TIME_SYNC_HPP_
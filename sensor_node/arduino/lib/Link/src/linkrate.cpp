@@ -0,0 +1,205 @@
+/**
+* @brief: Contains the implementation of the LinkRate class.
+* @file: linkrate.cpp
+*
+* @author: jkieltyka15
+*/
+
+// standard libraries
+#include <Arduino.h>
+#include <RF24.h>
+
+// local dependencies
+#include "linkrate.hpp"
+
+
+// data rates from slowest to fastest
+static const rf24_datarate_e link_rates[LINK_RATE_NUM] = {
+    RF24_1MBPS,
+    RF24_2MBPS
+};
+
+
+/**
+ * @brief Counts the senders in a bitmap
+ *
+ * @param senders: bitmap of senders
+ * @return Number of bits set
+ */
+static uint8_t count_senders(uint32_t senders) {
+
+    uint8_t count = 0;
+
+    while (0 != senders) {
+        senders &= senders - 1;
+        count++;
+    }
+
+    return count;
+}
+
+
+rf24_datarate_e LinkRate::get_rate(uint8_t index) {
+
+    return link_rates[(LINK_RATE_NUM > index) ? index : LINK_RATE_DEFAULT];
+}
+
+
+int8_t LinkRate::find(uint8_t rx_id) {
+
+    for (uint8_t i = 0; i < this->num_peers; i++) {
+        if (rx_id == this->peer_id[i]) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+
+bool LinkRate::is_held(uint8_t index, uint32_t now_ms) {
+
+    return (index == this->held_index) && (LINK_RATE_HOLD_MS > now_ms - this->held_ms);
+}
+
+
+void LinkRate::start_trial(uint8_t index, uint32_t expected) {
+
+    this->prev_index = this->rx_index;
+    this->rx_index = index;
+
+    this->trial_senders = expected;
+    this->is_trial = true;
+}
+
+
+void LinkRate::record_rx(uint8_t tx_id, bool is_strong) {
+
+    this->senders |= 1UL << (tx_id % 32);
+
+    if (0xFF > this->window_reports) {
+        this->window_reports++;
+    }
+
+    if ((false == is_strong) && (0xFF > this->window_weak)) {
+        this->window_weak++;
+    }
+}
+
+
+bool LinkRate::update(uint32_t now_ms) {
+
+    // window has not passed
+    if (LINK_RATE_WINDOW_MS > now_ms - this->window_ms) {
+        return false;
+    }
+
+    uint32_t heard = this->senders;
+    uint8_t reports = this->window_reports;
+    uint8_t weak = this->window_weak;
+
+    this->window_ms = now_ms;
+    this->senders = 0;
+    this->window_reports = 0;
+    this->window_weak = 0;
+
+    // a trial keeps its rate if it heard from enough of the senders. Reports
+    // shift between parents, so a sender may be silent without being lost
+    if (true == this->is_trial) {
+
+        this->is_trial = false;
+
+        if ((LINK_RATE_TRIAL_PCT * count_senders(this->trial_senders)) <= (100 * count_senders(this->trial_senders & heard))) {
+            return false;
+        }
+
+        this->held_index = this->rx_index;
+        this->held_ms = now_ms;
+        this->rx_index = this->prev_index;
+
+        return true;
+    }
+
+    // every report came in strong so a faster rate should carry them in less air time
+    if ((0 < reports) && (0 == weak) && (LINK_RATE_NUM - 1 > this->rx_index)
+        && (false == this->is_held(this->rx_index + 1, now_ms))) {
+        this->start_trial(this->rx_index + 1, heard);
+        return true;
+    }
+
+    // too many weak reports for the faster rate's poorer sensitivity
+    if ((0 < this->rx_index) && (LINK_RATE_WEAK_MAX < weak)) {
+        this->held_index = this->rx_index;
+        this->held_ms = now_ms;
+        this->rx_index--;
+        return true;
+    }
+
+    return false;
+}
+
+
+uint8_t LinkRate::get_rx_index() {
+
+    return this->rx_index;
+}
+
+
+uint8_t LinkRate::get_tx_index(uint8_t rx_id) {
+
+    int8_t peer = this->find(rx_id);
+
+    // receiver not reached yet
+    if (0 > peer) {
+        return LINK_RATE_DEFAULT;
+    }
+
+    return this->peer_index[peer];
+}
+
+
+bool LinkRate::is_reached(uint8_t rx_id) {
+
+    return 0 <= this->find(rx_id);
+}
+
+
+int8_t LinkRate::get_fallback_index(uint8_t tried, uint8_t attempt) {
+
+    for (int8_t index = LINK_RATE_NUM - 1; 0 <= index; index--) {
+
+        if (tried == index) {
+            continue;
+        }
+
+        if (0 == attempt) {
+            return index;
+        }
+
+        attempt--;
+    }
+
+    return -1;
+}
+
+
+void LinkRate::record_tx(uint8_t rx_id, uint8_t index) {
+
+    int8_t peer = this->find(rx_id);
+
+    if (0 <= peer) {
+        this->peer_index[peer] = index;
+        return;
+    }
+
+    // receivers are replaced in turn once the table is full
+    uint8_t slot = this->next_peer;
+    this->next_peer = (this->next_peer + 1) % LINK_RATE_PEERS_MAX;
+
+    if (LINK_RATE_PEERS_MAX > this->num_peers) {
+        this->num_peers++;
+    }
+
+    this->peer_id[slot] = rx_id;
+    this->peer_index[slot] = index;
+}
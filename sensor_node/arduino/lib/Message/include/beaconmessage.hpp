@@ -0,0 +1,81 @@
+/**
+* @brief: Contains the prototype of the BeaconMessage class.
+* @file: beaconmessage.hpp
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _BEACON_MESSAGE_HPP_
+#define _BEACON_MESSAGE_HPP_
+
+// standard libraries
+#include <Arduino.h>
+
+// local dependencies
+#include "message.hpp"
+
+#define BEACON_NO_PARENT 0xFF   // parent of a sender without a route, such as the base station
+
+
+/**
+ * Routing gradient flooded outwards from the base station. Every node
+ * passes each round on to the nodes in range with its own route to the
+ * base station, so receivers can pick the cheapest node to forward
+ * ingress messages to.
+ */
+class __attribute__((packed)) BeaconMessage : public Message {
+
+    private:
+
+        uint8_t seq = 0;                    // beacon round started by the base station
+        uint8_t hops = 0;                   // hops from the sender to the base station
+        uint16_t cost = 0;                  // cost of the sender's route to the base station
+        uint8_t parent = BEACON_NO_PARENT;  // node the sender forwards ingress messages to
+
+
+    public:
+
+        /**
+         * @brief Constructs a BeaconMessage object
+         * 
+         * @param rx_id: ID of receiving node
+         * @param tx_id: ID of transmitting node
+         * @param seq: beacon round started by the base station
+         * @param hops: hops from the sender to the base station
+         * @param cost: cost of the sender's route to the base station
+         * @param parent: node the sender forwards ingress messages to
+         */
+        BeaconMessage(uint8_t rx_id, uint8_t tx_id, uint8_t seq, uint8_t hops, uint16_t cost, uint8_t parent);
+        BeaconMessage();
+
+        /**
+         * @brief Gets the beacon round
+         * 
+         * @return Sequence number of the round
+         */
+        uint8_t get_seq();
+
+        /**
+         * @brief Gets the hops from the sender to the base station
+         * 
+         * @return Number of hops
+         */
+        uint8_t get_hops();
+
+        /**
+         * @brief Gets the cost of the sender's route to the base station
+         * 
+         * @return Expected transmissions along the route scaled by the route table
+         */
+        uint16_t get_cost();
+
+        /**
+         * @brief Gets the node the sender forwards ingress messages to
+         * 
+         * @return Node ID, or BEACON_NO_PARENT
+         */
+        uint8_t get_parent();
+};
+
+
+#endif // _BEACON_MESSAGE_HPP_
@@ -0,0 +1,88 @@
+/**
+* @brief: Contains the prototype of the ConfigMessage class.
+* @file: configmessage.hpp
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _CONFIG_MESSAGE_HPP_
+#define _CONFIG_MESSAGE_HPP_
+
+// standard libraries
+#include <Arduino.h>
+
+// local dependencies
+#include "message.hpp"
+#include "statusrequestmessage.hpp"
+
+#define CONFIG_SETTINGS_MAX 4   // settings carried by one message
+
+// timing settings of a sensor node that can be changed at runtime
+#define CONFIG_MAX_SEND_ATTEMPTS            0   // attempts to send a message
+#define CONFIG_FAILED_SEND_DELAY            1   // delay between attempts, in steps of 250 us
+#define CONFIG_CHANNEL_CHECKS_MAX           2   // attempts to wait for a busy channel
+#define CONFIG_CHANNEL_BUSY_DELAY_MIN_MS    3   // minimum wait for a busy channel in milliseconds
+#define CONFIG_CHANNEL_BUSY_DELAY_MAX_MS    4   // maximum wait for a busy channel in milliseconds
+#define CONFIG_MAIN_LOOP_DELAY_MIN_MS       5   // minimum delay of the main loop, which samples the sensor, in milliseconds
+#define CONFIG_MAIN_LOOP_DELAY_MAX_MS       6   // maximum delay of the main loop in milliseconds
+#define CONFIG_LOOPS_BEFORE_HEARTBEAT       7   // loops without a transmission before a heartbeat
+#define CONFIG_SETTING_NUM                  8   // number of settings
+
+
+/**
+ * Changes timing settings of a set of nodes. It is routed like a status
+ * request, and each target answers with its status once it has applied
+ * and saved the settings, so the base station hears that it arrived.
+ */
+class __attribute__((packed)) ConfigMessage : public StatusRequestMessage {
+
+    private:
+
+        uint8_t num_settings = 0;                           // settings carried
+        uint8_t settings[CONFIG_SETTINGS_MAX] = {0};        // ID of each setting
+        uint16_t values[CONFIG_SETTINGS_MAX] = {0};         // new value of each setting
+
+
+    public:
+
+        /**
+         * @brief Constructs a ConfigMessage object without settings
+         * 
+         * @param rx_id: ID of receiving node
+         * @param tx_id: ID of transmitting node
+         * @param seq: request started by the base station
+         * @param hops: hops from the base station to the sender
+         * @param targets: bitmap where bit N is set if node N should apply the settings
+         */
+        ConfigMessage(uint8_t rx_id, uint8_t tx_id, uint8_t seq, uint8_t hops, uint16_t targets);
+        ConfigMessage();
+
+        /**
+         * @brief Adds a setting, replacing any earlier value of it
+         * 
+         * @param setting: ID of the setting
+         * @param value: new value of the setting
+         * @return True if the setting is known and there was room. Otherwise false
+         */
+        bool add_setting(uint8_t setting, uint16_t value);
+
+        /**
+         * @brief Gets the number of settings carried
+         * 
+         * @return Number of settings
+         */
+        uint8_t get_num_settings();
+
+        /**
+         * @brief Gets a setting carried by the message
+         * 
+         * @param index: index of the setting, below get_num_settings()
+         * @param setting: where to store the ID of the setting
+         * @param value: where to store the new value of the setting
+         * @return True if the index is valid. Otherwise false
+         */
+        bool get_setting(uint8_t index, uint8_t* setting, uint16_t* value);
+};
+
+
+#endif // _CONFIG_MESSAGE_HPP_
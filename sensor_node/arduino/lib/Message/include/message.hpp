@@ -13,6 +13,14 @@
 
 #define MESSAGE_UNKNOWN 0
 #define MESSAGE_UPDATE 1
+#define MESSAGE_STATS 2
+#define MESSAGE_PING 3
+#define MESSAGE_PONG 4
+#define MESSAGE_SYNC 5
+#define MESSAGE_BEACON 6
+#define MESSAGE_STATUS_REQUEST 7
+#define MESSAGE_RESYNC 8
+#define MESSAGE_CONFIG 9
 
 class Message {
 
@@ -42,6 +50,24 @@ class Message {
          */
         uint8_t get_rx_id();
 
+        /**
+         * @brief Sets the receiving node's ID
+         * 
+         * Lets a queued message be addressed once its next node is known.
+         * 
+         * @param rx_id: ID of receiving node
+         */
+        void set_rx_id(uint8_t rx_id);
+
+        /**
+         * @brief Sets the transmitting node's ID
+         * 
+         * Lets a relay pass a message on under its own ID.
+         * 
+         * @param tx_id: ID of transmitting node
+         */
+        void set_tx_id(uint8_t tx_id);
+
         /**
          * @brief Gets the transmitting node's ID
          * 
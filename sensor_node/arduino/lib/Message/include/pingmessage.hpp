@@ -0,0 +1,108 @@
+/**
+* @brief: Contains the prototype of the PingMessage class.
+* @file: pingmessage.hpp
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _PING_MESSAGE_HPP_
+#define _PING_MESSAGE_HPP_
+
+// standard libraries
+#include <Arduino.h>
+
+// local dependencies
+#include "message.hpp"
+
+// most sensor nodes a probe can be routed through
+#define PING_ROUTE_MAX 8
+
+
+/**
+ * A link probe sent by the base station along an explicit route of sensor
+ * nodes. As a PING it is forwarded outwards until it reaches the last node
+ * of the route, which answers with a PONG that is forwarded back inwards
+ * along the same route. The send timestamp is only read by the base station
+ * so every node can pass it through untouched. A node only learns how many
+ * retransmissions a PING needed after sending it, so those are added to the
+ * PONG as it passes back through.
+ */
+class __attribute__((packed)) PingMessage : public Message {
+
+    private:
+
+        uint8_t seq = 0;                        // probe sequence number
+        uint8_t hop = 0;                        // hops from the base station to the receiving node
+        uint8_t route_len = 0;                  // number of nodes in route
+        uint8_t route[PING_ROUTE_MAX] = {0};    // nodes from the base station outwards
+        uint32_t send_us = 0;                   // base station time the probe was sent
+        uint8_t arc = 0;                        // retransmissions of the PING between nodes so far
+
+
+    public:
+
+        /**
+         * @brief Constructs a PingMessage object
+         * 
+         * @param rx_id: ID of receiving node
+         * @param tx_id: ID of transmitting node
+         * @param msg_type: MESSAGE_PING or MESSAGE_PONG
+         * @param seq: probe sequence number
+         * @param route: nodes from the base station outwards
+         * @param route_len: number of nodes in route
+         * @param hop: hops from the base station to the receiving node
+         * @param send_us: base station time the probe was sent
+         * @param arc: retransmissions of the PING between nodes
+         */
+        PingMessage(uint8_t rx_id, uint8_t tx_id, uint8_t msg_type, uint8_t seq,
+                    const uint8_t* route, uint8_t route_len, uint8_t hop,
+                    uint32_t send_us, uint8_t arc);
+        PingMessage();
+
+        /**
+         * @brief Gets the probe sequence number
+         * 
+         * @return Sequence number
+         */
+        uint8_t get_seq();
+
+        /**
+         * @brief Gets the hops from the base station to the receiving node
+         * 
+         * The receiving node is route[hop - 1], or the base station when zero.
+         * 
+         * @return Number of hops
+         */
+        uint8_t get_hop();
+
+        /**
+         * @brief Gets the number of nodes in the route
+         * 
+         * @return Number of nodes
+         */
+        uint8_t get_route_len();
+
+        /**
+         * @brief Gets the nodes of the route from the base station outwards
+         * 
+         * @return Array of get_route_len() node IDs
+         */
+        const uint8_t* get_route();
+
+        /**
+         * @brief Gets the base station time the probe was sent
+         * 
+         * @return Time in microseconds
+         */
+        uint32_t get_send_us();
+
+        /**
+         * @brief Gets the retransmissions of the PING between nodes
+         * 
+         * @return Number of retransmissions
+         */
+        uint8_t get_arc();
+};
+
+
+#endif // _PING_MESSAGE_HPP_
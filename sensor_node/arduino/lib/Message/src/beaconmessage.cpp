@@ -0,0 +1,54 @@
+/**
+* @brief: Contains the implementation of the BeaconMessage class.
+* @file: beaconmessage.cpp
+*
+* @author: jkieltyka15
+*/
+
+// standard libraries
+#include <Arduino.h>
+
+// local dependencies
+#include "message.hpp"
+#include "beaconmessage.hpp"
+
+
+BeaconMessage::BeaconMessage() : Message() {}
+
+
+BeaconMessage::BeaconMessage(uint8_t rx_id,
+                             uint8_t tx_id,
+                             uint8_t seq,
+                             uint8_t hops,
+                             uint16_t cost,
+                             uint8_t parent) : Message(rx_id, tx_id, MESSAGE_BEACON) {
+
+    this->seq = seq;
+    this->hops = hops;
+    this->cost = cost;
+    this->parent = parent;
+}
+
+
+uint8_t BeaconMessage::get_seq() {
+
+    return this->seq;
+}
+
+
+uint8_t BeaconMessage::get_hops() {
+
+    return this->hops;
+}
+
+
+uint16_t BeaconMessage::get_cost() {
+
+    return this->cost;
+}
+
+
+uint8_t BeaconMessage::get_parent() {
+
+    return this->parent;
+}
@@ -0,0 +1,46 @@
+/**
+* @brief: Contains the implementation of the ResyncMessage class.
+* @file: resyncmessage.cpp
+*
+* @author: jkieltyka15
+*/
+
+// standard libraries
+#include <Arduino.h>
+
+// local dependencies
+#include "message.hpp"
+#include "resyncmessage.hpp"
+
+
+ResyncMessage::ResyncMessage() : Message() {}
+
+
+ResyncMessage::ResyncMessage(uint8_t rx_id,
+                             uint8_t tx_id,
+                             uint8_t epoch,
+                             uint16_t reported,
+                             uint16_t vacant) : Message(rx_id, tx_id, MESSAGE_RESYNC) {
+
+    this->epoch = epoch;
+    this->reported = reported;
+    this->vacant = vacant & reported;
+}
+
+
+uint8_t ResyncMessage::get_epoch() {
+
+    return this->epoch;
+}
+
+
+uint16_t ResyncMessage::get_reported() {
+
+    return this->reported;
+}
+
+
+uint16_t ResyncMessage::get_vacant() {
+
+    return this->vacant;
+}
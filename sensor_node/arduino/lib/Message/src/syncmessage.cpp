@@ -0,0 +1,67 @@
+/**
+* @brief: Contains the implementation of the SyncMessage class.
+* @file: syncmessage.cpp
+*
+* @author: jkieltyka15
+*/
+
+// standard libraries
+#include <Arduino.h>
+
+// local dependencies
+#include "message.hpp"
+#include "syncmessage.hpp"
+
+
+SyncMessage::SyncMessage() : Message() {}
+
+
+SyncMessage::SyncMessage(uint8_t rx_id,
+                         uint8_t tx_id,
+                         uint8_t epoch,
+                         uint8_t seq,
+                         uint8_t hops) : Message(rx_id, tx_id, MESSAGE_SYNC) {
+
+    this->epoch = epoch;
+    this->seq = seq;
+    this->hops = hops;
+}
+
+
+void SyncMessage::stamp(uint32_t network_ms, uint16_t error_ms) {
+
+    this->network_ms = network_ms + SYNC_TX_DELAY_MS;
+
+    uint32_t total_error_ms = (uint32_t)error_ms + SYNC_TX_JITTER_MS;
+    this->error_ms = (0xFFFF < total_error_ms) ? 0xFFFF : (uint16_t)total_error_ms;
+}
+
+
+uint8_t SyncMessage::get_epoch() {
+
+    return this->epoch;
+}
+
+
+uint8_t SyncMessage::get_seq() {
+
+    return this->seq;
+}
+
+
+uint8_t SyncMessage::get_hops() {
+
+    return this->hops;
+}
+
+
+uint32_t SyncMessage::get_network_ms() {
+
+    return this->network_ms;
+}
+
+
+uint16_t SyncMessage::get_error_ms() {
+
+    return this->error_ms;
+}
@@ -30,6 +30,17 @@ UpdateMessage::UpdateMessage(uint8_t rx_id,
 }
 
 
+UpdateMessage::UpdateMessage(uint8_t rx_id,
+                             uint8_t tx_id,
+                             uint8_t node_id,
+                             bool is_vacant,
+                             uint8_t msg_type) : Message(rx_id, tx_id, msg_type) {
+
+    this->node_id = node_id;
+    this->is_vacant = is_vacant;
+}
+
+
 uint8_t UpdateMessage::get_node_id() {
 
     return this->node_id;
@@ -40,3 +51,98 @@ bool UpdateMessage::get_is_vacant() {
 
     return this->is_vacant;
 }
+
+
+uint8_t UpdateMessage::get_priority() {
+
+    return this->priority;
+}
+
+
+void UpdateMessage::set_priority(uint8_t priority) {
+
+    this->priority = priority;
+}
+
+
+uint16_t UpdateMessage::get_alive() {
+
+    return this->alive;
+}
+
+
+bool UpdateMessage::is_alive(uint8_t node_id) {
+
+    if (ALIVE_NODE_MAX < node_id) {
+        return false;
+    }
+
+    return 0 != (this->alive & (1U << node_id));
+}
+
+
+void UpdateMessage::add_alive(uint16_t alive) {
+
+    this->alive |= alive;
+}
+
+
+uint16_t UpdateMessage::get_age_ms() {
+
+    return this->age_ms;
+}
+
+
+uint8_t UpdateMessage::get_hops() {
+
+    return this->hops;
+}
+
+
+void UpdateMessage::set_age(uint16_t age_ms, uint8_t hops) {
+
+    this->age_ms = age_ms;
+    this->hops = hops;
+}
+
+
+void UpdateMessage::add_age(uint32_t elapsed_ms) {
+
+    uint32_t age_ms = (uint32_t)this->age_ms + elapsed_ms;
+    this->age_ms = (0xFFFF < age_ms) ? 0xFFFF : (uint16_t)age_ms;
+}
+
+
+void UpdateMessage::trace_relay(UpdateMessage* msg, uint8_t relay_id) {
+
+    memcpy(this->path, msg->path, sizeof(this->path));
+
+    uint8_t index = msg->get_hops();
+    if (PATH_TRACE_MAX <= index) {
+        return;
+    }
+
+    // IDs that do not fit are marked so the hop still shows as taken
+    uint8_t value = ((0 == relay_id) || (PATH_NODE_MAX < relay_id)) ? 0x0F : relay_id;
+    uint8_t shift = (index % 2) * 4;
+
+    this->path[index / 2] = (this->path[index / 2] & ~(0x0F << shift)) | (value << shift);
+}
+
+
+uint8_t UpdateMessage::get_path_length() {
+
+    return (PATH_TRACE_MAX < this->hops) ? PATH_TRACE_MAX : this->hops;
+}
+
+
+uint8_t UpdateMessage::get_relay(uint8_t index) {
+
+    if (this->get_path_length() <= index) {
+        return PATH_RELAY_UNKNOWN;
+    }
+
+    uint8_t value = (this->path[index / 2] >> ((index % 2) * 4)) & 0x0F;
+
+    return (PATH_NODE_MAX < value) ? PATH_RELAY_UNKNOWN : value;
+}
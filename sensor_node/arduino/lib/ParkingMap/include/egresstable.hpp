@@ -0,0 +1,75 @@
+/**
+* @brief: Contains the prototype of the EgressTable class.
+* @file: egresstable.hpp
+*
+* Routes messages from the base station out to the sensor nodes. Status
+* reports travel the reverse way, so the node a report for some origin
+* arrived from is learned as the next node towards that origin. Nodes with
+* nothing learned yet, or whose learned next node stopped answering, fall
+* back to the flooding tree of the parking map.
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _EGRESS_TABLE_HPP_
+#define _EGRESS_TABLE_HPP_
+
+// standard libraries
+#include <Arduino.h>
+
+// local dependencies
+#include "parkingmap.hpp"
+
+#define EGRESS_UNKNOWN 0    // no next node learned. The base station is never a next egress node
+
+
+class EgressTable {
+
+    private:
+
+        // learned next node towards each sensor node, by node ID
+        uint8_t via[MAP_NODE_MAX + 1] = {0};
+
+
+    public:
+
+        /**
+         * @brief Learns the node a report for a target arrived from
+         * 
+         * @param target_id: ID of the node the report was for or marked alive
+         * @param via_id: ID of the node that sent the report
+         */
+        void learn(uint8_t target_id, uint8_t via_id);
+
+        /**
+         * @brief Forgets the learned next node towards a target
+         * 
+         * @param target_id: ID of the node
+         */
+        void forget(uint8_t target_id);
+
+        /**
+         * @brief Gets the next node for forwarding an egress message
+         * 
+         * @param node_id: ID of current node, or the base station
+         * @param target_id: ID of node the message is for
+         * @return Next node ID on success. Otherwise -1
+         */
+        int16_t get_next_node(uint8_t node_id, uint8_t target_id);
+
+        /**
+         * @brief Takes the targets that share a next node
+         * 
+         * The group is every target with the same next node as the lowest
+         * remaining target. Call until it returns 0 to split a set of
+         * targets between the next nodes.
+         * 
+         * @param node_id: ID of current node, or the base station
+         * @param targets: bitmap where bit N is set for target N. The taken targets are cleared
+         * @param next_id: set to the next node of the group, or -1 if there is no route
+         * @return Bitmap of the targets taken
+         */
+        uint16_t take_group(uint8_t node_id, uint16_t* targets, int16_t* next_id);
+};
+
+#endif // _EGRESS_TABLE_HPP_
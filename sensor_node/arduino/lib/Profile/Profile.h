@@ -0,0 +1,122 @@
+/**
+* @brief: Contains helpers for profiling hot path phases on the device
+* @file: Profile.h
+*
+* A phase accumulates micros() durations into a total, a min/max and a
+* logarithmic histogram. Each firmware declares its own phases and counters
+* and decides how they are reported.
+*
+* @author: jkieltyka15
+*/
+
+#ifndef _PROFILE_H_
+#define _PROFILE_H_
+
+#include <Arduino.h>
+
+// number of histogram bins for each phase
+#define PROFILE_HIST_BINS 12
+
+// durations below 2^PROFILE_HIST_SHIFT microseconds fall into the first bin.
+// Each following bin doubles the upper bound and the last bin is unbounded
+#define PROFILE_HIST_SHIFT 5
+
+
+// accumulated timing of a single phase
+struct profile_phase_t {
+    uint32_t total_us;                  // sum of all durations
+    uint32_t count;                     // number of durations recorded
+    uint32_t min_us;                    // shortest duration
+    uint32_t max_us;                    // longest duration
+    uint16_t hist[PROFILE_HIST_BINS];   // number of durations per bin
+};
+
+
+/**
+ * @brief Clears all timing of a phase
+ *
+ * @param phase: phase to clear
+ */
+inline void profile_phase_reset(profile_phase_t* phase) {
+
+    memset(phase, 0, sizeof(*phase));
+    phase->min_us = 0xFFFFFFFF;
+}
+
+
+/**
+ * @brief Records a single duration for a phase
+ *
+ * @param phase: phase the duration belongs to
+ * @param elapsed_us: duration in microseconds
+ */
+inline void profile_phase_record(profile_phase_t* phase, uint32_t elapsed_us) {
+
+    phase->total_us += elapsed_us;
+    phase->count++;
+
+    if (elapsed_us < phase->min_us) {
+        phase->min_us = elapsed_us;
+    }
+
+    if (elapsed_us > phase->max_us) {
+        phase->max_us = elapsed_us;
+    }
+
+    // find bin from the number of significant bits of the duration
+    uint8_t bin = 0;
+    for (uint32_t bound = elapsed_us >> PROFILE_HIST_SHIFT; 0 != bound; bound >>= 1) {
+        bin++;
+    }
+
+    if (PROFILE_HIST_BINS <= bin) {
+        bin = PROFILE_HIST_BINS - 1;
+    }
+
+    // saturate instead of wrapping
+    if (0xFFFF != phase->hist[bin]) {
+        phase->hist[bin]++;
+    }
+}
+
+
+/**
+ * @brief Prints the timing of a phase as a single line
+ *
+ * @param name: name of the phase stored in flash
+ * @param phase: phase to print
+ */
+inline void profile_phase_print(const __FlashStringHelper* name, profile_phase_t* phase) {
+
+    Serial.print(name);
+    Serial.print(F(": n="));
+    Serial.print(phase->count);
+    Serial.print(F(" avg="));
+    Serial.print((0 == phase->count) ? 0 : phase->total_us / phase->count);
+    Serial.print(F(" min="));
+    Serial.print((0 == phase->count) ? 0 : phase->min_us);
+    Serial.print(F(" max="));
+    Serial.print(phase->max_us);
+    Serial.print(F(" hist="));
+
+    for (uint8_t i = 0; i < PROFILE_HIST_BINS; i++) {
+        Serial.print(phase->hist[i]);
+        Serial.print((PROFILE_HIST_BINS - 1 == i) ? '\n' : ',');
+    }
+}
+
+
+/**
+ * @brief Prints a counter as a single line
+ *
+ * @param name: name of the counter stored in flash
+ * @param value: value of the counter
+ */
+inline void profile_counter_print(const __FlashStringHelper* name, uint32_t value) {
+
+    Serial.print(name);
+    Serial.print(F(": "));
+    Serial.println(value);
+}
+
+#endif // _PROFILE_H_
@@ -0,0 +1,152 @@
+/**
+* @brief: Contains the implementation of the IngressQueue class.
+* @file: ingressqueue.cpp
+*
+* @author: jkieltyka15
+*/
+
+// standard libraries
+#include <Arduino.h>
+#include <string.h>
+
+// local libraries
+#include <Message.h>
+
+// local dependencies
+#include "ingressqueue.hpp"
+
+
+UpdateMessage* IngressQueue::get_report(uint8_t index) {
+
+    return (UpdateMessage*)this->entries[index].buffer;
+}
+
+
+uint8_t IngressQueue::find_next() {
+
+    // oldest report of the most urgent priority
+    uint8_t index = 0;
+    for (uint8_t i = 1; i < this->num_entries; i++) {
+        if (this->get_report(i)->get_priority() < this->get_report(index)->get_priority()) {
+            index = i;
+        }
+    }
+
+    return index;
+}
+
+
+void IngressQueue::remove(uint8_t index) {
+
+    for (uint8_t i = index + 1; i < this->num_entries; i++) {
+        this->entries[i - 1] = this->entries[i];
+    }
+
+    this->num_entries--;
+}
+
+
+void IngressQueue::store(uint8_t index, UpdateMessage* msg, uint8_t size, uint32_t now_ms) {
+
+    size = (sizeof(this->entries[index].buffer) < size) ? sizeof(this->entries[index].buffer) : size;
+
+    memcpy(this->entries[index].buffer, msg, size);
+    this->entries[index].size = size;
+    this->entries[index].queued_ms = now_ms;
+}
+
+
+uint8_t IngressQueue::push(UpdateMessage* msg, uint8_t size, uint32_t now_ms) {
+
+    bool is_heartbeat = (PRIORITY_HEARTBEAT == msg->get_priority());
+
+    // one entry per origin
+    for (uint8_t i = 0; i < this->num_entries; i++) {
+
+        UpdateMessage* waiting = this->get_report(i);
+        if (msg->get_node_id() != waiting->get_node_id()) {
+            continue;
+        }
+
+        // the waiting status change already carries the current status
+        if ((true == is_heartbeat) && (PRIORITY_STATE_CHANGE == waiting->get_priority())) {
+            return INGRESS_COALESCED;
+        }
+
+        // newer report replaces the older one but keeps its place. Its age
+        // already covers the time the older one waited
+        this->store(i, msg, size, now_ms);
+
+        return INGRESS_COALESCED;
+    }
+
+    // heartbeats give way once reports are backing up
+    if ((true == is_heartbeat) && (INGRESS_QUEUE_DROP_DEPTH <= this->num_entries)) {
+        return INGRESS_DROPPED;
+    }
+
+    // a status change pushes out the newest heartbeat of a full queue
+    if ((INGRESS_QUEUE_SIZE <= this->num_entries) && (false == is_heartbeat)) {
+
+        for (int8_t i = this->num_entries - 1; i >= 0; i--) {
+            if (PRIORITY_HEARTBEAT == this->get_report(i)->get_priority()) {
+                this->remove(i);
+                break;
+            }
+        }
+    }
+
+    if (INGRESS_QUEUE_SIZE <= this->num_entries) {
+        return INGRESS_DROPPED;
+    }
+
+    this->store(this->num_entries++, msg, size, now_ms);
+
+    return INGRESS_QUEUED;
+}
+
+
+uint8_t IngressQueue::pop(uint8_t* buffer, uint32_t* queued_ms) {
+
+    if (0 == this->num_entries) {
+        return 0;
+    }
+
+    uint8_t index = this->find_next();
+
+    uint8_t size = this->entries[index].size;
+    memcpy(buffer, this->entries[index].buffer, size);
+    *queued_ms = this->entries[index].queued_ms;
+
+    this->remove(index);
+
+    return size;
+}
+
+
+UpdateMessage* IngressQueue::peek() {
+
+    if (0 == this->num_entries) {
+        return NULL;
+    }
+
+    return this->get_report(this->find_next());
+}
+
+
+uint8_t IngressQueue::get_depth() {
+
+    return this->num_entries;
+}
+
+
+bool IngressQueue::is_full() {
+
+    return INGRESS_QUEUE_SIZE <= this->num_entries;
+}
+
+
+void IngressQueue::clear() {
+
+    this->num_entries = 0;
+}
@@ -0,0 +1,97 @@
+/**
+* @brief: Contains the implementation of the LinkPower class.
+* @file: linkpower.cpp
+*
+* @author: jkieltyka15
+*/
+
+// standard libraries
+#include <Arduino.h>
+#include <RF24.h>
+
+// local dependencies
+#include "linkpower.hpp"
+
+
+int8_t LinkPower::find(uint8_t rx_id) {
+
+    for (uint8_t i = 0; i < this->num_links; i++) {
+        if (rx_id == this->links[i].id) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+
+uint8_t LinkPower::get_level(uint8_t rx_id) {
+
+    int8_t index = this->find(rx_id);
+
+    // receiver not written to yet
+    if (0 > index) {
+        return RF24_PA_MAX;
+    }
+
+    return this->links[index].level;
+}
+
+
+void LinkPower::record_tx(uint8_t rx_id, bool is_sent, uint8_t arc, uint32_t now_ms) {
+
+    int8_t index = this->find(rx_id);
+
+    // new receiver takes a free entry or the one written to least recently
+    if (0 > index) {
+
+        if (LINK_POWER_LINKS_MAX > this->num_links) {
+            index = this->num_links++;
+        }
+
+        else {
+            index = 0;
+            for (uint8_t i = 1; i < this->num_links; i++) {
+                if ((now_ms - this->links[i].used_ms) > (now_ms - this->links[index].used_ms)) {
+                    index = i;
+                }
+            }
+        }
+
+        this->links[index] = {rx_id, RF24_PA_MAX, RF24_PA_MIN, 0, 0, now_ms};
+    }
+
+    link_power_t* link = &this->links[index];
+    link->used_ms = now_ms;
+
+    // levels found too weak are tried again once the lot may have changed
+    if ((RF24_PA_MIN != link->floor) && (LINK_POWER_HOLD_MS <= now_ms - link->floor_ms)) {
+        link->floor = RF24_PA_MIN;
+    }
+
+    // receiver barely heard the write so the level is held off
+    if ((false == is_sent) || (LINK_POWER_ARC_WEAK <= arc)) {
+
+        if (RF24_PA_MAX > link->level) {
+            link->level++;
+            link->floor = link->level;
+            link->floor_ms = now_ms;
+        }
+
+        link->good_writes = 0;
+        return;
+    }
+
+    // neither weak nor clean enough to step down
+    if (LINK_POWER_ARC_GOOD < arc) {
+        link->good_writes = 0;
+        return;
+    }
+
+    link->good_writes++;
+
+    if ((LINK_POWER_STEP_WRITES <= link->good_writes) && (link->floor < link->level)) {
+        link->level--;
+        link->good_writes = 0;
+    }
+}
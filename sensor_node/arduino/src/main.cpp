@@ -10,176 +10,196 @@
 #include <stdlib.h>
 #include <Wire.h>
 #include <Adafruit_VL6180X.h>
+#include <nRF24L01.h>
+#include <RF24.h>
 
 // local libraries
 #include <Log.h>
 
 // local dependencies
 #include "sensornode.hpp"
-#include "parkingmap.hpp"
+#include "mainloop.hpp"
+#include "profiling.hpp"
 
 
-// unique ID for node
+// ID of a node whose config block has not been saved yet
 #define NODE_ID 10
 
 // baud rate for serial connection
 #define SERIAL_BAUD 9600
 
 
-#define MAIN_LOOP_DELAY_MIN_MS 75   // minimum delay in main loop in milliseconds
-#define MAIN_LOOP_DELAY_MAX_MS 150  // maximum delay in main loop in milliseconds
+#define SERIAL_CMD_PROFILE_DUMP  'p'    // print profiling phases and counters
+#define SERIAL_CMD_PROFILE_RESET 'r'    // clear profiling phases and counters
+#define SERIAL_CMD_SET_ID        'i'    // i<id> saves the node ID, used from the next boot
 
-// number of loop iterations without transmitting a message
-// before sending out a heartbeat
-#define LOOPS_BEFORE_HEARTBEAT 25
-
-// size of message buffer
-#define MSG_BUFFER_SIZE 32
+#define SERIAL_LINE_MAX 8               // longest command line after the command byte, including the terminator
+#define SERIAL_LINE_TIMEOUT_MS 1000UL   // time the rest of a command line has to arrive in
 
 
 // parking sensor node
-SensorNode node = SensorNode(NODE_ID);
+SensorNode<RF24, Adafruit_VL6180X> node = SensorNode<RF24, Adafruit_VL6180X>(NODE_ID);
 
 // counter for tracking loop iterations since the last
 // message was transmitted
 uint8_t loops_since_last_transmission = 0;
 
+
 /**
- * @brief Initialize all necessary objects and variables.
+ * @brief Reads the rest of a command line from the serial port
+ *
+ * The characters after the command byte may still be on their way, so
+ * they are waited for until the line ends or the timeout passes.
+ *
+ * @param line: buffer to store the line in without its line ending
+ * @param len: size of the buffer in bytes
+ * @return True if the whole line ended in time and fit. Otherwise false
  */
-void setup() {
+static bool read_serial_line(char* line, uint8_t len) {
 
-    Serial.begin(SERIAL_BAUD);
-  
-    // initialize the sensor node
-    if (false == node.init()) {
+    uint8_t size = 0;
+    bool is_overflow = false;
+    uint32_t start_ms = millis();
 
-        ERROR("Failed to initialize sensor node. Check hardware")
+    while (SERIAL_LINE_TIMEOUT_MS > millis() - start_ms) {
 
-        // hang since failure is not recoverable
-        while(1);
+        int c = Serial.read();
+
+        // nothing arrived yet or the carriage return of a CRLF ending
+        if ((0 > c) || ('\r' == c)) {
+            continue;
+        }
+
+        if ('\n' == c) {
+            line[size] = '\0';
+            return (false == is_overflow);
+        }
+
+        // line too long, the rest is read and discarded
+        if (len - 1 <= size) {
+            is_overflow = true;
+            continue;
+        }
+
+        line[size++] = (char)c;
     }
 
-    INFO("setup complete")
+    return false;
 }
 
 
 /**
- * @brief Main program run loop.
- * 
- * Continuously monitors the status of a parking space and sends a message if
- * it changes or the status is requested. Additionally, relays messages from
- * other nodes.
+ * @brief Saves the node ID in the rest of the command line in the config block
+ *
+ * The radio address and channel follow the ID, so it is used from the
+ * next boot.
  */
-void loop() {
+static void set_node_id() {
 
-    // track iterations since last transmission
-    loops_since_last_transmission++;
+    char line[SERIAL_LINE_MAX];
+    uint32_t node_id = 0;
 
-    // determine if parking space status has changed or time for heartbeat
-    if ((true == node.is_sensor_status_changed())
-        || LOOPS_BEFORE_HEARTBEAT <= loops_since_last_transmission) {
+    // only a whole line is acted on, so a slow one cannot save a cut off ID
+    if (false == read_serial_line(line, sizeof(line))) {
+        ERROR("Expected i<id>");
+        return;
+    }
 
-        // determine recepient
-        int16_t rx_id = get_next_ingress_node(node.get_id());
+    const char* digit = line;
+    while (('0' <= *digit) && ('9' >= *digit) && (0xFFFF >= node_id)) {
+        node_id = (node_id * 10) + (*digit - '0');
+        digit++;
+    }
 
-        // no recepient available
-        if (0 > rx_id) {
-            WARN("Nobody to send update to")
-        }
+    // base station ID, too large for the parking map or not a number
+    if (('\0' != *digit) || (0 == node_id) || (MAP_NODE_MAX < node_id)) {
+        ERROR("Invalid node ID %s", line);
+        return;
+    }
 
-        else {
-            // transmit update
-            if (false == node.transmit_update((uint8_t)rx_id)) {
-                ERROR("Failed to transmit update message to Node " + rx_id)
-            }
+    node_config_t config;
+    config.node_id = (uint8_t)node_id;
+    config.timing = *node.get_timing();
+    save_node_config(&config);
 
-            // heartbeat message successfully sent
-            else if (LOOPS_BEFORE_HEARTBEAT <= loops_since_last_transmission) {
-                INFO("heartbeat update message sent to Node " + + rx_id)
-            }
+    INFO("Node ID %u is used from the next boot", (uint8_t)node_id);
+}
 
-            // update message successfully sent
-            else {
-                INFO("update message sent to Node " + + rx_id)
-            }
 
-            // reset heartbeat iteration counter
-            loops_since_last_transmission = 0;
-        }
+/**
+ * @brief Handles a single character command from the serial port
+ */
+static void handle_serial_command() {
+
+    // no command received
+    if (0 == Serial.available()) {
+        return;
     }
 
-    // check if a message has been received
-    else if(true == node.is_message()) {
+    char cmd = Serial.read();
+    switch (cmd) {
 
-        uint8_t buffer[MSG_BUFFER_SIZE];
-        memset(buffer, 0, sizeof(buffer));
+        case SERIAL_CMD_SET_ID:
+            set_node_id();
+            break;
 
-        if (false == node.read_message((uint8_t**)(&buffer), (uint8_t)sizeof(buffer))) {
-            ERROR("Failed to read message");
-        }
+#ifdef PROFILE_ENABLED
+        case SERIAL_CMD_PROFILE_DUMP:
+            profile_dump();
+            break;
 
-        else {
-            // convert buffer to Message
-            Message msg = Message();
-            memcpy(&msg, buffer, sizeof(msg));
-
-            // verify message is for node
-            if (node.get_id() != msg.get_rx_id()) {
-                WARN("Message intended for Node " + msg.get_rx_id() + " not Node " + node.get_id());
-            }
-
-            // react accordingly based on message type
-            else {
-
-                uint8_t type = msg.get_type();
-                switch(type) {
-
-                    case MESSAGE_UPDATE: {
-
-                        INFO("Received UPDATE message from Node " + msg.get_tx_id())
-                        
-                        // convert buffer to UpdateMessage
-                        UpdateMessage update_msg = UpdateMessage();
-                        memcpy(&update_msg, buffer, sizeof(update_msg));
-
-                        // determine recepient
-                        int16_t rx_id = get_next_ingress_node(node.get_id());
-
-                        // no recepient available
-                        if (0 > rx_id) {
-                            WARN("Nobody to send update to")
-                        }
-
-                        else {
-                            // create new message to forward
-                            uint8_t tx_id = node.get_id();
-                            uint8_t node_id = update_msg.get_node_id();
-                            bool is_vacant = update_msg.get_is_vacant();
-                            UpdateMessage new_msg = UpdateMessage(rx_id, tx_id, node_id, is_vacant);
-
-                            // forward the message
-                            if (false == node.transmit_update(&new_msg)) {
-                                ERROR("Failed to transmit update message to " + rx_id)
-                            }
-
-                            // reset heartbeat iteration counter
-                            loops_since_last_transmission = 0;
-                        }
-
-                        break;
-                    }
-
-                    default:
-                        WARN("Unknown message type received")
-                        break;
-                }
-            }
-        }
+        case SERIAL_CMD_PROFILE_RESET:
+            profile_reset();
+            break;
+#endif // PROFILE_ENABLED
+
+        default:
+            break;
+    }
+}
+
+
+/**
+ * @brief Initialize all necessary objects and variables.
+ */
+void setup() {
+
+    Serial.begin(SERIAL_BAUD);
+
+    // one firmware serves every node once its ID is saved
+    node_config_t config;
+    if (true == load_node_config(&config)) {
+        node.set_id(config.node_id);
+        node.set_timing(&config.timing);
     }
 
-    // nothing to do
     else {
-        delay(random(MAIN_LOOP_DELAY_MIN_MS, MAIN_LOOP_DELAY_MAX_MS));
+        WARN("No saved config. Using Node ID %u", NODE_ID);
+    }
+  
+    // initialize the sensor node
+    if (false == node.init()) {
+
+        ERROR("Failed to initialize sensor node. Check hardware");
+
+        // hang since failure is not recoverable
+        while(1);
     }
+
+    INFO("setup complete");
+}
+
+
+/**
+ * @brief Main program run loop.
+ * 
+ * Continuously monitors the status of a parking space and sends a message if
+ * it changes or the status is requested. Additionally, relays messages from
+ * other nodes.
+ */
+void loop() {
+
+    handle_serial_command();
+
+    sensor_node_loop(&node, &loops_since_last_transmission);
 }
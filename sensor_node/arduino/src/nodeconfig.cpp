@@ -0,0 +1,143 @@
+/**
+* @brief: Contains the implementation of the sensor node config block.
+* @file: nodeconfig.cpp
+*
+* @author: jkieltyka15
+*/
+
+// standard libraries
+#include <Arduino.h>
+#include <EEPROM.h>
+
+// local libraries
+#include <Message.h>
+
+// local dependencies
+#include "nodeconfig.hpp"
+
+
+/**
+ * @brief Calculates the CRC-8 of a buffer
+ *
+ * @param data: bytes to calculate the CRC over
+ * @param len: number of bytes
+ * @return CRC of the buffer
+ */
+static uint8_t crc8(const uint8_t* data, uint8_t len) {
+
+    uint8_t crc = 0;
+
+    for (uint8_t i = 0; i < len; i++) {
+
+        crc ^= data[i];
+
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (0 != (crc & 0x80)) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+
+bool load_node_config(node_config_t* config) {
+
+    uint8_t* bytes = (uint8_t*)config;
+
+    for (uint8_t i = 0; i < sizeof(node_config_t); i++) {
+        bytes[i] = EEPROM.read(NODE_CONFIG_ADDR + i);
+    }
+
+    // never written or written by a firmware with another layout
+    if ((NODE_CONFIG_MAGIC != config->magic) || (config->checksum != crc8(bytes, sizeof(node_config_t) - 1))) {
+        return false;
+    }
+
+    return (0 != config->node_id) && (true == is_timing_valid(&config->timing));
+}
+
+
+void save_node_config(node_config_t* config) {
+
+    config->magic = NODE_CONFIG_MAGIC;
+    config->checksum = crc8((const uint8_t*)config, sizeof(node_config_t) - 1);
+
+    const uint8_t* bytes = (const uint8_t*)config;
+
+    for (uint8_t i = 0; i < sizeof(node_config_t); i++) {
+        EEPROM.update(NODE_CONFIG_ADDR + i, bytes[i]);
+    }
+}
+
+
+bool set_timing_setting(node_timing_t* timing, uint8_t setting, uint16_t value) {
+
+    // most settings are held in a byte
+    bool is_byte = (0xFF >= value);
+
+    switch (setting) {
+
+        case CONFIG_MAX_SEND_ATTEMPTS:
+            if (false == is_byte) {
+                return false;
+            }
+
+            timing->max_send_attempts = (uint8_t)value;
+            break;
+
+        case CONFIG_FAILED_SEND_DELAY:
+            if (false == is_byte) {
+                return false;
+            }
+
+            timing->failed_send_delay = (uint8_t)value;
+            break;
+
+        case CONFIG_CHANNEL_CHECKS_MAX:
+            if (false == is_byte) {
+                return false;
+            }
+
+            timing->channel_checks_max = (uint8_t)value;
+            break;
+
+        case CONFIG_CHANNEL_BUSY_DELAY_MIN_MS:
+            timing->channel_busy_delay_min_ms = value;
+            break;
+
+        case CONFIG_CHANNEL_BUSY_DELAY_MAX_MS:
+            timing->channel_busy_delay_max_ms = value;
+            break;
+
+        case CONFIG_MAIN_LOOP_DELAY_MIN_MS:
+            timing->main_loop_delay_min_ms = value;
+            break;
+
+        case CONFIG_MAIN_LOOP_DELAY_MAX_MS:
+            timing->main_loop_delay_max_ms = value;
+            break;
+
+        case CONFIG_LOOPS_BEFORE_HEARTBEAT:
+            if (false == is_byte) {
+                return false;
+            }
+
+            timing->loops_before_heartbeat = (uint8_t)value;
+            break;
+
+        default:
+            return false;
+    }
+
+    return true;
+}
+
+
+bool is_timing_valid(const node_timing_t* timing) {
+
+    return (RADIO_RETRIES_MAX >= timing->max_send_attempts) &&
+        (RADIO_RETRIES_MAX >= timing->failed_send_delay) &&
+        (timing->channel_busy_delay_min_ms <= timing->channel_busy_delay_max_ms) &&
+        (timing->main_loop_delay_min_ms <= timing->main_loop_delay_max_ms) &&
+        (0 < timing->loops_before_heartbeat);
+}
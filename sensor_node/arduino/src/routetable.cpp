@@ -0,0 +1,172 @@
+/**
+* @brief: Contains the implementation of the RouteTable class.
+* @file: routetable.cpp
+*
+* @author: jkieltyka15
+*/
+
+// standard libraries
+#include <Arduino.h>
+
+// local libraries
+#include <Message.h>
+
+// local dependencies
+#include "routetable.hpp"
+
+
+int8_t RouteTable::find_best(uint32_t now_ms, int16_t exclude_id) {
+
+    int8_t best = -1;
+    uint16_t best_cost = 0xFFFF;
+
+    for (uint8_t i = 0; i < this->num_parents; i++) {
+
+        // parent has not been heard from in too long or is excluded
+        if ((ROUTE_STALE_MS <= now_ms - this->parents[i].heard_ms) || (exclude_id == this->parents[i].id)) {
+            continue;
+        }
+
+        uint16_t cost = this->get_total_cost(&this->parents[i]);
+        if ((-1 == best) || (cost < best_cost)) {
+            best = i;
+            best_cost = cost;
+        }
+    }
+
+    return best;
+}
+
+
+int8_t RouteTable::find_replaceable(uint16_t cost, uint32_t now_ms) {
+
+    int8_t worst = -1;
+
+    for (uint8_t i = 0; i < this->num_parents; i++) {
+
+        // stale parents are replaced first
+        if (ROUTE_STALE_MS <= now_ms - this->parents[i].heard_ms) {
+            return i;
+        }
+
+        if ((-1 == worst) || (this->get_total_cost(&this->parents[i]) > this->get_total_cost(&this->parents[worst]))) {
+            worst = i;
+        }
+    }
+
+    // a new parent starts with a clean link
+    uint32_t new_cost = (uint32_t)cost + ROUTE_COST_SCALE;
+    if ((0 > worst) || (new_cost >= this->get_total_cost(&this->parents[worst]))) {
+        return -1;
+    }
+
+    return worst;
+}
+
+
+uint16_t RouteTable::get_total_cost(const route_parent_t* parent) {
+
+    uint32_t cost = (uint32_t)parent->cost + parent->link_cost;
+
+    return (0xFFFF < cost) ? 0xFFFF : (uint16_t)cost;
+}
+
+
+bool RouteTable::handle_beacon(uint8_t node_id, BeaconMessage* msg, uint32_t now_ms) {
+
+    // sender forwards through this node or is too far out
+    if ((node_id == msg->get_parent()) || (ROUTE_HOPS_MAX <= msg->get_hops())) {
+        return false;
+    }
+
+    // find the sender, an unused entry or the entry it should replace
+    int8_t index = -1;
+    bool is_known = false;
+
+    for (uint8_t i = 0; i < this->num_parents; i++) {
+        if (msg->get_tx_id() == this->parents[i].id) {
+            index = i;
+            is_known = true;
+            break;
+        }
+    }
+
+    if ((false == is_known) && (ROUTE_PARENTS_MAX > this->num_parents)) {
+        index = this->num_parents++;
+    }
+
+    else if (false == is_known) {
+        index = this->find_replaceable(msg->get_cost(), now_ms);
+    }
+
+    // links are assumed to be clean until reports are written over them
+    if ((false == is_known) && (0 <= index)) {
+        this->parents[index].id = msg->get_tx_id();
+        this->parents[index].link_cost = ROUTE_COST_SCALE;
+    }
+
+    if (0 <= index) {
+        this->parents[index].hops = msg->get_hops();
+        this->parents[index].cost = msg->get_cost();
+        this->parents[index].heard_ms = now_ms;
+    }
+
+    // first round or a round started after the most recent one
+    if ((false == this->is_seq_set) || (0 < (int8_t)(msg->get_seq() - this->seq))) {
+        this->seq = msg->get_seq();
+        this->is_seq_set = true;
+        return true;
+    }
+
+    return false;
+}
+
+
+void RouteTable::record_tx(uint8_t rx_id, bool is_sent, uint8_t arc) {
+
+    for (uint8_t i = 0; i < this->num_parents; i++) {
+
+        if (rx_id != this->parents[i].id) {
+            continue;
+        }
+
+        // moving average over roughly the last four reports
+        uint16_t attempts = (true == is_sent) ? arc + 1 : ROUTE_FAIL_ATTEMPTS;
+        uint16_t link_cost = this->parents[i].link_cost;
+        this->parents[i].link_cost = link_cost - (link_cost / 4) + ((attempts * ROUTE_COST_SCALE) / 4);
+
+        return;
+    }
+}
+
+
+int16_t RouteTable::get_parent(uint32_t now_ms) {
+
+    int8_t best = this->find_best(now_ms, -1);
+
+    return (0 > best) ? -1 : this->parents[best].id;
+}
+
+
+int16_t RouteTable::get_alternate(uint32_t now_ms, uint8_t parent_id) {
+
+    int8_t best = this->find_best(now_ms, parent_id);
+
+    return (0 > best) ? -1 : this->parents[best].id;
+}
+
+
+uint8_t RouteTable::get_hops(uint32_t now_ms) {
+
+    int8_t best = this->find_best(now_ms, -1);
+
+    return (0 > best) ? 0 : this->parents[best].hops + 1;
+}
+
+
+uint16_t RouteTable::get_cost(uint32_t now_ms) {
+
+    int8_t best = this->find_best(now_ms, -1);
+
+    return (0 > best) ? 0xFFFF : this->get_total_cost(&this->parents[best]);
+}
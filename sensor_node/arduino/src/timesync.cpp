@@ -0,0 +1,151 @@
+/**
+* @brief: Contains the implementation of the TimeSync class.
+* @file: timesync.cpp
+*
+* @author: jkieltyka15
+*/
+
+// standard libraries
+#include <Arduino.h>
+
+// local dependencies
+#include "timesync.hpp"
+
+
+void TimeSync::fit() {
+
+    const sync_point_t* oldest = &this->points[(this->num_points < SYNC_TABLE_SIZE) ? 0 : this->next_point];
+
+    // averages relative to the oldest point keep the sums small
+    int32_t local_sum = 0;
+    int32_t offset_sum = 0;
+    uint16_t error_max_ms = 0;
+
+    for (uint8_t i = 0; i < this->num_points; i++) {
+
+        local_sum += (int32_t)(this->points[i].local_ms - oldest->local_ms);
+        offset_sum += this->points[i].offset_ms - oldest->offset_ms;
+
+        if (this->points[i].error_ms > error_max_ms) {
+            error_max_ms = this->points[i].error_ms;
+        }
+    }
+
+    int32_t local_avg = local_sum / this->num_points;
+    int32_t offset_avg = offset_sum / this->num_points;
+
+    // least squares slope of offset against local time
+    float covariance = 0.0f;
+    float variance = 0.0f;
+    float deviation = 0.0f;
+
+    for (uint8_t i = 0; i < this->num_points; i++) {
+
+        float dx = (float)((int32_t)(this->points[i].local_ms - oldest->local_ms) - local_avg);
+        float dy = (float)((this->points[i].offset_ms - oldest->offset_ms) - offset_avg);
+
+        covariance += dx * dy;
+        variance += dx * dx;
+        deviation += (0.0f > dx) ? -dx : dx;
+    }
+
+    this->local_avg_ms = oldest->local_ms + local_avg;
+    this->offset_avg_ms = oldest->offset_ms + offset_avg;
+    this->error_max_ms = error_max_ms;
+
+    // the clock cannot be off by more than its tolerance
+    const float clock_skew = SYNC_CLOCK_PPM / 1e6f;
+    this->skew = (0.0f < variance) ? covariance / variance : 0.0f;
+    this->skew = (clock_skew < this->skew) ? clock_skew : ((-clock_skew > this->skew) ? -clock_skew : this->skew);
+
+    // errors of the points tilt the slope by at most this much, and
+    // neither the fit nor the clock can be further apart than twice the tolerance
+    this->skew_error = (0.0f < variance) ? (error_max_ms * deviation) / variance + SYNC_DRIFT_PPM / 1e6f : clock_skew;
+    if ((2.0f * clock_skew) < this->skew_error) {
+        this->skew_error = 2.0f * clock_skew;
+    }
+}
+
+
+void TimeSync::reset() {
+
+    this->num_points = 0;
+    this->next_point = 0;
+    this->error_max_ms = 0;
+    this->skew = 0.0f;
+    this->skew_error = 0.0f;
+}
+
+
+bool TimeSync::is_new_round(uint8_t seq, uint8_t hops) {
+
+    // first round or a round started after the most recent one
+    if ((0 == this->num_points) || (0 < (int8_t)(seq - this->seq))) {
+        this->seq = seq;
+        this->hops = hops;
+        return true;
+    }
+
+    return false;
+}
+
+
+void TimeSync::add_point(uint32_t local_ms, uint32_t network_ms, uint16_t error_ms) {
+
+    int32_t offset_ms = (int32_t)(network_ms - local_ms);
+
+    // network time jumped, such as after the base station restarted
+    if (true == this->is_synced()) {
+
+        int32_t jump_ms = offset_ms - (int32_t)(this->get_network_ms(local_ms) - local_ms);
+        if ((SYNC_RESET_MS < jump_ms) || (-SYNC_RESET_MS > jump_ms)) {
+            this->num_points = 0;
+            this->next_point = 0;
+        }
+    }
+
+    this->points[this->next_point].local_ms = local_ms;
+    this->points[this->next_point].offset_ms = offset_ms;
+    this->points[this->next_point].error_ms = error_ms;
+
+    this->next_point = (this->next_point + 1) % SYNC_TABLE_SIZE;
+    if (SYNC_TABLE_SIZE > this->num_points) {
+        this->num_points++;
+    }
+    this->fit();
+}
+
+
+bool TimeSync::is_synced() {
+
+    return 0 < this->num_points;
+}
+
+
+uint32_t TimeSync::get_network_ms(uint32_t local_ms) {
+
+    float correction = this->skew * (float)(int32_t)(local_ms - this->local_avg_ms);
+
+    return local_ms + this->offset_avg_ms + (int32_t)correction;
+}
+
+
+uint16_t TimeSync::get_error_ms(uint32_t local_ms) {
+
+    if (false == this->is_synced()) {
+        return 0xFFFF;
+    }
+
+    // the line pivots around the average of the points
+    uint32_t elapsed_ms = local_ms - this->local_avg_ms;
+
+    float error_ms = this->error_max_ms + this->skew_error * (float)elapsed_ms + 1.0f;
+
+    return (65535.0f < error_ms) ? 0xFFFF : (uint16_t)error_ms;
+}
+
+
+uint8_t TimeSync::get_hops() {
+
+    return this->hops;
+}